@@ -0,0 +1,676 @@
+// bench/axl_bench.c
+// Core benchmarks with a checked-in baseline for perf regression tests.
+#include <axl/core/axml/parser.h>
+#include <axl/core/dag.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/dag/quantized.h>
+#include <axl/core/integration/semantic.h>
+#include <axl/core/trie.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_REPS       15
+#define BENCH_DEFAULT_TOLERANCE  0.10
+#define BENCH_SAMPLE_NS          5000000.0   // Target length of one sample
+#define BENCH_NOISE_MADS         3.0         // Slowdowns within this many MADs are noise
+#define BENCH_CALIBRATION_WORDS  4096        // L1-resident calibration buffer
+#define BENCH_DAG_NODES          1024
+#define BENCH_LARGE_DAG_NODES    (1u << 20)  // Frozen DAG well beyond typical L3 sizes
+#define BENCH_LARGE_DAG_WINDOW   4096        // Back-links reach this far
+#define BENCH_AXL_STATEMENTS     2048
+#define BENCH_AXML_CONCEPTS      64
+#define BENCH_AXML_BINDINGS      8           // Per concept
+
+typedef struct {
+    const char *name;
+    bool (*setup)(void **state);
+    void (*run)(void *state);                // One operation
+    void (*teardown)(void *state);
+} Benchmark;
+
+typedef struct {
+    double median_ns;                        // Per operation
+    double mad_ns;                           // Median absolute deviation
+    double ratio;                            // Median time over the calibration kernel's
+    double ratio_mad;
+} BenchResult;
+
+static volatile size_t bench_sink;
+static size_t bench_large_nodes = BENCH_LARGE_DAG_NODES;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ---------------------------------------------------------------------------
+ * Trie matching
+ * ------------------------------------------------------------------------- */
+
+static const char *trie_words[] = {
+    "let", "const", "x", "=", "42", "var", "spirit", "+", "\"Kwenu!\"", ";"
+};
+
+static bool trie_setup(void **state) {
+    TrieNode *root = trie_node_create("", TAXONOMY_NONE, 0.0f);
+    if (!root) return false;
+
+    trie_insert(root, "let|const|var", VERB_IDENTITY, 1.0f);
+    trie_insert(root, "[a-zA-Z_][a-zA-Z0-9_]*", NOUN_SUBJECT, 0.5f);
+    trie_insert(root, "[0-9]+", NOUN_OBJECT, 0.5f);
+    trie_insert(root, "\"[^\"]*\"", NOUN_OBJECT, 0.5f);
+    trie_insert(root, "=|\\+|-", VERB_ACTION, 0.8f);
+    trie_insert(root, ";", TAXONOMY_NONE, 0.1f);
+    *state = root;
+    return true;
+}
+
+static void trie_run(void *state) {
+    TrieNode *root = (TrieNode *)state;
+    size_t matched = 0;
+
+    for (size_t i = 0; i < sizeof(trie_words) / sizeof(trie_words[0]); i++) {
+        const char *word = trie_words[i];
+        TrieNode *node = trie_child(root, (unsigned char)word[0]);
+        if (node && trie_match_node(node, word, strlen(word))) matched++;
+    }
+    bench_sink += matched;
+}
+
+static void trie_teardown(void *state) {
+    trie_destroy((TrieNode *)state);
+}
+
+/* ---------------------------------------------------------------------------
+ * DAG build and resolve
+ * ------------------------------------------------------------------------- */
+
+static bool dag_setup(void **state) {
+    DAGNode **nodes = (DAGNode **)calloc(BENCH_DAG_NODES, sizeof(DAGNode *));
+    *state = nodes;
+    return nodes != NULL;
+}
+
+static void dag_run(void *state) {
+    DAGNode **nodes = (DAGNode **)state;
+
+    for (size_t i = 0; i < BENCH_DAG_NODES; i++) {
+        nodes[i] = dag_node_create(TOKEN_IDENT, NOUN_SUBJECT);
+    }
+
+    // A chain with skip links, as statements feeding later statements
+    for (size_t i = 1; i < BENCH_DAG_NODES; i++) {
+        dag_add_edge(nodes[i - 1], nodes[i], 1.0f);
+        if (i >= 7) dag_add_edge(nodes[i - 7], nodes[i], 0.5f);
+    }
+    dag_resolve(nodes, BENCH_DAG_NODES);
+
+    bench_sink += nodes[0]->state;
+    for (size_t i = 0; i < BENCH_DAG_NODES; i++) {
+        dag_node_destroy(nodes[i]);
+    }
+}
+
+static void dag_teardown(void *state) {
+    free(state);
+}
+
+/* ---------------------------------------------------------------------------
+ * Frozen DAG resolve: creation order vs. locality order
+ * ------------------------------------------------------------------------- */
+
+static uint64_t bench_random(uint64_t *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+/// Freeze a large DAG whose node ids are shuffled, as nodes allocated
+/// across many statements end up. Each node links to its predecessor
+/// and two random nodes shortly before it.
+static DAGCsr* bench_large_csr(void) {
+    size_t n = bench_large_nodes;
+    DAGNode **nodes = (DAGNode **)malloc(n * sizeof(DAGNode *));
+    if (!nodes) return NULL;
+
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    size_t created = 0;
+    for (; created < n; created++) {
+        nodes[created] = dag_node_create(TOKEN_IDENT, NOUN_SUBJECT);
+        if (!nodes[created]) break;
+
+        size_t i = created;
+        if (i == 0) continue;
+        dag_add_edge(nodes[i - 1], nodes[i], 1.0f);
+        for (int link = 0; link < 2 && i > 1; link++) {
+            size_t reach = i - 1 < BENCH_LARGE_DAG_WINDOW ? i - 1 : BENCH_LARGE_DAG_WINDOW;
+            size_t source = i - 1 - bench_random(&seed) % reach - 1;
+            float weight = bench_random(&seed) % 2 ? 0.75f : -1.5f;
+            dag_add_edge(nodes[source], nodes[i], weight);
+        }
+    }
+
+    DAGCsr *csr = NULL;
+    if (created == n) {
+        for (size_t i = n - 1; i > 0; i--) {
+            size_t j = bench_random(&seed) % (i + 1);
+            DAGNode *t = nodes[i];
+            nodes[i] = nodes[j];
+            nodes[j] = t;
+        }
+        csr = dag_freeze(nodes, n);
+    }
+
+    for (size_t i = 0; i < created; i++) {
+        dag_node_destroy(nodes[i]);
+    }
+    free(nodes);
+    return csr;
+}
+
+static bool csr_scattered_setup(void **state) {
+    DAGCsr *csr = bench_large_csr();
+    *state = csr;
+    return csr != NULL;
+}
+
+static bool csr_reordered_setup(void **state) {
+    DAGCsr *csr = bench_large_csr();
+    uint32_t *order = csr ? dag_csr_locality_order(csr, DAG_ORDER_TOPOLOGICAL) : NULL;
+    DAGCsr *reordered = order ? dag_csr_reorder(csr, order) : NULL;
+
+    free(order);
+    dag_csr_destroy(csr);
+    *state = reordered;
+    return reordered != NULL;
+}
+
+static void csr_run(void *state) {
+    DAGCsr *csr = (DAGCsr *)state;
+    dag_csr_resolve(csr);
+    bench_sink += csr->states[csr->node_count - 1];
+}
+
+static void csr_teardown(void *state) {
+    dag_csr_destroy((DAGCsr *)state);
+}
+
+/// The reordered DAG again, resolved by the quantized kernels (the
+/// best the CPU supports).
+static bool quantized_setup(void **state) {
+    DAGCsr *csr = NULL;
+    if (!csr_reordered_setup((void **)&csr)) return false;
+
+    DAGQuantized *quantized = dag_quantize(csr);
+    dag_csr_destroy(csr);
+    *state = quantized;
+    return quantized != NULL;
+}
+
+static void quantized_run(void *state) {
+    DAGQuantized *quantized = (DAGQuantized *)state;
+    dag_quantized_resolve(quantized);
+    bench_sink += quantized->states[quantized->node_count - 1];
+}
+
+static void quantized_teardown(void *state) {
+    dag_quantized_destroy((DAGQuantized *)state);
+}
+
+/* ---------------------------------------------------------------------------
+ * Calibration
+ * ------------------------------------------------------------------------- */
+
+/// Fixed integer work, timed alongside the benchmarks so the baseline
+/// can be compared as a ratio on faster or slower machines.
+static bool calibration_setup(void **state) {
+    uint64_t *words = (uint64_t *)malloc(BENCH_CALIBRATION_WORDS * sizeof(uint64_t));
+    if (!words) return false;
+
+    uint64_t seed = 0x2545f4914f6cdd1dull;
+    for (size_t i = 0; i < BENCH_CALIBRATION_WORDS; i++) {
+        words[i] = bench_random(&seed);
+    }
+    *state = words;
+    return true;
+}
+
+static void calibration_run(void *state) {
+    const uint64_t *words = (const uint64_t *)state;
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    // Data-dependent loads and multiplies, no allocation or I/O
+    size_t index = 0;
+    for (size_t i = 0; i < BENCH_CALIBRATION_WORDS; i++) {
+        hash = (hash ^ words[index]) * 0x100000001b3ull;
+        index = (size_t)(hash >> 52) % BENCH_CALIBRATION_WORDS;
+    }
+    bench_sink += (size_t)hash;
+}
+
+static const Benchmark calibration = {
+    "calibration", calibration_setup, calibration_run, free
+};
+
+/* ---------------------------------------------------------------------------
+ * Semantic DAG build
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    char  *data;
+    size_t size;
+    bool   hash_cons;
+} SemanticBench;
+
+/// AXL source of BENCH_AXL_STATEMENTS definitions, each combining two
+/// earlier identifiers with a small literal, as ordinary programs do.
+static char* bench_axl_source(size_t *size) {
+    size_t capacity = BENCH_AXL_STATEMENTS * 48 + 32;
+    char *data = (char *)malloc(capacity);
+    if (!data) return NULL;
+
+    uint64_t seed = 0x853c49e6748fea9bull;
+    size_t used = (size_t)snprintf(data, capacity, "let s0 = 1;\n");
+    for (size_t i = 1; i < BENCH_AXL_STATEMENTS; i++) {
+        size_t a = bench_random(&seed) % i;
+        size_t b = bench_random(&seed) % i;
+        used += (size_t)snprintf(data + used, capacity - used, "let s%zu = s%zu + (s%zu - %zu);\n",
+                                 i, a, b, i % 7);
+    }
+    *size = used;
+    return data;
+}
+
+static bool semantic_setup(void **state, bool hash_cons) {
+    SemanticBench *bench = (SemanticBench *)calloc(1, sizeof(SemanticBench));
+    if (!bench) return false;
+
+    bench->data = bench_axl_source(&bench->size);
+    if (!bench->data) {
+        free(bench);
+        return false;
+    }
+    bench->hash_cons = hash_cons;
+    *state = bench;
+    return true;
+}
+
+static bool semantic_plain_setup(void **state) {
+    return semantic_setup(state, false);
+}
+
+static bool semantic_consed_setup(void **state) {
+    return semantic_setup(state, true);
+}
+
+/// Parse, build and freeze, as every execution of an AXL source does.
+static void semantic_run(void *state) {
+    SemanticBench *bench = (SemanticBench *)state;
+    DAGConsTable *cons = bench->hash_cons ? dag_cons_create() : NULL;
+
+    AxlSemanticDag dag;
+    AxlSemanticError error;
+    if (axl_semantic_build(bench->data, bench->size, cons, &dag, &error)) {
+        AxlFrozenDag *frozen = axl_semantic_freeze(&dag);
+        bench_sink += frozen ? frozen->csr->node_count : 0;
+        axl_frozen_destroy(frozen);
+        axl_semantic_destroy(&dag);
+    }
+    dag_cons_destroy(cons);
+}
+
+static void semantic_teardown(void *state) {
+    SemanticBench *bench = (SemanticBench *)state;
+    if (bench) free(bench->data);
+    free(bench);
+}
+
+/* ---------------------------------------------------------------------------
+ * AXML parsing
+ * ------------------------------------------------------------------------- */
+
+/// Write a configuration of BENCH_AXML_CONCEPTS concepts, each with
+/// single- and multi-valued bindings, entities and CDATA, to `fd`.
+static bool bench_write_axml(int fd) {
+    FILE *file = fdopen(fd, "w");
+    if (!file) {
+        close(fd);
+        return false;
+    }
+
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    fprintf(file, "<axml source=\"bench.axl\" bust=\"conditional\" retain=\"true\" hash-cons=\"yes\">\n");
+    for (size_t c = 0; c < BENCH_AXML_CONCEPTS; c++) {
+        fprintf(file, "  <!-- concept %zu -->\n  <concept id=\"concept%zu\">\n", c, c);
+        for (size_t b = 0; b + 1 < BENCH_AXML_BINDINGS; b++) {
+            fprintf(file, "    <binding name=\"s%zu\" value=\"%s\" cardinality=\"1:N\"/>\n",
+                    c * BENCH_AXML_BINDINGS + b, b % 3 ? "yes" : "no");
+        }
+        fprintf(file, "    <binding name=\"group%zu\" cardinality=\"N:M\">\n", c);
+        fprintf(file, "      <value>mmanwu &amp; agbogho</value>\n");
+        fprintf(file, "      <value><![CDATA[<ancestors>]]></value>\n");
+        fprintf(file, "    </binding>\n  </concept>\n");
+        fprintf(file, "  <symbol id=\"mask%zu\" visual=\"&#x1F3AD;\"/>\n", c);
+    }
+    fprintf(file, "</axml>\n");
+    return fclose(file) == 0;
+}
+
+static bool axml_setup(void **state) {
+    char *path = strdup("/tmp/axl_bench_XXXXXX");
+    if (!path) return false;
+
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        free(path);
+        return false;
+    }
+    if (!bench_write_axml(fd)) {
+        unlink(path);
+        free(path);
+        return false;
+    }
+    *state = path;
+    return true;
+}
+
+static void axml_run(void *state) {
+    AxmlCompactConfig *config = axml_parse_compact((const char *)state);
+    bench_sink += config ? config->binding_count : 0;
+    axml_free_compact_config(config);
+}
+
+static void axml_teardown(void *state) {
+    unlink((const char *)state);
+    free(state);
+}
+
+static const Benchmark benchmarks[] = {
+    { "trie_match",            trie_setup,            trie_run,      trie_teardown },
+    { "dag_build_resolve",     dag_setup,             dag_run,       dag_teardown },
+    { "axml_parse",            axml_setup,            axml_run,      axml_teardown },
+    { "semantic_build",        semantic_plain_setup,  semantic_run,  semantic_teardown },
+    { "semantic_build_consed", semantic_consed_setup, semantic_run,  semantic_teardown },
+    { "csr_resolve_scattered", csr_scattered_setup,   csr_run,       csr_teardown },
+    { "csr_resolve_reordered", csr_reordered_setup,   csr_run,       csr_teardown },
+    { "quantized_resolve",     quantized_setup,       quantized_run, quantized_teardown },
+};
+
+#define BENCH_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/* ---------------------------------------------------------------------------
+ * Measurement
+ * ------------------------------------------------------------------------- */
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/// Median of `values`, which is sorted in place.
+static double median(double *values, size_t count) {
+    qsort(values, count, sizeof(double), compare_double);
+    return count % 2 ? values[count / 2]
+                     : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+/// Operations per sample so one lasts about BENCH_SAMPLE_NS; the
+/// doubling runs double as warm-up (lazy regex compilation, page faults).
+static size_t bench_sample_ops(const Benchmark *bench, void *state) {
+    size_t ops = 1;
+    for (;;) {
+        double begin = now_ns();
+        for (size_t i = 0; i < ops; i++) bench->run(state);
+        double elapsed = now_ns() - begin;
+        if (elapsed >= BENCH_SAMPLE_NS / 8) {
+            double scaled = (double)ops * BENCH_SAMPLE_NS / elapsed;
+            return scaled > 1.0 ? (size_t)scaled : 1;
+        }
+        ops *= 2;
+    }
+}
+
+/// Nanoseconds per operation over one sample of `ops` operations.
+static double bench_sample(const Benchmark *bench, void *state, size_t ops) {
+    double begin = now_ns();
+    for (size_t i = 0; i < ops; i++) bench->run(state);
+    return (now_ns() - begin) / (double)ops;
+}
+
+/// Median of `values` and their median absolute deviation; `values`
+/// is overwritten.
+static void median_mad(double *values, size_t count, double *mid, double *mad) {
+    *mid = median(values, count);
+    for (size_t i = 0; i < count; i++) {
+        double deviation = values[i] - *mid;
+        values[i] = deviation < 0 ? -deviation : deviation;
+    }
+    *mad = median(values, count);
+}
+
+/// Time `reps` samples of a benchmark, each paired with a sample of the
+/// calibration kernel taken just before it, so the ratio tracks the
+/// machine's speed at that moment.
+static bool bench_measure(const Benchmark *bench, size_t reps, void *calibration_state,
+                          size_t calibration_ops, BenchResult *result) {
+    void *state = NULL;
+    if (!bench->setup(&state)) {
+        fprintf(stderr, "Error: Could not set up benchmark %s\n", bench->name);
+        return false;
+    }
+    size_t ops = bench_sample_ops(bench, state);
+
+    double *samples = (double *)malloc(2 * reps * sizeof(double));
+    if (!samples) {
+        bench->teardown(state);
+        return false;
+    }
+    double *ratios = samples + reps;
+
+    for (size_t r = 0; r < reps; r++) {
+        double reference = bench_sample(&calibration, calibration_state, calibration_ops);
+        samples[r] = bench_sample(bench, state, ops);
+        ratios[r] = samples[r] / reference;
+    }
+    bench->teardown(state);
+
+    median_mad(samples, reps, &result->median_ns, &result->mad_ns);
+    median_mad(ratios, reps, &result->ratio, &result->ratio_mad);
+
+    free(samples);
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Baseline file
+ * ------------------------------------------------------------------------- */
+
+static char* read_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    char *text = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        rewind(file);
+        text = size >= 0 ? (char *)malloc((size_t)size + 1) : NULL;
+        if (text) text[fread(text, 1, (size_t)size, file)] = '\0';
+    }
+    fclose(file);
+    return text;
+}
+
+/// Find `"key": <number>` at or after `from`; false if absent.
+static bool json_number(const char *from, const char *key, double *value) {
+    char quoted[64];
+    snprintf(quoted, sizeof(quoted), "\"%s\"", key);
+
+    const char *p = strstr(from, quoted);
+    if (!p) return false;
+    p = strchr(p + strlen(quoted), ':');
+    if (!p) return false;
+
+    char *end;
+    *value = strtod(p + 1, &end);
+    return end != p + 1;
+}
+
+/// Baseline result for `name`; false if it is not recorded.
+static bool baseline_entry(const char *json, const char *name, BenchResult *result) {
+    char quoted[64];
+    snprintf(quoted, sizeof(quoted), "\"%s\"", name);
+
+    const char *entry = strstr(json, quoted);
+    return entry && json_number(entry, "median_ns", &result->median_ns) &&
+           json_number(entry, "mad_ns", &result->mad_ns) &&
+           json_number(entry, "ratio", &result->ratio) &&
+           json_number(entry, "ratio_mad", &result->ratio_mad) && result->ratio > 0;
+}
+
+static bool write_baseline(const char *path, double tolerance, const BenchResult *results) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Error: Could not write baseline %s\n", path);
+        return false;
+    }
+
+    // Benchmarks skipped by --filter are left out
+    const char *separator = "";
+    fprintf(file, "{\n  \"tolerance\": %.2f,\n  \"benchmarks\": {", tolerance);
+    for (size_t b = 0; b < BENCH_COUNT; b++) {
+        if (results[b].median_ns <= 0) continue;
+        fprintf(file, "%s\n    \"%s\": { \"median_ns\": %.1f, \"mad_ns\": %.1f, "
+                "\"ratio\": %.6g, \"ratio_mad\": %.6g }", separator, benchmarks[b].name,
+                results[b].median_ns, results[b].mad_ns, results[b].ratio, results[b].ratio_mad);
+        separator = ",";
+    }
+    fprintf(file, "\n  }\n}\n");
+    return fclose(file) == 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Driver
+ * ------------------------------------------------------------------------- */
+
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("Options:\n");
+    printf("  --baseline <path>   Fail on regressions against this baseline JSON\n");
+    printf("  --write <path>      Record the results as a new baseline (never fails on regressions)\n");
+    printf("  --tolerance <frac>  Allowed slowdown after calibration, e.g. 0.25 (default: baseline's, else %.2f)\n",
+           BENCH_DEFAULT_TOLERANCE);
+    printf("  --reps <n>          Samples per benchmark (default: %d)\n", BENCH_DEFAULT_REPS);
+    printf("  --filter <name>     Run only benchmarks whose name contains this\n");
+    printf("  --dag-nodes <n>     Nodes in the csr_resolve_* DAGs (default: %u)\n", BENCH_LARGE_DAG_NODES);
+    printf("  -h, --help          Display this help message\n");
+}
+
+int main(int argc, char **argv) {
+    const char *baseline_path = NULL;
+    const char *write_path = NULL;
+    const char *filter = NULL;
+    double tolerance = -1.0;
+    size_t reps = BENCH_DEFAULT_REPS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            write_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--dag-nodes") == 0 && i + 1 < argc) {
+            bench_large_nodes = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Error: Unknown option %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (reps == 0) reps = 1;
+    if (bench_large_nodes < 2) bench_large_nodes = 2;
+
+    char *baseline = NULL;
+    if (baseline_path) {
+        baseline = read_file(baseline_path);
+        if (!baseline) {
+            fprintf(stderr, "Error: Could not read baseline %s\n", baseline_path);
+            return 1;
+        }
+        if (tolerance < 0 && !json_number(baseline, "tolerance", &tolerance)) {
+            tolerance = -1.0;
+        }
+    }
+    if (tolerance < 0) tolerance = BENCH_DEFAULT_TOLERANCE;
+
+    trie_init();
+    dag_init();
+
+    // Timings are compared as ratios to the calibration kernel, so the
+    // baseline holds on faster or slower (or busier) machines
+    void *calibration_state = NULL;
+    if (!calibration.setup(&calibration_state)) {
+        fprintf(stderr, "Error: Could not set up benchmark %s\n", calibration.name);
+        free(baseline);
+        return 1;
+    }
+    size_t calibration_ops = bench_sample_ops(&calibration, calibration_state);
+
+    BenchResult results[BENCH_COUNT];
+    memset(results, 0, sizeof(results));
+    int regressions = 0;
+
+    printf("%-22s %12s %10s %10s %10s %9s\n",
+           "benchmark", "median ns", "MAD ns", "ratio", "baseline", "change");
+    for (size_t b = 0; b < BENCH_COUNT; b++) {
+        const Benchmark *bench = &benchmarks[b];
+        if (filter && !strstr(bench->name, filter)) continue;
+
+        if (!bench_measure(bench, reps, calibration_state, calibration_ops, &results[b])) {
+            calibration.teardown(calibration_state);
+            free(baseline);
+            return 1;
+        }
+        printf("%-22s %12.1f %10.1f %10.4g", bench->name,
+               results[b].median_ns, results[b].mad_ns, results[b].ratio);
+
+        BenchResult base;
+        if (!baseline || !baseline_entry(baseline, bench->name, &base)) {
+            printf(" %10s %9s\n", "-", "-");
+            continue;
+        }
+
+        // A regression must exceed the tolerance and stand clear of the
+        // noise of both this run and the baseline run
+        double change = (results[b].ratio - base.ratio) / base.ratio;
+        bool regressed = results[b].ratio > base.ratio * (1.0 + tolerance) &&
+                         results[b].ratio - base.ratio >
+                             BENCH_NOISE_MADS * (results[b].ratio_mad + base.ratio_mad);
+        printf(" %10.4g %+8.1f%%%s\n", base.ratio, change * 100.0, regressed ? "  REGRESSION" : "");
+        if (regressed) regressions++;
+    }
+    calibration.teardown(calibration_state);
+    free(baseline);
+
+    // Recording a baseline accepts the new numbers
+    if (write_path) return write_baseline(write_path, tolerance, results) ? 0 : 1;
+
+    if (regressions > 0) {
+        fprintf(stderr, "%d benchmark(s) regressed by more than %.0f%%\n",
+                regressions, tolerance * 100.0);
+        return 1;
+    }
+    return 0;
+}
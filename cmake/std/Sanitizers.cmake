@@ -0,0 +1,19 @@
+# Sanitizers.cmake - Optional runtime sanitizers for tests and the core library
+
+option(AXL_ENABLE_SANITIZERS "Build tests and the core library with sanitizers" OFF)
+
+# "address;undefined" catches memory errors; "thread" checks the
+# concurrent code (epochs, snapshots, reclaimer). ThreadSanitizer cannot
+# be combined with AddressSanitizer.
+set(AXL_SANITIZERS "address;undefined" CACHE STRING "Sanitizers to enable (e.g. address;undefined or thread)")
+
+# Function to instrument a target with the configured sanitizers
+function(add_sanitizers target)
+  list(JOIN AXL_SANITIZERS "," sanitizers)
+  target_compile_options(${target} PRIVATE
+    -fsanitize=${sanitizers}
+    -fno-omit-frame-pointer
+    -fno-sanitize-recover=all
+  )
+  target_link_options(${target} PRIVATE -fsanitize=${sanitizers})
+endfunction()
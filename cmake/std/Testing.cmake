@@ -14,3 +14,27 @@ function(add_axl_test test_name sources)
     # Add to CTest
     add_test(NAME ${test_name} COMMAND ${test_name})
 endfunction()
+
+# Perf regression tests compare timings against a checked-in baseline,
+# so they only make sense on a quiet machine and an optimized build
+option(AXL_ENABLE_PERF_TESTS "Register benchmark regression tests with CTest" OFF)
+set(AXL_PERF_TOLERANCE "" CACHE STRING "Allowed slowdown as a fraction (empty = baseline's own)")
+set(AXL_PERF_REPETITIONS "15" CACHE STRING "Samples per benchmark in perf tests")
+
+# Function to add a benchmark executable as a perf regression test
+function(add_axl_perf_test test_name target baseline)
+    if(NOT AXL_ENABLE_PERF_TESTS)
+        return()
+    endif()
+
+    set(args --baseline ${baseline} --reps ${AXL_PERF_REPETITIONS})
+    if(NOT AXL_PERF_TOLERANCE STREQUAL "")
+        list(APPEND args --tolerance ${AXL_PERF_TOLERANCE})
+    endif()
+
+    add_test(NAME ${test_name} COMMAND ${target} ${args})
+    set_tests_properties(${test_name} PROPERTIES
+        LABELS perf
+        RUN_SERIAL TRUE
+    )
+endfunction()
@@ -0,0 +1,43 @@
+// include/axl/core/axml/diff.h
+#ifndef AXL_AXML_DIFF_H
+#define AXL_AXML_DIFF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <axl/core/axml/parser.h>
+
+typedef enum {
+    AXML_BINDING_ADDED,
+    AXML_BINDING_REMOVED,
+    AXML_BINDING_CHANGED
+} AxmlChangeKind;
+
+/// One binding-level difference between two configurations.
+/// Bindings are matched by (concept id, binding name).
+typedef struct AxmlBindingChange {
+    AxmlChangeKind kind;
+    const char* concept_id;
+    const AxmlCompactBinding* old_binding;   // NULL when added
+    const AxmlCompactBinding* new_binding;   // NULL when removed
+} AxmlBindingChange;
+
+typedef void (*AxmlChangeHandler)(const AxmlBindingChange* change, void* user_data);
+
+/**
+ * Report every added, removed or changed binding from `old_config` to
+ * `new_config`. Returns the number of changes, or (size_t)-1 on failure.
+ */
+size_t axml_diff_configs(const AxmlCompactConfig* old_config,
+                         const AxmlCompactConfig* new_config,
+                         AxmlChangeHandler handler,
+                         void* user_data);
+
+/**
+ * True if the configurations differ in ways bindings cannot express
+ * (bust policy, memory retention, hash-consing, source path), so the
+ * DAG must be rebuilt rather than rebound.
+ */
+bool axml_diff_requires_rebuild(const AxmlCompactConfig* old_config,
+                                const AxmlCompactConfig* new_config);
+
+#endif // AXL_AXML_DIFF_H
@@ -3,6 +3,7 @@
 #define AXL_AXML_PARSER_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <axl/core/utils/memory.h>
 
 typedef enum {
@@ -45,10 +46,55 @@ typedef struct AxmlConfig {
     char* source_path;
     BustPolicy bust_policy;
     bool retain_memory;
+    bool hash_cons;          // Share structurally identical DAG nodes
+    size_t memory_budget;    // Bytes for BUST_CONDITIONAL retained DAGs (0 = unlimited)
     AxmlConcept* concepts;
     AxmlSymbol* symbols;
 } AxmlConfig;
 
+/// Offset marking an absent string in the compact string pool.
+#define AXML_NO_STRING UINT32_MAX
+
+typedef struct AxmlCompactBinding {
+    uint32_t name;             // String pool offset
+    uint32_t value;            // String pool offset, or AXML_NO_STRING
+    uint32_t values_begin;     // Range in value_offsets
+    uint32_t values_end;
+    CardinalityType cardinality;
+} AxmlCompactBinding;
+
+typedef struct AxmlCompactConcept {
+    uint32_t id;               // String pool offset
+    uint32_t bindings_begin;   // Range in bindings
+    uint32_t bindings_end;
+} AxmlCompactConcept;
+
+typedef struct AxmlCompactSymbol {
+    uint32_t id;
+    uint32_t visual;
+} AxmlCompactSymbol;
+
+/// Flat AXML configuration: one deduplicated string pool, concepts and
+/// symbols as arrays, bindings as contiguous per-concept ranges, and
+/// multi-values as ranges of string offsets.
+typedef struct AxmlCompactConfig {
+    uint32_t source_path;
+    BustPolicy bust_policy;
+    bool retain_memory;
+    bool hash_cons;
+    size_t memory_budget;
+    AxmlCompactConcept* concepts;
+    size_t concept_count;
+    AxmlCompactBinding* bindings;
+    size_t binding_count;
+    uint32_t* value_offsets;
+    size_t value_count;
+    AxmlCompactSymbol* symbols;
+    size_t symbol_count;
+    char* strings;             // NUL-terminated strings, back to back
+    size_t strings_size;
+} AxmlCompactConfig;
+
 /**
  * Parse an AXML configuration file
  */
@@ -59,4 +105,31 @@ AxmlConfig* axml_parse_file(const char* filename);
  */
 void axml_free_config(AxmlConfig* config);
 
+/**
+ * Convert a parsed configuration to its compact form
+ */
+AxmlCompactConfig* axml_compact_config(const AxmlConfig* config);
+
+/**
+ * Deep-copy a compact configuration
+ */
+AxmlCompactConfig* axml_copy_compact_config(const AxmlCompactConfig* config);
+
+/**
+ * Parse an AXML configuration file directly into compact form
+ */
+AxmlCompactConfig* axml_parse_compact(const char* filename);
+
+/**
+ * Free a compact configuration (two allocations)
+ */
+void axml_free_compact_config(AxmlCompactConfig* config);
+
+/**
+ * Resolve a string pool offset (NULL for AXML_NO_STRING)
+ */
+static inline const char* axml_string(const AxmlCompactConfig* config, uint32_t offset) {
+    return offset == AXML_NO_STRING ? NULL : config->strings + offset;
+}
+
 #endif // AXL_AXML_PARSER_H
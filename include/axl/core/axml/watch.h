@@ -0,0 +1,32 @@
+// include/axl/core/axml/watch.h
+#ifndef AXL_AXML_WATCH_H
+#define AXL_AXML_WATCH_H
+
+#include <stdbool.h>
+
+typedef struct AxmlWatcher AxmlWatcher;
+
+/**
+ * Watch an AXML file for changes (inotify on its directory, so editors
+ * that save by rename are seen too)
+ */
+AxmlWatcher* axml_watch_create(const char* path);
+
+/**
+ * Pollable descriptor, for callers with their own event loop
+ */
+int axml_watch_fd(const AxmlWatcher* watcher);
+
+/**
+ * Wait up to `timeout_ms` (-1 = forever) for the file to change.
+ * Bursts of events are coalesced into one notification.
+ * Returns 1 if the file changed, 0 on timeout, -1 on error.
+ */
+int axml_watch_wait(AxmlWatcher* watcher, int timeout_ms);
+
+/**
+ * Stop watching and free resources
+ */
+void axml_watch_destroy(AxmlWatcher* watcher);
+
+#endif // AXL_AXML_WATCH_H
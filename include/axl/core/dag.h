@@ -1,7 +1,7 @@
 #ifndef AXL_DAG_H
 #define AXL_DAG_H
 
-#include <stddef.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <axl/core/token.h>     // For TokenType
 #include <axl/core/taxonomy.h>  // For TaxonomyCategory
@@ -20,6 +20,14 @@ typedef enum {
     STATE_FALSE
 } TruthValue;
 
+/// Result codes for DAG mutations.
+typedef enum {
+    DAG_OK = 0,
+    DAG_ERR_INVALID = -1,      // NULL node
+    DAG_ERR_NOMEM = -2,
+    DAG_ERR_CYCLE = -3         // The edge would close a cycle
+} DAGStatus;
+
 /// Edge in the semantic DAG.
 typedef struct DAGEdge {
     struct DAGNode *target;
@@ -36,22 +44,67 @@ typedef struct DAGNode {
     size_t           in_count;
     DAGEdge         *out_edges;    // Array of outgoing edges
     size_t           out_count;
+    size_t           ord;          // Topological index: ord(from) < ord(to) on every edge
+    size_t           id;           // Creation sequence number; unlike ord, never renumbered
+    bool             mark;         // Scratch flag for dag_add_edge's reordering
 } DAGNode;
 
 /// Create an empty DAG node.
 DAGNode*    dag_node_create(TokenType t,
                             TaxonomyCategory cat);
 
-/// Link `from` → `to` with given weight.
-void        dag_add_edge(DAGNode *from,
+/// Free a node and its edge arrays. Nodes linked to it keep dangling
+/// edges, so destroy whole graphs at once.
+void        dag_node_destroy(DAGNode *node);
+
+/// Link `from` → `to` with given weight, keeping the topological
+/// order current (Pearce–Kelly: only nodes between the two endpoints'
+/// positions are visited and renumbered).
+/// Returns DAG_OK, or DAG_ERR_CYCLE if `to` already reaches `from`.
+int         dag_add_edge(DAGNode *from,
                          DAGNode *to,
                          float weight);
 
-/// Topologically resolve all nodes' truth values.
+/// Resolve all nodes' truth values in their maintained topological
+/// order. Roots are true; others follow their weighted inputs.
 void        dag_resolve(DAGNode *nodes[],
                         size_t node_count);
 
+/// Approximate heap bytes held by `nodes` and their edge arrays.
+size_t      dag_memory_footprint(DAGNode *nodes[],
+                                 size_t node_count);
+
 /// Initialize the DAG subsystem
 int         dag_init(void);
 
+/// Hash-consing table for structurally identical nodes.
+/// Two nodes are equal when type, category and the set of incoming
+/// edges with their weights match. Edges are put in canonical order by
+/// source id, so interning is deterministic across runs.
+typedef struct DAGConsTable DAGConsTable;
+
+/// Sharing statistics for a hash-consing table.
+typedef struct DAGConsStats {
+    size_t           created;      // Distinct nodes allocated
+    size_t           shared;       // Requests answered by an existing node
+} DAGConsStats;
+
+/// Create an empty hash-consing table.
+DAGConsTable* dag_cons_create(void);
+
+/// Return the unique node with `t`, `cat` and exactly these incoming
+/// edges (edge.target is the source node), creating and linking it on
+/// first use. Interned nodes must not receive further incoming edges.
+DAGNode*    dag_node_intern(DAGConsTable *table,
+                            TokenType t,
+                            TaxonomyCategory cat,
+                            const DAGEdge *in_edges,
+                            size_t in_count);
+
+/// Read sharing statistics.
+DAGConsStats dag_cons_stats(const DAGConsTable *table);
+
+/// Destroy the table. Interned nodes are owned by the caller.
+void        dag_cons_destroy(DAGConsTable *table);
+
 #endif // AXL_DAG_H
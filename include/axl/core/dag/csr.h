@@ -0,0 +1,83 @@
+// include/axl/core/dag/csr.h
+#ifndef AXL_DAG_CSR_H
+#define AXL_DAG_CSR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <axl/core/dag.h>
+
+/// Immutable compressed-sparse-row form of a built DAG.
+/// Node i's incoming edges are in_sources/in_weights[in_offsets[i] ..
+/// in_offsets[i + 1]); outgoing edges likewise via out_offsets. Node
+/// attributes live in parallel arrays indexed by node id. All arrays
+/// share one allocation, with the arrays resolution reads (in-edges,
+/// weights, states) ahead of the out-edges and cold attributes.
+typedef struct DAGCsr {
+    uint32_t  node_count;
+    uint32_t  edge_count;
+    uint32_t *in_offsets;      // node_count + 1 entries
+    uint32_t *in_sources;      // Source node id per incoming edge
+    float    *in_weights;      // Weight per incoming edge
+    uint32_t *out_offsets;     // node_count + 1 entries
+    uint32_t *out_targets;     // Target node id per outgoing edge
+    uint8_t  *types;           // TokenType per node
+    uint8_t  *categories;      // TaxonomyCategory per node
+    uint8_t  *states;          // TruthValue per node
+    bool      sorted;          // Ids are a topological order (sources < targets)
+    size_t    bytes;           // Size of the backing allocation
+} DAGCsr;
+
+/// Node orders for dag_csr_reorder().
+typedef enum {
+    DAG_ORDER_TOPOLOGICAL = 0, // Level by level; resolves in one sequential sweep
+    DAG_ORDER_RCM              // Reverse Cuthill–McKee; minimizes edge id spans
+} DAGOrderKind;
+
+/**
+ * Freeze `nodes[0..node_count)` into CSR form. Node ids are array
+ * positions; an empty set gives an empty CSR. Fails if an edge leaves
+ * the set or a limit is exceeded.
+ * The pointer-based nodes are left untouched.
+ */
+DAGCsr* dag_freeze(DAGNode *nodes[], size_t node_count);
+
+/**
+ * Size of the single block dag_freeze() allocates for a DAG of this shape
+ */
+size_t dag_csr_block_bytes(size_t node_count, size_t edge_count);
+
+/**
+ * Resolve truth values in topological order over the frozen form.
+ * Returns 0 on success, non-zero if a cycle left nodes unresolved.
+ */
+int dag_csr_resolve(DAGCsr *csr);
+
+/**
+ * Compute a topological order of the frozen DAG (Kahn). Returns a
+ * malloc'd array of node ids; `*count` < node_count means a cycle.
+ */
+uint32_t* dag_csr_topological_order(const DAGCsr *csr, uint32_t *count);
+
+/**
+ * Compute a cache-friendly node order for `csr`. Returns a malloc'd
+ * array mapping new id -> old id, or NULL on failure or (for
+ * DAG_ORDER_TOPOLOGICAL) if the graph has a cycle.
+ */
+uint32_t* dag_csr_locality_order(const DAGCsr *csr, DAGOrderKind kind);
+
+/**
+ * Copy `csr` into a fresh allocation with node i of the copy being node
+ * order[i] of the original; every edge is rewritten, each node's
+ * in-edges staying in their original order so resolution gives the
+ * same states. Returns NULL if `order` is not a permutation. Callers
+ * holding old ids must map them through `order`.
+ */
+DAGCsr* dag_csr_reorder(const DAGCsr *csr, const uint32_t *order);
+
+/**
+ * Free a frozen DAG
+ */
+void dag_csr_destroy(DAGCsr *csr);
+
+#endif // AXL_DAG_CSR_H
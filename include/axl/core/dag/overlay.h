@@ -0,0 +1,72 @@
+// include/axl/core/dag/overlay.h
+#ifndef AXL_DAG_OVERLAY_H
+#define AXL_DAG_OVERLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <axl/core/dag/csr.h>
+
+/// Per-variant override of one node of a shared frozen DAG.
+typedef struct DAGOverlayEntry {
+    uint32_t    node;
+    TruthValue  state;             // Pinned state, or STATE_UNKNOWN to leave it derived
+    const void *binding;           // Variant's AXML binding for the node
+} DAGOverlayEntry;
+
+/// Sparse set of node overrides describing one configuration variant.
+/// The shared topology is never modified.
+typedef struct DAGOverlay {
+    DAGOverlayEntry *entries;
+    size_t           count;
+    size_t           capacity;
+} DAGOverlay;
+
+/// Outcome of resolving one variant.
+typedef struct DAGVariantResult {
+    bool    ok;                    // Every node reached a topological position
+    size_t  true_count;
+    size_t  false_count;
+    size_t  unknown_count;
+} DAGVariantResult;
+
+/**
+ * Initialize an empty overlay
+ */
+void dag_overlay_init(DAGOverlay *overlay);
+
+/**
+ * Override `node` for this variant (replaces an earlier override)
+ */
+bool dag_overlay_set(DAGOverlay *overlay, uint32_t node,
+                     TruthValue state, const void *binding);
+
+/**
+ * Free overlay storage
+ */
+void dag_overlay_free(DAGOverlay *overlay);
+
+/**
+ * Resolve `csr` under one overlay into `states[0..node_count)`.
+ * `order` is the topology's order from dag_csr_topological_order(), or
+ * NULL with order_count == node_count when csr->sorted.
+ */
+DAGVariantResult dag_overlay_resolve(const DAGCsr *csr,
+                                     const uint32_t *order,
+                                     uint32_t order_count,
+                                     const DAGOverlay *overlay,
+                                     uint8_t *states);
+
+/**
+ * Resolve every overlay against the same topology on up to `threads`
+ * worker threads (0 = one per online CPU). `states` may be NULL, or hold
+ * one node_count-sized array per variant. Returns false on setup failure.
+ */
+bool dag_resolve_variants(const DAGCsr *csr,
+                          const DAGOverlay *overlays,
+                          size_t variant_count,
+                          uint8_t **states,
+                          DAGVariantResult *results,
+                          size_t threads);
+
+#endif // AXL_DAG_OVERLAY_H
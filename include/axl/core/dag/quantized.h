@@ -0,0 +1,68 @@
+// include/axl/core/dag/quantized.h
+#ifndef AXL_DAG_QUANTIZED_H
+#define AXL_DAG_QUANTIZED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <axl/core/dag/csr.h>
+
+/// Edge states per packed word (2 bits each).
+#define DAG_QUANT_STATES_PER_WORD 16
+
+/// Quantized resolve layout derived from a frozen DAG. Edge weights
+/// are int16 fixed point (weight * scale), and each node's source
+/// states are packed 2 bits per edge into whole words of their own,
+/// so in-edge sums are exact integer arithmetic and independent of
+/// summation order. All arrays share one allocation.
+typedef struct DAGQuantized {
+    uint32_t  node_count;
+    uint32_t  edge_count;
+    float     scale;           // Quantized weight = lrintf(weight * scale)
+    uint32_t *in_offsets;      // node_count + 1 entries, as in DAGCsr
+    uint32_t *in_sources;
+    int16_t  *in_weights;
+    uint32_t *state_offsets;   // node_count + 1 entries, in words
+    uint32_t *edge_states;     // Packed TruthValue of each in-edge's source
+    uint32_t *order;           // Topological order
+    uint32_t  order_count;     // < node_count if the DAG has a cycle
+    uint8_t  *states;          // TruthValue per node
+    size_t    bytes;
+} DAGQuantized;
+
+/// Accumulation kernels for in-edge sums.
+typedef enum {
+    DAG_QUANT_KERNEL_AUTO = 0,   // Best the CPU supports
+    DAG_QUANT_KERNEL_SCALAR,
+    DAG_QUANT_KERNEL_SSE2,
+    DAG_QUANT_KERNEL_AVX2
+} DAGQuantKernel;
+
+/**
+ * Build the quantized layout for `csr`. Weights are scaled so the
+ * largest magnitude maps to INT16_MAX.
+ */
+DAGQuantized* dag_quantize(const DAGCsr *csr);
+
+/**
+ * Resolve truth values with the same rules as dag_csr_resolve.
+ * Returns 0 on success, non-zero if a cycle left nodes unresolved.
+ */
+int dag_quantized_resolve(DAGQuantized *quantized);
+
+/**
+ * Select the accumulation kernel (for testing and benchmarks).
+ * Returns false if the CPU does not support it.
+ */
+bool dag_quantized_use_kernel(DAGQuantKernel kernel);
+
+/**
+ * Name of the kernel in use ("avx2", "sse2" or "scalar")
+ */
+const char* dag_quantized_kernel_name(void);
+
+/**
+ * Free the quantized layout
+ */
+void dag_quantized_destroy(DAGQuantized *quantized);
+
+#endif // AXL_DAG_QUANTIZED_H
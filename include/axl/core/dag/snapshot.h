@@ -0,0 +1,130 @@
+// include/axl/core/dag/snapshot.h
+#ifndef AXL_DAG_SNAPSHOT_H
+#define AXL_DAG_SNAPSHOT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/runtime/epoch.h>
+
+/// Nodes per copy-on-write page.
+#define DAG_SNAPSHOT_PAGE_SHIFT  10
+#define DAG_SNAPSHOT_PAGE_NODES  (1u << DAG_SNAPSHOT_PAGE_SHIFT)
+#define DAG_SNAPSHOT_PAGE_MASK   (DAG_SNAPSHOT_PAGE_NODES - 1)
+
+/// Per-node mutable data for a range of nodes, shared between versions
+/// until a writer modifies it.
+typedef struct DAGSnapshotPage {
+    atomic_uint  refs;                              // Versions referencing this page
+    uint64_t     owner;                             // Version allowed to write in place
+    uint8_t      states[DAG_SNAPSHOT_PAGE_NODES];   // TruthValue per node
+    const void  *bindings[DAG_SNAPSHOT_PAGE_NODES]; // Applied AXML binding per node
+} DAGSnapshotPage;
+
+/// One immutable version of the node states and bindings of a frozen DAG.
+typedef struct DAGSnapshot {
+    uint64_t         version;
+    uint32_t         node_count;
+    uint32_t         page_count;
+    DAGSnapshotPage *pages[];
+} DAGSnapshot;
+
+/// A frozen DAG topology plus its published snapshot versions.
+/// Any number of registered readers; a single writer at a time.
+typedef struct DAGVersioned DAGVersioned;
+
+/**
+ * Create a versioned view over `topology`, which must outlive it.
+ * Version 1 takes its states from topology->states.
+ */
+DAGVersioned* dag_versioned_create(const DAGCsr *topology, size_t max_readers);
+
+/**
+ * Destroy all versions. No reader may hold a pinned snapshot.
+ */
+void dag_versioned_destroy(DAGVersioned *versioned);
+
+/**
+ * Claim a reader slot for the calling thread (-1 if none left)
+ */
+int dag_versioned_register_reader(DAGVersioned *versioned);
+
+/**
+ * Release a reader slot
+ */
+void dag_versioned_unregister_reader(DAGVersioned *versioned, int reader);
+
+/**
+ * Pin the latest published snapshot. It stays valid until unpinned.
+ */
+const DAGSnapshot* dag_snapshot_pin(DAGVersioned *versioned, int reader);
+
+/**
+ * Release a snapshot pinned by `reader`
+ */
+void dag_snapshot_unpin(DAGVersioned *versioned, int reader);
+
+/**
+ * Start a draft of the next version. Shares every page with the
+ * current version until modified. Writer side only.
+ */
+DAGSnapshot* dag_snapshot_begin(DAGVersioned *versioned);
+
+/**
+ * Set a node's state in a draft (copies its page on first write)
+ */
+bool dag_snapshot_set_state(DAGVersioned *versioned, DAGSnapshot *draft,
+                            uint32_t node, TruthValue state);
+
+/**
+ * Set a node's binding in a draft (copies its page on first write)
+ */
+bool dag_snapshot_set_binding(DAGVersioned *versioned, DAGSnapshot *draft,
+                              uint32_t node, const void *binding);
+
+/**
+ * Re-resolve a draft: root nodes and nodes with a binding keep their
+ * state, every other node is recomputed from its sources in topological
+ * order. Only pages whose states change are copied.
+ */
+bool dag_snapshot_resolve(DAGVersioned *versioned, DAGSnapshot *draft);
+
+/**
+ * Like dag_snapshot_resolve(), but only recompute nodes downstream of
+ * `changed[0..count)`, the nodes whose state or binding the draft
+ * modified. Every other node already holds its resolved state.
+ */
+bool dag_snapshot_resolve_from(DAGVersioned *versioned, DAGSnapshot *draft,
+                               const uint32_t *changed, size_t count);
+
+/**
+ * Atomically publish a draft; the previous version is reclaimed once
+ * no reader has it pinned.
+ */
+void dag_snapshot_publish(DAGVersioned *versioned, DAGSnapshot *draft);
+
+/**
+ * Defer `free_fn(ptr)` until no reader pins a version published before
+ * this call, e.g. for data the previous versions' bindings point into.
+ */
+bool dag_versioned_retire(DAGVersioned *versioned, void *ptr, EpochFreeFn free_fn);
+
+/**
+ * Discard an unpublished draft
+ */
+void dag_snapshot_abort(DAGVersioned *versioned, DAGSnapshot *draft);
+
+/// Resolved truth value of `node` in a pinned snapshot.
+static inline TruthValue dag_snapshot_state(const DAGSnapshot *snapshot, uint32_t node) {
+    const DAGSnapshotPage *page = snapshot->pages[node >> DAG_SNAPSHOT_PAGE_SHIFT];
+    return (TruthValue)page->states[node & DAG_SNAPSHOT_PAGE_MASK];
+}
+
+/// Binding applied to `node` in a pinned snapshot, or NULL.
+static inline const void* dag_snapshot_binding(const DAGSnapshot *snapshot, uint32_t node) {
+    const DAGSnapshotPage *page = snapshot->pages[node >> DAG_SNAPSHOT_PAGE_SHIFT];
+    return page->bindings[node & DAG_SNAPSHOT_PAGE_MASK];
+}
+
+#endif // AXL_DAG_SNAPSHOT_H
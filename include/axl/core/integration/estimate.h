@@ -0,0 +1,39 @@
+// include/axl/core/integration/estimate.h
+#ifndef AXL_ESTIMATE_H
+#define AXL_ESTIMATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Predicted shape and cost of the semantic DAG for an AXL/AXML pair,
+/// computed by the semantic parser with counting reductions instead of
+/// the DAG builder's, so nothing is allocated per node.
+typedef struct AxlCostEstimate {
+    size_t source_bytes;
+    size_t tokens;             // Tokens that become DAG nodes
+    size_t statements;
+    size_t nodes;              // Nodes without hash-consing
+    size_t shared_nodes;       // Distinct nodes with hash-consing
+    size_t edges;
+    size_t max_depth;          // Longest source-to-sink chain, in nodes
+    size_t bindings;           // AXML bindings to apply
+    size_t dag_bytes;          // Peak heap for the pointer-based DAG
+    size_t retained_bytes;     // CSR and snapshot kept after execution (0 if busted)
+    size_t resolve_work;       // Node + edge visits for one resolve pass
+    bool   hash_cons;          // Whether the config enables hash-consing
+} AxlCostEstimate;
+
+/**
+ * Estimate the DAG for AXL source text. Only the AXL-derived fields
+ * are filled; the rest are zeroed.
+ * @return false if the source would not build (syntax error or cycle)
+ */
+bool axl_estimate_source(const char* data, size_t size, AxlCostEstimate* out);
+
+/**
+ * Estimate the DAG for an AXL file under an AXML configuration.
+ * @return false if either file cannot be read or the source would not build
+ */
+bool axl_estimate_cost(const char* axl_path, const char* axml_path, AxlCostEstimate* out);
+
+#endif // AXL_ESTIMATE_H
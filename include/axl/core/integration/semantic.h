@@ -0,0 +1,190 @@
+// include/axl/core/integration/semantic.h
+#ifndef AXL_SEMANTIC_H
+#define AXL_SEMANTIC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <axl/core/dag.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/trie.h>
+
+/*
+ * AXL statements and the semantic DAG they build:
+ *
+ *   statement := [let | const | var] IDENT [verb expr] ';'
+ *   verb      := '=' | is | has
+ *   expr      := operand {('+' | '-') operand}
+ *   operand   := IDENT | LITERAL | '(' expr ')'
+ *
+ * Every identifier is one node, however often it appears. Literals and
+ * operators are nodes whose in-edges come from their operands, and a
+ * definition links its value into the defined identifier. Each edge
+ * carries the weight of its source token. A definition that would make
+ * an identifier depend on itself is rejected.
+ */
+
+/// Where and why parsing or building stopped.
+typedef struct AxlSemanticError {
+    size_t      offset;        // Byte offset in the source
+    const char *message;       // Static string
+} AxlSemanticError;
+
+/// Reduction callbacks driven by axl_semantic_parse(). Handles are
+/// opaque to the parser; a handle of 0 reports out of memory.
+typedef struct AxlSemanticReducer {
+    void      *ctx;
+    uintptr_t (*symbol)(void *ctx, const char *name, size_t len);
+    uintptr_t (*literal)(void *ctx);
+    uintptr_t (*operation)(void *ctx, TokenType type, TaxonomyCategory category,
+                           uintptr_t lhs, float lhs_weight,
+                           uintptr_t rhs, float rhs_weight);
+    int       (*define)(void *ctx, uintptr_t target, uintptr_t value, float weight);  // DAGStatus
+    void      (*statement)(void *ctx);                                               // May be NULL
+} AxlSemanticReducer;
+
+/**
+ * Scan tokens of every later parse in this process with
+ * trie_scan_interpreted() over `patterns` (as loaded by
+ * trie_load_pattern_file()) instead of the generated scanner; NULL
+ * restores it. The patterns must outlive those parses.
+ */
+void axl_semantic_set_patterns(TrieNode *const *patterns, size_t count);
+
+/**
+ * Whether parses currently scan with loaded patterns
+ */
+bool axl_semantic_has_patterns(void);
+
+/// Sources with less than this per thread are lexed on one thread.
+#define AXL_SEMANTIC_LEX_CHUNK (1u << 20)
+
+/// One token as the parser sees it. Whitespace and comments produce none.
+typedef struct AxlSemanticToken {
+    size_t           offset;       // Byte offset in the source
+    size_t           length;
+    TokenType        type;
+    TaxonomyCategory category;
+    float            weight;
+} AxlSemanticToken;
+
+/// Tokens of one source, up to its first lexical error.
+typedef struct AxlSemanticTokens {
+    AxlSemanticToken *tokens;
+    size_t            count;
+    size_t            capacity;
+    bool              failed;      // Lexing stopped at `error`
+    AxlSemanticError  error;
+} AxlSemanticTokens;
+
+/**
+ * Lex `data[0..size)` with the parser's lexer. With `threads` > 1 the
+ * source is split after newlines into that many chunks, each chunk is
+ * lexed from every state a line can start in (code, inside a string,
+ * inside a block comment) and a sequential pass stitches the runs that
+ * match the real entry states. The result equals the serial one.
+ * Loaded patterns (axl_semantic_set_patterns()) are always lexed serially.
+ * @return false if out of memory; lexical errors are reported in `out`
+ */
+bool axl_semantic_lex(const char *data, size_t size, size_t threads, AxlSemanticTokens *out);
+
+/**
+ * Free a token array
+ */
+void axl_semantic_tokens_free(AxlSemanticTokens *tokens);
+
+/**
+ * Lex sources of every later parse with up to `threads` threads (0, the
+ * default, uses every core; 1 never lexes in parallel)
+ */
+void axl_semantic_set_lex_threads(size_t threads);
+
+/**
+ * Threads a parse of `size` bytes lexes with: at most one per
+ * AXL_SEMANTIC_LEX_CHUNK bytes, and 1 while patterns are loaded
+ */
+size_t axl_semantic_lex_threads(size_t size);
+
+/**
+ * Parse AXL source text, reducing each construct through `reducer`.
+ * Large sources are lexed in parallel first (see axl_semantic_lex()).
+ * @return false with `error` filled on a syntax error, a rejected
+ *         definition or a failed reduction
+ */
+bool axl_semantic_parse(const char *data, size_t size,
+                        const AxlSemanticReducer *reducer, AxlSemanticError *error);
+
+/// Identifier name -> node table of one DAG.
+typedef struct AxlSymbols AxlSymbols;
+
+/// Pointer-based semantic DAG of one AXL source.
+typedef struct AxlSemanticDag {
+    DAGNode    **nodes;        // Every node, in creation order
+    size_t       node_count;
+    size_t       capacity;
+    size_t       edge_count;
+    size_t       statements;
+    bool         hash_cons;    // Built with a DAGConsTable
+    AxlSymbols  *symbols;
+} AxlSemanticDag;
+
+/**
+ * Build the semantic DAG of `data[0..size)`. With `cons`, literals and
+ * operator nodes with identical inputs are shared.
+ * @return false with `error` filled; `dag` is then empty
+ */
+bool axl_semantic_build(const char *data, size_t size, DAGConsTable *cons,
+                        AxlSemanticDag *dag, AxlSemanticError *error);
+
+/**
+ * Free every node and the symbol table
+ */
+void axl_semantic_destroy(AxlSemanticDag *dag);
+
+/// Node layout axl_semantic_freeze() gives the CSR.
+typedef enum {
+    AXL_FREEZE_ORDER_NONE = 0, // The order maintained while building
+    AXL_FREEZE_ORDER_TOPOLOGICAL, // Level by level (DAG_ORDER_TOPOLOGICAL)
+    AXL_FREEZE_ORDER_RCM       // Reverse Cuthill–McKee (DAG_ORDER_RCM)
+} AxlFreezeOrder;
+
+/// Frozen semantic DAG: CSR topology plus the identifiers' node ids, so
+/// bindings can be applied by name. Ids are topological unless frozen
+/// in RCM order.
+typedef struct AxlFrozenDag {
+    DAGCsr        *csr;
+    AxlSymbols    *symbols;
+    bool           hash_cons;  // Built with a DAGConsTable
+    AxlFreezeOrder order;      // Layout it was frozen in
+    size_t         bytes;      // CSR block plus symbol table
+} AxlFrozenDag;
+
+/**
+ * Lay out DAGs frozen from now on in `order` (default
+ * AXL_FREEZE_ORDER_NONE). Resolved states are the same in any layout.
+ */
+void axl_semantic_set_freeze_order(AxlFreezeOrder order);
+
+/**
+ * Layout axl_semantic_freeze() currently uses
+ */
+AxlFreezeOrder axl_semantic_freeze_order(void);
+
+/**
+ * Freeze a built DAG in the current freeze order. The symbol table
+ * moves to the frozen form; the pointer-based nodes are left for the
+ * caller to destroy.
+ */
+AxlFrozenDag* axl_semantic_freeze(AxlSemanticDag *dag);
+
+/**
+ * Node id of identifier `name` in a frozen DAG
+ */
+bool axl_frozen_lookup(const AxlFrozenDag *frozen, const char *name, uint32_t *node);
+
+/**
+ * Free a frozen DAG (takes void* to serve as a free callback)
+ */
+void axl_frozen_destroy(void *frozen);
+
+#endif // AXL_SEMANTIC_H
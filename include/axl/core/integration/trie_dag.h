@@ -3,13 +3,96 @@
 #define AXL_TRIE_DAG_INTEGRATION_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <axl/core/axml/parser.h>
+#include <axl/core/runtime/cache.h>
+
+/// Command-line overrides of the AXML configuration's settings.
+typedef struct AxlExecutionOverrides {
+    bool retain_memory;        // Retain DAGs whatever the bust policy says
+    size_t memory_budget;      // Retained-DAG budget in bytes (0 = the AXML budget)
+    bool budget_rss;           // Apply the budget to process RSS
+} AxlExecutionOverrides;
+
+/**
+ * Apply `overrides` (NULL to clear them) to every later execution in
+ * this process
+ */
+void axl_set_execution_overrides(const AxlExecutionOverrides* overrides);
 
 /**
- * Execute an AXL file with AXML configuration
+ * Execute an AXL file with AXML configuration. A retained DAG is kept
+ * in frozen CSR form, owned by the process-wide memory governor, with
+ * its bindings applied as copy-on-write snapshots.
  * @param axl_path Path to AXL source file
  * @param axml_path Path to AXML configuration file
  * @return Success status of execution
  */
 bool execute_axl_with_busting(const char* axl_path, const char* axml_path);
 
+/**
+ * Execute AXL source text that is already in memory. Several threads
+ * may execute different sources under one configuration at once.
+ * @param name Name of the source in diagnostics and results
+ * @param data Source text
+ * @param size Length of `data` in bytes
+ * @param config Parsed AXML configuration; not retained
+ * @return Success status of execution
+ */
+bool execute_axl_source(const char* name, const char* data, size_t size,
+                        const AxmlCompactConfig* config);
+
+/**
+ * Evaluate an AXL file under several AXML configurations (what-if mode).
+ * The semantic DAG is built once per distinct set of build settings
+ * (see axml_diff_requires_rebuild()); each configuration only
+ * contributes a node state/binding overlay to its group's DAG, and a
+ * group's variants are resolved in parallel.
+ * @param axl_path Path to AXL source file
+ * @param axml_paths Paths to AXML configuration files, one per variant
+ * @param variant_count Number of configurations
+ * @param results Receives the execution status of each variant
+ * @return false if no DAG could be built
+ */
+bool execute_axl_variants(const char* axl_path, const char** axml_paths,
+                          size_t variant_count, bool* results);
+
+/**
+ * Execute many AXL files under one AXML configuration (batch mode).
+ * Files are loaded through the asynchronous corpus loader and executed
+ * in completion order by a pool of worker threads.
+ * @param axl_paths Paths to AXL source files
+ * @param count Number of files
+ * @param axml_path Path to AXML configuration file
+ * @param results Receives the execution status of each file, in path order
+ * @return false if the loader could not be started
+ */
+bool execute_axl_batch(const char** axl_paths, size_t count,
+                       const char* axml_path, bool* results);
+
+/**
+ * Execute an AXL file, then keep its DAG alive and re-apply the AXML
+ * configuration whenever the file changes. Each change is published
+ * as a new binding snapshot, so only nodes downstream of a differing
+ * binding change state; the DAG is rebuilt only when policy-level
+ * settings change.
+ * @param axl_path Path to AXL source file
+ * @param axml_path Path to the AXML configuration file to watch
+ * @return false if the initial execution could not be set up or
+ *         watching failed
+ */
+bool watch_axl_with_busting(const char* axl_path, const char* axml_path);
+
+/**
+ * Execute an AXL file like execute_axl_with_busting, reusing parsed
+ * configurations and frozen DAGs from `cache` while their source files
+ * are unchanged (compile-server mode). Artifacts built on a miss are
+ * stored back into the cache.
+ * @param cache Warm artifact cache owned by the caller
+ * @param axl_path Path to AXL source file
+ * @param axml_path Path to AXML configuration file
+ * @return Success status of execution
+ */
+bool execute_axl_cached(AxlCache* cache, const char* axl_path, const char* axml_path);
+
 #endif // AXL_TRIE_DAG_INTEGRATION_H
@@ -0,0 +1,79 @@
+// include/axl/core/runtime/cache.h
+#ifndef AXL_CACHE_H
+#define AXL_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <time.h>
+
+/// What a cached artifact was built from a file into.
+typedef enum {
+    AXL_CACHE_CONFIG,      // AxmlCompactConfig parsed from an AXML file
+    AXL_CACHE_PATTERNS,    // Loaded pattern file with its regexes compiled
+    AXL_CACHE_DAG          // Frozen semantic DAG for an AXL file
+} AxlCacheKind;
+
+typedef void (*AxlCacheFreeFn)(void *value);
+
+/// Identity and freshness of a file as of one lookup.
+typedef struct {
+    bool            valid;         // false if the file could not be stat()ed
+    dev_t           dev;           // File identity, independent of the path spelling
+    ino_t           ino;
+    struct timespec mtime;
+    off_t           size;
+} AxlCacheStamp;
+
+/// Artifacts keyed by (kind, file identity), valid while the file's
+/// modification time and size are unchanged. Not thread-safe.
+typedef struct AxlCache AxlCache;
+
+typedef struct {
+    size_t entries;
+    size_t hits;
+    size_t misses;         // Includes stale entries that were dropped
+    size_t evictions;
+} AxlCacheStats;
+
+/**
+ * Create a cache that keeps up to `capacity` entries after a trim
+ */
+AxlCache* axl_cache_create(size_t capacity);
+
+/**
+ * Look up the artifact built from `path`. Returns NULL if absent or if
+ * the file changed since it was stored (the stale entry is freed).
+ * The pointer stays valid until the next axl_cache_trim().
+ * `stamp` (may be NULL) receives the file's state as of the lookup.
+ */
+void* axl_cache_get(AxlCache *cache, AxlCacheKind kind, const char *path,
+                    AxlCacheStamp *stamp);
+
+/**
+ * Store an artifact built from the file `stamp` was taken of, replacing
+ * any older one. Take the stamp before reading the file: if the file
+ * changes in between, the entry is stale at the next lookup rather than
+ * describing contents that were never read. On failure (including an
+ * invalid stamp) the caller keeps ownership of `value`.
+ */
+bool axl_cache_put(AxlCache *cache, AxlCacheKind kind, const AxlCacheStamp *stamp,
+                   void *value, AxlCacheFreeFn free_fn);
+
+/**
+ * Evict least recently used entries down to the capacity.
+ * Call between requests, never while holding looked-up pointers.
+ */
+size_t axl_cache_trim(AxlCache *cache);
+
+/**
+ * Current counters
+ */
+AxlCacheStats axl_cache_stats(const AxlCache *cache);
+
+/**
+ * Free every entry and the cache itself
+ */
+void axl_cache_destroy(AxlCache *cache);
+
+#endif // AXL_CACHE_H
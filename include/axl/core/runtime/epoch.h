@@ -0,0 +1,64 @@
+// include/axl/core/runtime/epoch.h
+#ifndef AXL_EPOCH_H
+#define AXL_EPOCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Epoch-based reclamation domain.
+/// Readers bracket accesses with epoch_enter()/epoch_exit() on a
+/// registered slot; writers unlink an object, then epoch_retire() it.
+/// The object is freed by epoch_reclaim() once no reader that could
+/// still see it remains inside its critical section.
+typedef struct EpochDomain EpochDomain;
+
+typedef void (*EpochFreeFn)(void *ptr);
+
+/**
+ * Create a domain with room for `max_readers` concurrent reader slots
+ */
+EpochDomain* epoch_domain_create(size_t max_readers);
+
+/**
+ * Claim a reader slot. Returns the slot id, or -1 if all are taken.
+ */
+int epoch_register(EpochDomain *domain);
+
+/**
+ * Release a reader slot. The reader must not be inside a critical section.
+ */
+void epoch_unregister(EpochDomain *domain, int slot);
+
+/**
+ * Enter a read-side critical section (not reentrant)
+ */
+void epoch_enter(EpochDomain *domain, int slot);
+
+/**
+ * Leave a read-side critical section
+ */
+void epoch_exit(EpochDomain *domain, int slot);
+
+/**
+ * Defer `free_fn(ptr)` until no reader can hold a reference.
+ * `ptr` must already be unreachable for new readers.
+ */
+bool epoch_retire(EpochDomain *domain, void *ptr, EpochFreeFn free_fn);
+
+/**
+ * Advance the epoch and free every retired object that is now safe.
+ * Returns the number of objects freed.
+ */
+size_t epoch_reclaim(EpochDomain *domain);
+
+/**
+ * Number of retired objects still waiting for a grace period
+ */
+size_t epoch_pending(EpochDomain *domain);
+
+/**
+ * Free all pending objects and the domain. No reader may be active.
+ */
+void epoch_domain_destroy(EpochDomain *domain);
+
+#endif // AXL_EPOCH_H
@@ -3,6 +3,8 @@
 #define AXL_EVENT_BUS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 typedef enum {
     EVENT_DAG_NODE_CREATED,
@@ -10,7 +12,9 @@ typedef enum {
     EVENT_DAG_NODE_BUSTED,
     EVENT_TRIE_MATCH,
     EVENT_CACHE_MISS,
-    EVENT_CACHE_HIT
+    EVENT_CACHE_HIT,
+    EVENT_AGGREGATE,           // Coalesced events; data is an EventAggregate
+    EVENT_TYPE_COUNT
 } EventType;
 
 typedef struct {
@@ -20,6 +24,28 @@ typedef struct {
     size_t data_size;
 } Event;
 
+/// Payload of an EVENT_AGGREGATE: what a coalescing policy absorbed.
+typedef struct {
+    EventType type;            // Type of the coalesced events
+    uint64_t  count;
+    uint64_t  data_size;       // Sum of their data_size
+} EventAggregate;
+
+/// How published events of one type reach subscribers.
+typedef enum {
+    EVENT_SAMPLE_ALL = 0,      // Deliver every event (default)
+    EVENT_SAMPLE_EVERY_NTH,    // Deliver one event in `every`
+    EVENT_SAMPLE_RATE_LIMIT,   // Deliver at most `limit` per `interval_ms`
+    EVENT_SAMPLE_COALESCE      // Deliver one EVENT_AGGREGATE per `interval_ms`
+} EventSampleMode;
+
+typedef struct {
+    EventSampleMode mode;
+    uint64_t        every;
+    uint64_t        limit;
+    uint64_t        interval_ms;
+} EventPolicy;
+
 typedef void (*EventHandler)(const Event* event, void* user_data);
 
 typedef struct {
@@ -51,7 +77,25 @@ void event_bus_unsubscribe(int subscription_id);
 void event_bus_publish(const Event* event);
 
 /**
- * Clean up the event bus system
+ * Set the sampling policy for one event type (NULL restores
+ * EVENT_SAMPLE_ALL). Events already coalesced are flushed first.
+ * @return false for EVENT_AGGREGATE or an invalid policy
+ */
+bool event_bus_set_policy(EventType type, const EventPolicy* policy);
+
+/**
+ * Publish an EVENT_AGGREGATE for every type with coalesced events
+ * still pending
+ */
+void event_bus_flush(void);
+
+/**
+ * Events of `type` dropped by sampling or rate limiting so far
+ */
+uint64_t event_bus_suppressed(EventType type);
+
+/**
+ * Clean up the event bus system (flushes pending aggregates)
  */
 void event_bus_cleanup(void);
 
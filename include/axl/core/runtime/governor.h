@@ -0,0 +1,73 @@
+// include/axl/core/runtime/governor.h
+#ifndef AXL_GOVERNOR_H
+#define AXL_GOVERNOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Memory governor for BUST_CONDITIONAL retained objects (frozen DAGs,
+/// tries). Tracks their bytes and, when over budget, evicts the least
+/// recently used ones, publishing EVENT_DAG_NODE_BUSTED for each.
+typedef struct MemoryGovernor MemoryGovernor;
+
+/// Frees a tracked object on eviction.
+typedef void (*GovernorEvictFn)(void* object);
+
+/**
+ * Create a governor. `budget_bytes` of 0 means unlimited. With
+ * `use_rss`, the budget applies to the process RSS instead of the
+ * tracked total.
+ */
+MemoryGovernor* governor_create(size_t budget_bytes, bool use_rss);
+
+/**
+ * Process-wide governor (unlimited until a budget is set)
+ */
+MemoryGovernor* governor_shared(void);
+
+/**
+ * Change the budget and the RSS mode, then enforce it
+ */
+void governor_set_budget(MemoryGovernor* governor, size_t budget_bytes, bool use_rss);
+
+/**
+ * Hand ownership of `object` (about `bytes` large) to the governor.
+ * It counts as most recently used. Enforces the budget, which may
+ * evict older objects but never the one just tracked.
+ * @return false if it could not be tracked (caller still owns it)
+ */
+bool governor_track(MemoryGovernor* governor, void* object, size_t bytes,
+                    GovernorEvictFn evict);
+
+/**
+ * Mark a tracked object as used. Returns false if it has been evicted.
+ */
+bool governor_touch(MemoryGovernor* governor, const void* object);
+
+/**
+ * Stop tracking `object` without freeing it; ownership returns to the caller
+ */
+bool governor_release(MemoryGovernor* governor, const void* object);
+
+/**
+ * Evict least recently used objects until within budget.
+ * Returns the number evicted.
+ */
+size_t governor_enforce(MemoryGovernor* governor);
+
+/**
+ * Bytes currently held by tracked objects
+ */
+size_t governor_usage(MemoryGovernor* governor);
+
+/**
+ * Resident set size of this process from /proc/self/statm (0 if unavailable)
+ */
+size_t governor_rss_bytes(void);
+
+/**
+ * Free the governor and, through their evict functions, all tracked objects
+ */
+void governor_destroy(MemoryGovernor* governor);
+
+#endif // AXL_GOVERNOR_H
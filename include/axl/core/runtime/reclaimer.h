@@ -0,0 +1,52 @@
+// include/axl/core/runtime/reclaimer.h
+#ifndef AXL_RECLAIMER_H
+#define AXL_RECLAIMER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <axl/core/runtime/epoch.h>
+
+/// Background thread that frees retired objects once their epoch grace
+/// period has passed, keeping teardown off the caller's critical path.
+typedef struct Reclaimer Reclaimer;
+
+/**
+ * Start a reclaimer whose epoch domain has `max_readers` reader slots
+ */
+Reclaimer* reclaimer_create(size_t max_readers);
+
+/**
+ * Process-wide reclaimer, created on first use and never destroyed
+ */
+Reclaimer* reclaimer_shared(void);
+
+/**
+ * Epoch domain readers must pin while they may touch deferred objects
+ */
+EpochDomain* reclaimer_domain(Reclaimer* reclaimer);
+
+/**
+ * Hand `ptr` to the reclaimer thread; `free_fn(ptr)` runs there once
+ * no pinned reader can still see it. `ptr` must already be
+ * unreachable for new readers.
+ * @return false if the object could not be queued (caller still owns it)
+ */
+bool reclaimer_defer(Reclaimer* reclaimer, void* ptr, EpochFreeFn free_fn);
+
+/**
+ * Block until every object deferred so far has been freed
+ */
+void reclaimer_flush(Reclaimer* reclaimer);
+
+/**
+ * Number of objects deferred but not yet freed
+ */
+size_t reclaimer_pending(Reclaimer* reclaimer);
+
+/**
+ * Stop the thread, free everything still pending and the reclaimer.
+ * No reader may be active.
+ */
+void reclaimer_destroy(Reclaimer* reclaimer);
+
+#endif // AXL_RECLAIMER_H
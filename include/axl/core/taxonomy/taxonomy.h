@@ -1,6 +1,10 @@
 #ifndef AXL_TAXONOMY_H
 #define AXL_TAXONOMY_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <axl/core/token.h>     // For TokenType
+
 /// Taxonomy categories for verb-noun classification
 typedef enum TaxonomyCategory {
     TAXONOMY_NONE = 0,
@@ -16,4 +20,18 @@ typedef enum TaxonomyCategory {
     NOUN_MODIFIER     // Modifiers (adjectives, etc.)
 } TaxonomyCategory;
 
-#endif // AXL_TAXONOMY_H
\ No newline at end of file
+/// Classification of a keyword-shaped token.
+typedef struct TaxonomyEntry {
+    TokenType        type;         // LET, CONST, ASSIGN, etc.
+    TaxonomyCategory category;     // Verb–noun tag
+    float            weight;       // Semantic ranking weight
+} TaxonomyEntry;
+
+/// Classify `text[0..len)` against the generated keyword table
+/// (src/core/taxonomy/keywords.spec). One hash and one compare.
+/// Returns false if the text is not a known keyword.
+bool        taxonomy_classify(const char *text,
+                              size_t len,
+                              TaxonomyEntry *out);
+
+#endif // AXL_TAXONOMY_H
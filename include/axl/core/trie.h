@@ -4,37 +4,122 @@
 #include <stdbool.h>
 #include <regex.h>
 #include <axl/core/taxonomy.h>
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <regex.h>
 
+/// Lifecycle of a node's compiled regex.
+typedef enum {
+    TRIE_REGEX_PENDING = 0,          // Raw pattern only
+    TRIE_REGEX_COMPILING,            // One thread is compiling it
+    TRIE_REGEX_READY,                // `pattern` is usable
+    TRIE_REGEX_FAILED                // regcomp() rejected the pattern
+} TrieRegexState;
+
+/// Reader slots available for concurrent matching.
+#define AXL_TRIE_MAX_READERS 64
+
 /// A node in the regex-bound trie.
-/// Each node matches a regex pattern (e.g. "let|const").
+/// Each node matches a regex pattern (e.g. "let|const"). Nodes are
+/// immutable once published; trie_insert replaces them instead.
 typedef struct TrieNode {
     char           *pattern_str;     // Raw regex string
-    regex_t         pattern;         // Compiled regex
+    regex_t         pattern;         // Compiled regex, valid once READY
+    _Atomic int     regex_state;     // TrieRegexState; compiled on first match
+    atomic_size_t   match_count;     // Times this node was matched against
+    size_t          regex_bytes;     // Heap measured for `pattern` (AXL_MEM_REGEX)
     bool            terminal;        // Marks end of a token pattern
     float           weight;          // Semantic ranking weight
     TaxonomyCategory category;       // Verb–noun classification
-    struct TrieNode *children[256];  // ASCII-indexed child pointers
+    struct TrieNode *_Atomic children[256];  // ASCII-indexed; read via trie_child()
 } TrieNode;
 
-/// Allocate and compile a new trie node.
-/// pattern_str must outlive the node.
+/// Allocate a new trie node. The pattern is copied and compiled
+/// on first match, so invalid patterns are reported there.
 TrieNode*   trie_node_create(const char *pattern_str,
                              TaxonomyCategory cat,
                              float weight);
 
-/// Insert a pattern into the trie (recursively compiles sub-patterns).
+/// Insert a pattern, replacing the node it displaces. Safe against
+/// concurrent registered readers as long as there is one writer: the
+/// new node is published with a release store, and the replaced one
+/// (compiled regex included) is freed only after a grace period.
 void        trie_insert(TrieNode *root,
                         const char *pattern_str,
                         TaxonomyCategory cat,
                         float weight);
 
-/// Match `text[0..len)` against node->pattern.
+/// Child of `node` for byte `c`, or NULL. Pairs with trie_insert's
+/// publication, so the child is fully initialized when seen.
+TrieNode*   trie_child(const TrieNode *node, unsigned char c);
+
+/// Claim a reader slot for the calling thread (-1 if none left).
+int         trie_reader_register(void);
+
+/// Release a reader slot; the reader must not be inside a section.
+void        trie_reader_unregister(int reader);
+
+/// Bracket lookups and matches that may race with trie_insert. Nodes
+/// reached inside a section stay valid until trie_reader_exit().
+void        trie_reader_enter(int reader);
+void        trie_reader_exit(int reader);
+
+/// Free replaced nodes that no reader can still see; returns how many.
+/// trie_insert calls this itself; it never waits for readers.
+size_t      trie_reclaim(void);
+
+/// Match `text[0..len)` against node->pattern, compiling it first if needed.
 bool        trie_match_node(TrieNode *node,
                             const char *text,
                             size_t len);
 
+/// Longest match of node->pattern at the start of `text[0..len)`.
+/// Stores its length in *match_len; false if there is none.
+bool        trie_match_prefix(TrieNode *node,
+                              const char *text,
+                              size_t len,
+                              size_t *match_len);
+
+/// Compile node->pattern now if no thread has yet (safe to race).
+/// Returns false if the pattern is invalid.
+bool        trie_node_compile(TrieNode *node);
+
+/// Free a trie and all of its children. No reader may be active.
+void        trie_destroy(TrieNode *root);
+
+/// Approximate heap bytes held by a trie (nodes, patterns, compiled regexes).
+size_t      trie_memory_footprint(const TrieNode *root);
+
+/// Process-wide pattern counters.
+typedef struct {
+    size_t patterns_total;           // Nodes created
+    size_t patterns_compiled;        // Regexes compiled (lazily or ahead)
+    size_t patterns_used;            // Nodes matched against at least once
+    size_t compile_failures;
+} TrieStats;
+
+/// Snapshot of the pattern counters.
+TrieStats   trie_stats(void);
+
+/// Background compiler for the hottest patterns of a trie.
+typedef struct TriePrecompiler TriePrecompiler;
+
+/// Start compiling up to `max_patterns` nodes of `root` on a helper
+/// thread, most matched first, then by weight. The helper is an epoch
+/// reader, so trie_insert() may replace nodes meanwhile (a replaced node
+/// is compiled as its replacement); the trie must not be destroyed
+/// until trie_precompile_join() returns.
+TriePrecompiler* trie_precompile_start(TrieNode *root, size_t max_patterns);
+
+/// Like trie_precompile_start() for standalone nodes, such as the array
+/// returned by trie_load_pattern_file(). The nodes must outlive the join.
+TriePrecompiler* trie_precompile_patterns(TrieNode *const *patterns, size_t count,
+                                          size_t max_patterns);
+
+/// Wait for the helper thread; returns how many patterns it compiled.
+size_t      trie_precompile_join(TriePrecompiler *precompiler);
+
 /// Initialize the trie subsystem
 int         trie_init(void);
 
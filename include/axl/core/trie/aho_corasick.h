@@ -0,0 +1,72 @@
+// include/axl/core/trie/aho_corasick.h
+#ifndef AXL_AHO_CORASICK_H
+#define AXL_AHO_CORASICK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <axl/core/trie.h>
+#include <axl/core/taxonomy.h>
+
+/// A single keyword occurrence reported by ac_scan().
+typedef struct AcMatch {
+    size_t           start;        // Byte offset of the first character
+    size_t           length;       // Keyword length in bytes
+    TaxonomyCategory category;     // Verb–noun classification
+    float            weight;       // Semantic ranking weight
+    const TrieNode  *source;       // Originating trie node, or NULL
+} AcMatch;
+
+/// Aho-Corasick automaton over literal keywords.
+typedef struct AcAutomaton AcAutomaton;
+
+/// Called once per match; return false to stop the scan early.
+typedef bool (*AcMatchHandler)(const AcMatch *match, void *user_data);
+
+/**
+ * Create an empty automaton
+ */
+AcAutomaton* ac_create(void);
+
+/**
+ * Add a literal keyword. Must be called before ac_compile().
+ */
+bool ac_add_keyword(AcAutomaton *ac,
+                    const char *keyword,
+                    size_t len,
+                    TaxonomyCategory cat,
+                    float weight,
+                    const TrieNode *source);
+
+/**
+ * Add the literal-keyword subset of a trie's patterns.
+ * Plain literals and alternations of literals (e.g. "let|const", "\+|-")
+ * are added; patterns using any other regex construct, an escape of a
+ * non-special character (GNU operators such as \b or \w) or an empty
+ * alternative are skipped.
+ * Returns the number of keywords added.
+ */
+size_t ac_add_trie(AcAutomaton *ac, const TrieNode *root);
+
+/**
+ * Build failure and output links. The automaton is read-only afterwards
+ * and may be scanned from several threads at once.
+ */
+bool ac_compile(AcAutomaton *ac);
+
+/**
+ * Scan `text[0..len)` in one pass, reporting every (possibly overlapping)
+ * match ordered by end offset, longest first for a shared end.
+ * Returns the number of matches reported.
+ */
+size_t ac_scan(const AcAutomaton *ac,
+               const char *text,
+               size_t len,
+               AcMatchHandler handler,
+               void *user_data);
+
+/**
+ * Destroy the automaton and free resources
+ */
+void ac_destroy(AcAutomaton *ac);
+
+#endif // AXL_AHO_CORASICK_H
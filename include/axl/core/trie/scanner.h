@@ -0,0 +1,49 @@
+// include/axl/core/trie/scanner.h
+#ifndef AXL_TRIE_SCANNER_H
+#define AXL_TRIE_SCANNER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <axl/core/trie.h>
+
+/// One entry of a pattern file (see src/core/trie/patterns.spec).
+typedef struct TrieScanPattern {
+    const char      *pattern;
+    TaxonomyCategory category;
+    float            weight;
+} TrieScanPattern;
+
+/// Longest pattern match at the start of the scanned text.
+typedef struct TrieScanMatch {
+    size_t           length;
+    uint32_t         pattern;      // Index in pattern file order
+    TaxonomyCategory category;
+    float            weight;
+} TrieScanMatch;
+
+/// Patterns compiled into the generated scanner, in file order.
+extern const TrieScanPattern trie_scan_patterns[];
+extern const size_t          trie_scan_pattern_count;
+
+/**
+ * Longest match of the built-in pattern set at text[0..len), using the
+ * state machine generated from patterns.spec at build time (no regex).
+ * Earlier patterns win ties. Returns false if nothing matches.
+ */
+bool trie_scan_generated(const char *text, size_t len, TrieScanMatch *out);
+
+/**
+ * Load a pattern file as one trie node per pattern, in file order.
+ * Regexes compile lazily on first match. Returns a malloc'd array
+ * (free each node with trie_destroy), or NULL on error.
+ */
+TrieNode** trie_load_pattern_file(const char *path, size_t *count);
+
+/**
+ * Interpreted counterpart of trie_scan_generated over loaded patterns
+ */
+bool trie_scan_interpreted(TrieNode *const *patterns, size_t count,
+                           const char *text, size_t len, TrieScanMatch *out);
+
+#endif // AXL_TRIE_SCANNER_H
@@ -0,0 +1,67 @@
+// include/axl/core/utils/corpus.h
+#ifndef AXL_CORPUS_H
+#define AXL_CORPUS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Default number of files in flight (and pooled buffers).
+#define AXL_CORPUS_DEFAULT_DEPTH   64
+
+/// Size of each pooled buffer; larger files get a dedicated one.
+#define AXL_CORPUS_BUFFER_SIZE     (64u * 1024u)
+
+/// Asynchronous loader for a list of files. Opens and reads are
+/// submitted in batches through io_uring where the kernel allows it,
+/// otherwise a thread pool issues blocking pread() calls. Files are
+/// handed out in completion order, not list order.
+typedef struct AxlCorpusLoader AxlCorpusLoader;
+
+typedef struct AxlCorpusOptions {
+    size_t depth;              // Files in flight (0 = default)
+    size_t threads;            // pread fallback threads (0 = depth / 4)
+    bool   force_pread;        // Skip io_uring
+} AxlCorpusOptions;
+
+/// One loaded file. `data` is NUL-terminated and owned by the loader
+/// until axl_corpus_release().
+typedef struct AxlLoadedFile {
+    size_t      index;         // Position in the path list
+    const char *path;
+    const char *data;          // NULL if the file could not be read
+    size_t      size;
+    int         error;         // errno of the failure, 0 on success
+    size_t      slot;          // Pool slot, for axl_corpus_release()
+} AxlLoadedFile;
+
+/**
+ * Start loading `paths` in the background. The path strings must
+ * outlive the loader. `options` may be NULL.
+ */
+AxlCorpusLoader* axl_corpus_open(const char *const *paths, size_t count,
+                                 const AxlCorpusOptions *options);
+
+/**
+ * Wait for the next completed file. Safe to call from several parsing
+ * threads. Returns false once every file has been handed out.
+ */
+bool axl_corpus_next(AxlCorpusLoader *loader, AxlLoadedFile *file);
+
+/**
+ * Return a file's buffer to the pool so further reads can proceed.
+ * Loading stalls once `depth` files are held unreleased.
+ */
+void axl_corpus_release(AxlCorpusLoader *loader, AxlLoadedFile *file);
+
+/**
+ * "io_uring" or "pread"
+ */
+const char* axl_corpus_backend(const AxlCorpusLoader *loader);
+
+/**
+ * Stop loading, wait for outstanding I/O and free everything,
+ * including buffers not yet released
+ */
+void axl_corpus_close(AxlCorpusLoader *loader);
+
+#endif // AXL_CORPUS_H
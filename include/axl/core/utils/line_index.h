@@ -0,0 +1,40 @@
+// include/axl/core/utils/line_index.h
+#ifndef AXL_LINE_INDEX_H
+#define AXL_LINE_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Byte offset of the start of every line in a source buffer. Tokens
+/// keep only offsets; line and column are looked up from this index
+/// when a diagnostic or trace actually needs them.
+typedef struct AxlLineIndex {
+    size_t *starts;            // starts[0] == 0, ascending
+    size_t  count;             // Number of lines
+    size_t  size;              // Source size the index was built for
+} AxlLineIndex;
+
+/// 1-based line and byte column of an offset.
+typedef struct AxlLinePosition {
+    size_t line;
+    size_t column;
+} AxlLinePosition;
+
+/**
+ * Index the newlines of `data[0..size)`. Uses a vectorized scan
+ * (AVX2 or SSE2 where available). Returns false if out of memory.
+ */
+bool axl_line_index_build(const char *data, size_t size, AxlLineIndex *index);
+
+/**
+ * Line and column of `offset` by binary search; offsets past the end
+ * clamp to the end of the source
+ */
+AxlLinePosition axl_line_index_lookup(const AxlLineIndex *index, size_t offset);
+
+/**
+ * Free the index
+ */
+void axl_line_index_free(AxlLineIndex *index);
+
+#endif // AXL_LINE_INDEX_H
@@ -0,0 +1,71 @@
+// include/axl/core/utils/memory.h
+#ifndef AXL_MEMORY_H
+#define AXL_MEMORY_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+/// Subsystem an allocation is charged to.
+typedef enum {
+    AXL_MEM_TRIE = 0,          // Trie nodes and pattern strings
+    AXL_MEM_REGEX,             // Compiled regex state (measured, see below)
+    AXL_MEM_DAG_NODE,
+    AXL_MEM_DAG_EDGE,          // In/out edge arrays
+    AXL_MEM_CSR,               // Frozen DAG blocks
+    AXL_MEM_AXML,              // Parsed and compacted configuration
+    AXL_MEM_TAG_COUNT
+} AxlMemTag;
+
+/// Accounting for one tag. `peak` is exact for a single thread and
+/// approximate (per-thread batching) when several threads allocate.
+typedef struct AxlMemStats {
+    size_t current;            // Bytes live now
+    size_t peak;               // High-water mark of `current`
+    size_t allocations;        // Successful allocation calls
+    size_t frees;
+} AxlMemStats;
+
+/**
+ * Tagged replacements for malloc/calloc/realloc/strdup. Memory from
+ * these must be released with axl_free(), never free().
+ */
+void*       axl_malloc(size_t size, AxlMemTag tag);
+void*       axl_calloc(size_t count, size_t size, AxlMemTag tag);
+
+/**
+ * Resize a tagged block. A NULL `ptr` allocates; the block keeps the
+ * tag it was allocated with.
+ */
+void*       axl_realloc(void *ptr, size_t size, AxlMemTag tag);
+char*       axl_strdup(const char *s, AxlMemTag tag);
+void        axl_free(void *ptr);
+
+/**
+ * Charge (or with negative `bytes`, credit) memory allocated outside
+ * this layer, such as regcomp()'s internal state
+ */
+void        axl_mem_account(AxlMemTag tag, ptrdiff_t bytes);
+
+/**
+ * Bytes the C heap has handed out (glibc mallinfo2), or 0 where the
+ * allocator cannot report it. Used to measure third-party allocations.
+ */
+size_t      axl_mem_heap_in_use(void);
+
+/**
+ * Publish the calling thread's pending counts. Threads flush on exit.
+ */
+void        axl_mem_flush(void);
+
+/**
+ * Totals for one tag (flushes the calling thread first)
+ */
+AxlMemStats axl_mem_stats(AxlMemTag tag);
+
+/**
+ * Short name of a tag for reports
+ */
+const char* axl_mem_tag_name(AxlMemTag tag);
+
+#endif // AXL_MEMORY_H
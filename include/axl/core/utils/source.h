@@ -0,0 +1,49 @@
+// include/axl/core/utils/source.h
+#ifndef AXL_SOURCE_H
+#define AXL_SOURCE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <axl/core/utils/line_index.h>
+
+/// Read-only view of an AXL source file.
+/// Regular files are memory-mapped; pipes and other non-seekable inputs
+/// fall back to a heap buffer. `data` is NOT NUL-terminated.
+typedef struct AxlSource {
+    const char *data;
+    size_t      size;
+    bool        mapped;      // true if `data` is an mmap region
+    bool        borrowed;    // true if the caller owns `data`
+    AxlLineIndex *lines;     // Built by the first axl_source_position()
+} AxlSource;
+
+/**
+ * Open and map a source file. Returns false on any I/O error.
+ */
+bool axl_source_open(const char *path, AxlSource *source);
+
+/**
+ * Load a source from an already open descriptor (e.g. stdin).
+ * The descriptor is not closed.
+ */
+bool axl_source_open_fd(int fd, AxlSource *source);
+
+/**
+ * View a buffer the caller owns and keeps alive as a source, so it gets
+ * the same lazy line index. Closing it frees only the index.
+ */
+void axl_source_borrow(const char *data, size_t size, AxlSource *source);
+
+/**
+ * Line and column of a byte offset. The line index is built on the
+ * first call, so sources that never report a position never pay for it.
+ * @return false if the index cannot be allocated
+ */
+bool axl_source_position(AxlSource *source, size_t offset, AxlLinePosition *position);
+
+/**
+ * Unmap or free the source buffer and its line index
+ */
+void axl_source_close(AxlSource *source);
+
+#endif // AXL_SOURCE_H
@@ -5,6 +5,18 @@
 #include <time.h>     // For clock() and CLOCKS_PER_SEC
 #include <stdbool.h>  // For boolean type support
 #include <axl/core/integration/trie_dag.h>
+#include <axl/core/integration/estimate.h>
+#include <axl/core/integration/semantic.h>
+#include <axl/core/runtime/cache.h>
+#include <axl/core/runtime/governor.h>
+#include <axl/core/trie.h>
+#include <axl/core/trie/scanner.h>
+#include <axl/core/utils/memory.h>
+#include <axl/core/utils/source.h>
+#include "server.h"
+
+// Artifacts kept warm by a compile server (files, not requests)
+#define AXL_SERVER_CACHE_ENTRIES 64
 
 // Command-line options
 typedef struct {
@@ -18,21 +30,56 @@ typedef struct {
     bool use_stdin;     // Read AXL from stdin
     bool use_stdout;    // Write output to stdout
     bool collect_events; // Enable event collection
+    const char** input_paths;   // Every -i path; more than one runs a batch
+    size_t input_count;
+    const char** variant_paths; // Additional AXML configs for what-if mode
+    size_t variant_count;
+    bool watch_mode;    // Re-apply the AXML config whenever it changes
+    bool show_help;
+    size_t memory_budget;   // Budget for retained DAGs, 0 = unlimited
+    bool budget_rss;        // Apply the budget to process RSS
+    size_t lex_threads;     // Lexer threads, 0 = all cores
+    const char* patterns_path; // Pattern file for the interpreted scanner
+    AxlFreezeOrder freeze_order; // Node layout of frozen DAGs
 } CliOptions;
 
 void print_usage(const char* program_name) {
     printf("Usage: %s [options]\n", program_name);
     printf("Options:\n");
     printf("  -c, --config <path>    Path to AXML configuration file\n");
-    printf("  -i, --input <path>     Path to AXL input file\n");
+    printf("  -i, --input <path>     Path to AXL input file (repeatable for a batch)\n");
+    printf("  --variant <path>       Also evaluate under this AXML config (repeatable)\n");
+    printf("  --watch                Re-apply the AXML config whenever it changes\n");
     printf("  --preview              Preview DAG before execution\n");
     printf("  --dry-run              Simulate execution without state changes\n");
     printf("  --retain               Override bust policy to retain memory\n");
     printf("  --trace                Enable DAG traversal debug output\n");
     printf("  --profile              Print memory and execution metrics\n");
+    printf("  --memory-budget <size> Evict retained DAGs beyond this many bytes (K/M/G)\n");
+    printf("  --budget-rss           Apply the memory budget to process RSS\n");
+    printf("  --lex-threads <n>      Lex large inputs with n threads (0 = all cores)\n");
+    printf("  --patterns <path>      Scan tokens with this pattern file's regexes\n");
+    printf("  --reorder <topo|rcm>   Lay frozen DAGs out level by level or in RCM order\n");
+    printf("  --serve <socket>       Run as a compile server with warm caches\n");
+    printf("  --connect <socket>     Forward this command to a compile server\n");
     printf("  -h, --help             Display this help message\n");
 }
 
+// Parse "512", "64K", "200M" or "2G" into bytes (0 on error)
+static size_t parse_size(const char* text) {
+    char* end = NULL;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text) return 0;
+    
+    switch (*end) {
+        case 'k': case 'K': value <<= 10; end++; break;
+        case 'm': case 'M': value <<= 20; end++; break;
+        case 'g': case 'G': value <<= 30; end++; break;
+        default: break;
+    }
+    return *end == '\0' ? (size_t)value : 0;
+}
+
 CliOptions parse_cli_args(int argc, char** argv) {
     CliOptions options = {0};
     
@@ -51,11 +98,57 @@ else if (strcmp(argv[i], "--stdout") == 0) {
 }
 else if (strcmp(argv[i], "--collect-events") == 0) {
     options.collect_events = true;
+}
+else if (strcmp(argv[i], "--variant") == 0) {
+    if (i + 1 < argc) {
+        if (!options.variant_paths) {
+            options.variant_paths = (const char**)calloc((size_t)argc, sizeof(const char*));
+        }
+        if (options.variant_paths) {
+            options.variant_paths[options.variant_count++] = argv[++i];
+        }
+    }
 }
  else if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--input") == 0) {
             if (i + 1 < argc) {
-                options.axl_path = argv[++i];
+                if (!options.input_paths) {
+                    options.input_paths = (const char**)calloc((size_t)argc, sizeof(const char*));
+                }
+                if (options.input_paths) {
+                    options.input_paths[options.input_count++] = argv[i + 1];
+                }
+                if (!options.axl_path) {
+                    options.axl_path = argv[i + 1];
+                }
+                i++;
+            }
+        } else if (strcmp(argv[i], "--memory-budget") == 0) {
+            if (i + 1 < argc) {
+                options.memory_budget = parse_size(argv[++i]);
             }
+        } else if (strcmp(argv[i], "--budget-rss") == 0) {
+            options.budget_rss = true;
+        } else if (strcmp(argv[i], "--lex-threads") == 0) {
+            if (i + 1 < argc) {
+                options.lex_threads = (size_t)strtoul(argv[++i], NULL, 10);
+            }
+        } else if (strcmp(argv[i], "--patterns") == 0) {
+            if (i + 1 < argc) {
+                options.patterns_path = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--reorder") == 0) {
+            if (i + 1 < argc) {
+                const char* order = argv[++i];
+                if (strcmp(order, "topo") == 0) {
+                    options.freeze_order = AXL_FREEZE_ORDER_TOPOLOGICAL;
+                } else if (strcmp(order, "rcm") == 0) {
+                    options.freeze_order = AXL_FREEZE_ORDER_RCM;
+                } else {
+                    fprintf(stderr, "Warning: unknown --reorder '%s', keeping build order\n", order);
+                }
+            }
+        } else if (strcmp(argv[i], "--watch") == 0) {
+            options.watch_mode = true;
         } else if (strcmp(argv[i], "--preview") == 0) {
             options.preview_mode = true;
         } else if (strcmp(argv[i], "--dry-run") == 0) {
@@ -67,29 +160,187 @@ else if (strcmp(argv[i], "--collect-events") == 0) {
         } else if (strcmp(argv[i], "--profile") == 0) {
             options.profile_enabled = true;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-            print_usage(argv[0]);
-            exit(0);
+            options.show_help = true;
         }
     }
     
     return options;
 }
 
-int main(int argc, char** argv) {
+// Per-subsystem allocation accounting from the tagged allocator;
+// subsystems this run never allocated from are left out
+static void print_memory_profile(void) {
+    printf("Memory by subsystem:\n");
+    printf("  %-10s %14s %14s %12s %12s\n", "tag", "current", "peak", "allocs", "frees");
+    for (int tag = 0; tag < AXL_MEM_TAG_COUNT; tag++) {
+        AxlMemStats stats = axl_mem_stats((AxlMemTag)tag);
+        if (stats.allocations == 0) continue;
+        printf("  %-10s %14zu %14zu %12zu %12zu\n", axl_mem_tag_name((AxlMemTag)tag),
+               stats.current, stats.peak, stats.allocations, stats.frees);
+    }
+}
+
+// Lexing runs on many threads, so it is timed by wall clock
+static void print_lex_profile(const char* path) {
+    AxlSource source;
+    if (!axl_source_open(path, &source)) return;
+    
+    struct timespec begin, end;
+    AxlSemanticTokens tokens;
+    size_t threads = axl_semantic_lex_threads(source.size);
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    bool lexed = axl_semantic_lex(source.data, source.size, threads, &tokens);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    
+    if (lexed) {
+        double elapsed = (double)(end.tv_sec - begin.tv_sec) * 1000.0 +
+                         (double)(end.tv_nsec - begin.tv_nsec) / 1e6;
+        printf("Lexing: %zu tokens in %.3f ms (%zu thread%s)\n", tokens.count, elapsed,
+               threads, threads == 1 ? "" : "s");
+        axl_semantic_tokens_free(&tokens);
+    }
+    axl_source_close(&source);
+}
+
+// Token patterns loaded by --patterns for the interpreted scanner
+typedef struct {
+    TrieNode** patterns;
+    size_t count;
+    TriePrecompiler* precompiler;
+} CliPatterns;
+
+static void patterns_free(void* ptr) {
+    CliPatterns* loaded = (CliPatterns*)ptr;
+    if (!loaded) return;
+    
+    trie_precompile_join(loaded->precompiler);
+    for (size_t i = 0; i < loaded->count; i++) {
+        trie_destroy(loaded->patterns[i]);
+    }
+    free(loaded->patterns);
+    free(loaded);
+}
+
+// Load a pattern file, or take it with its compiled regexes from the
+// server's cache, and scan with it; `cached` says who owns the result
+static CliPatterns* load_patterns(const char* path, AxlCache* cache, bool* cached) {
+    AxlCacheStamp stamp;
+    CliPatterns* loaded = cache ? axl_cache_get(cache, AXL_CACHE_PATTERNS, path, &stamp) : NULL;
+    *cached = loaded != NULL;
+    
+    if (!loaded) {
+        loaded = (CliPatterns*)calloc(1, sizeof(CliPatterns));
+        if (!loaded) return NULL;
+        loaded->patterns = trie_load_pattern_file(path, &loaded->count);
+        if (!loaded->patterns) {
+            free(loaded);
+            return NULL;
+        }
+        
+        // Regexes compile on first use; the helper compiles the rest meanwhile
+        loaded->precompiler = trie_precompile_patterns(loaded->patterns, loaded->count,
+                                                       loaded->count);
+        *cached = cache && axl_cache_put(cache, AXL_CACHE_PATTERNS, &stamp, loaded, patterns_free);
+    }
+    
+    axl_semantic_set_patterns(loaded->patterns, loaded->count);
+    return loaded;
+}
+
+static void unload_patterns(CliPatterns* loaded, bool cached) {
+    axl_semantic_set_patterns(NULL, 0);
+    if (!cached) patterns_free(loaded);
+}
+
+static void print_estimate(const AxlCostEstimate* estimate) {
+    printf("DAG estimate:\n");
+    printf("  Statements:      %zu\n", estimate->statements);
+    printf("  Nodes:           %zu", estimate->nodes);
+    if (estimate->hash_cons) {
+        printf(" (%zu after hash-consing)", estimate->shared_nodes);
+    }
+    printf("\n");
+    printf("  Edges:           %zu\n", estimate->edges);
+    printf("  Max depth:       %zu\n", estimate->max_depth);
+    printf("  Bindings:        %zu\n", estimate->bindings);
+    printf("  Peak DAG memory: %zu bytes\n", estimate->dag_bytes);
+    printf("  Retained memory: %zu bytes\n", estimate->retained_bytes);
+    printf("  Resolve work:    %zu visits\n", estimate->resolve_work);
+}
+
+// Run one command line; `user_data` is the server's warm cache, if any
+static int run_cli(int argc, char** argv, void* user_data) {
+    AxlCache* cache = (AxlCache*)user_data;
+    
     // Parse command-line arguments
     CliOptions options = parse_cli_args(argc, argv);
+    if (options.show_help) {
+        print_usage(argv[0]);
+        free(options.variant_paths);
+        free(options.input_paths);
+        return 0;
+    }
     
     // Validate required arguments
     if (!options.axml_path || !options.axl_path) {
         fprintf(stderr, "Error: Both AXML configuration and AXL input files are required\n");
         print_usage(argv[0]);
+        free(options.variant_paths);
+        free(options.input_paths);
         return 1;
     }
     
     // Print header
     printf("AXL Compiler v0.1.0 - OBINexus Aegis Project\n");
     printf("Configuration: %s\n", options.axml_path);
-    printf("Input: %s\n", options.axl_path);
+    if (options.input_count > 1) {
+        printf("Input: %zu files\n", options.input_count);
+    } else {
+        printf("Input: %s\n", options.axl_path);
+    }
+    
+    AxlExecutionOverrides overrides = {
+        .retain_memory = options.retain_memory,
+        .memory_budget = options.memory_budget,
+        .budget_rss = options.budget_rss
+    };
+    axl_set_execution_overrides(&overrides);
+    axl_semantic_set_lex_threads(options.lex_threads);
+    axl_semantic_set_freeze_order(options.freeze_order);
+    if (options.budget_rss && options.memory_budget == 0) {
+        fprintf(stderr, "Warning: --budget-rss has no effect without --memory-budget\n");
+    }
+    
+    CliPatterns* patterns = NULL;
+    bool patterns_cached = false;
+    if (options.patterns_path &&
+        !(patterns = load_patterns(options.patterns_path, cache, &patterns_cached))) {
+        fprintf(stderr, "Error: Could not load patterns from %s\n", options.patterns_path);
+        free(options.variant_paths);
+        free(options.input_paths);
+        return 1;
+    }
+    
+    // Predict DAG size from a token scan before committing to a build
+    if (options.preview_mode || options.dry_run) {
+        AxlCostEstimate estimate;
+        if (!axl_estimate_cost(options.axl_path, options.axml_path, &estimate)) {
+            fprintf(stderr, "Error: Could not estimate cost for %s\n", options.axl_path);
+            unload_patterns(patterns, patterns_cached);
+            free(options.variant_paths);
+            free(options.input_paths);
+            return 1;
+        }
+        print_estimate(&estimate);
+        
+        if (options.dry_run) {
+            printf("Dry run: execution skipped\n");
+            unload_patterns(patterns, patterns_cached);
+            free(options.variant_paths);
+            free(options.input_paths);
+            return 0;
+        }
+    }
     
     // Profile start time if enabled
     clock_t start_time = 0;
@@ -97,16 +348,88 @@ int main(int argc, char** argv) {
         start_time = clock();
     }
     
-    // Execute with busting
-    bool result = execute_axl_with_busting(options.axl_path, options.axml_path);
+    // Execute with busting; with variants, share one DAG across all configs
+    bool result;
+    if (options.variant_count > 0) {
+        size_t count = options.variant_count + 1;
+        const char** paths = (const char**)malloc(count * sizeof(const char*));
+        bool* results = (bool*)calloc(count, sizeof(bool));
+        
+        result = paths && results;
+        if (result) {
+            paths[0] = options.axml_path;
+            memcpy(paths + 1, options.variant_paths, options.variant_count * sizeof(const char*));
+            result = execute_axl_variants(options.axl_path, paths, count, results);
+        }
+        
+        bool built = result;
+        for (size_t i = 0; built && i < count; i++) {
+            printf("Variant %zu (%s): %s\n", i, paths[i], results[i] ? "success" : "failed");
+            result = result && results[i];
+        }
+        
+        free(paths);
+        free(results);
+    } else if (options.input_count > 1) {
+        bool* results = (bool*)calloc(options.input_count, sizeof(bool));
+        
+        result = results && execute_axl_batch(options.input_paths, options.input_count,
+                                              options.axml_path, results);
+        for (size_t i = 0; result && i < options.input_count; i++) {
+            if (!results[i]) {
+                fprintf(stderr, "Input %s: failed\n", options.input_paths[i]);
+            }
+        }
+        for (size_t i = 0; results && i < options.input_count; i++) {
+            result = result && results[i];
+        }
+        
+        free(results);
+    } else if (options.watch_mode) {
+        result = watch_axl_with_busting(options.axl_path, options.axml_path);
+    } else if (cache) {
+        result = execute_axl_cached(cache, options.axl_path, options.axml_path);
+    } else {
+        result = execute_axl_with_busting(options.axl_path, options.axml_path);
+    }
+    
+    // The counters below are final once the helper has finished
+    size_t precompiled = 0;
+    if (patterns) {
+        precompiled = trie_precompile_join(patterns->precompiler);
+        patterns->precompiler = NULL;
+    }
     
     // Profile end time if enabled
     if (options.profile_enabled) {
         clock_t end_time = clock();
         double execution_time = (double)(end_time - start_time) / CLOCKS_PER_SEC * 1000.0;
         printf("Execution time: %.3f ms\n", execution_time);
+        
+        // Only --patterns scans with tries; the generated DFA has no counters
+        TrieStats stats = trie_stats();
+        if (patterns) {
+            printf("Patterns: %zu used, %zu compiled (%zu ahead of use), %zu loaded\n",
+                   stats.patterns_used, stats.patterns_compiled, precompiled, stats.patterns_total);
+        }
+        printf("Retained memory: %zu bytes (RSS %zu bytes)\n",
+               governor_usage(governor_shared()), governor_rss_bytes());
+        if (cache) {
+            AxlCacheStats stats = axl_cache_stats(cache);
+            printf("Server cache: %zu entries, %zu hits, %zu misses\n",
+                   stats.entries, stats.hits, stats.misses);
+        }
+        print_lex_profile(options.axl_path);
+        print_memory_profile();
     }
     
+    unload_patterns(patterns, patterns_cached);
+    free(options.variant_paths);
+    free(options.input_paths);
+    
+    // Nothing looked up is held any more
+    axl_cache_trim(cache);
+    
     // Print result
     if (result) {
         printf("Execution completed successfully\n");
@@ -116,4 +439,40 @@ int main(int argc, char** argv) {
     }
     
     return 0;
-}
\ No newline at end of file
+}
+int main(int argc, char** argv) {
+    // Server/client options are handled here and never forwarded
+    const char* serve_path = NULL;
+    const char* connect_path = NULL;
+    char** args = (char**)calloc((size_t)argc + 1, sizeof(char*));
+    if (!args) return 1;
+    
+    int count = 0;
+    for (int i = 0; i < argc; i++) {
+        if (i > 0 && i + 1 < argc && strcmp(argv[i], "--serve") == 0) {
+            serve_path = argv[++i];
+        } else if (i > 0 && i + 1 < argc && strcmp(argv[i], "--connect") == 0) {
+            connect_path = argv[++i];
+        } else {
+            args[count++] = argv[i];
+        }
+    }
+    
+    int status;
+    if (serve_path) {
+        AxlCache* cache = axl_cache_create(AXL_SERVER_CACHE_ENTRIES);
+        status = cache ? axl_serve(serve_path, run_cli, cache) : 1;
+        axl_cache_destroy(cache);
+    } else if (connect_path) {
+        status = axl_connect(connect_path, count, args);
+        if (status < 0) {
+            fprintf(stderr, "Warning: No compile server at %s, running locally\n", connect_path);
+            status = run_cli(count, args, NULL);
+        }
+    } else {
+        status = run_cli(count, args, NULL);
+    }
+    
+    free(args);
+    return status;
+}
@@ -0,0 +1,321 @@
+// src/cli/server.c
+#include "server.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Wire format: one RequestHeader carrying the client's stdin/stdout/stderr
+// as SCM_RIGHTS, then `size` bytes of NUL-terminated strings (working
+// directory first, then argv). The server answers with an int32 status.
+#define AXL_SERVER_MAGIC     0x41584c31u   // "AXL1"
+#define AXL_SERVER_FD_COUNT  3
+#define AXL_SERVER_MAX_REQUEST (1u << 20)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t argc;
+    uint32_t size;
+} RequestHeader;
+
+static volatile sig_atomic_t server_stopping = 0;
+
+static void handle_stop_signal(int sig) {
+    (void)sig;
+    server_stopping = 1;
+}
+
+static bool write_all(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void* data, size_t size) {
+    char* p = (char*)data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool make_address(const char* socket_path, struct sockaddr_un* addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr->sun_path)) {
+        fprintf(stderr, "Error: Socket path too long: %s\n", socket_path);
+        return false;
+    }
+    strcpy(addr->sun_path, socket_path);
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Server
+ * ------------------------------------------------------------------------- */
+
+/// Receive the header and the client's standard stream descriptors.
+static bool receive_header(int conn, RequestHeader* header, int fds[AXL_SERVER_FD_COUNT]) {
+    union {
+        char buf[CMSG_SPACE(AXL_SERVER_FD_COUNT * sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = { header, sizeof(*header) };
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    ssize_t n;
+    do {
+        n = recvmsg(conn, &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    bool have_fds = cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+                    cmsg->cmsg_len == CMSG_LEN(AXL_SERVER_FD_COUNT * sizeof(int));
+    if (have_fds) {
+        memcpy(fds, CMSG_DATA(cmsg), AXL_SERVER_FD_COUNT * sizeof(int));
+    } else if (cmsg && cmsg->cmsg_type == SCM_RIGHTS) {
+        // Unexpected descriptor count: close whatever arrived
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; i++) {
+            int fd;
+            memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            close(fd);
+        }
+    }
+
+    if (n != (ssize_t)sizeof(*header) || !have_fds ||
+        header->magic != AXL_SERVER_MAGIC || header->size > AXL_SERVER_MAX_REQUEST ||
+        header->argc == 0) {
+        if (have_fds) {
+            for (int i = 0; i < AXL_SERVER_FD_COUNT; i++) close(fds[i]);
+        }
+        return false;
+    }
+    return true;
+}
+
+/// Run one request with the client's streams and working directory.
+static int serve_request(int conn, AxlRequestHandler handler, void* user_data) {
+    RequestHeader header;
+    int fds[AXL_SERVER_FD_COUNT];
+    if (!receive_header(conn, &header, fds)) return -1;
+
+    int status = -1;
+    char* payload = (char*)malloc(header.size + 1);
+    char** argv = (char**)calloc(header.argc + 1, sizeof(char*));
+    if (!payload || !argv || !read_all(conn, payload, header.size)) {
+        goto done;
+    }
+    payload[header.size] = '\0';
+
+    // Split into cwd + argv; reject anything malformed
+    char* p = payload;
+    char* end = payload + header.size;
+    char* cwd = p;
+    p += strlen(p) + 1;
+    for (uint32_t i = 0; i < header.argc; i++) {
+        if (p >= end) goto done;
+        argv[i] = p;
+        p += strlen(p) + 1;
+    }
+
+    // A watch never returns, so it would hold the server forever
+    for (uint32_t i = 0; i < header.argc; i++) {
+        if (strcmp(argv[i], "--watch") == 0) {
+            dprintf(fds[2], "Error: --watch cannot run on a compile server; run it without --connect\n");
+            status = 1;
+            goto done;
+        }
+    }
+
+    int saved_cwd = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (saved_cwd < 0 || chdir(cwd) != 0) {
+        if (saved_cwd >= 0) close(saved_cwd);
+        dprintf(fds[2], "Error: Server cannot enter directory: %s\n", cwd);
+        status = 1;
+        goto done;
+    }
+
+    // Requests run one at a time, so the process-wide streams can be lent out
+    fflush(stdout);
+    fflush(stderr);
+    int saved[AXL_SERVER_FD_COUNT];
+    for (int i = 0; i < AXL_SERVER_FD_COUNT; i++) {
+        saved[i] = dup(i);
+        dup2(fds[i], i);
+    }
+    clearerr(stdin);
+
+    status = handler((int)header.argc, argv, user_data);
+
+    fflush(stdout);
+    fflush(stderr);
+    for (int i = 0; i < AXL_SERVER_FD_COUNT; i++) {
+        if (saved[i] >= 0) {
+            dup2(saved[i], i);
+            close(saved[i]);
+        }
+    }
+    clearerr(stdin);
+
+    if (fchdir(saved_cwd) != 0) {
+        fprintf(stderr, "Warning: Server could not restore its working directory\n");
+    }
+    close(saved_cwd);
+
+done:
+    free(argv);
+    free(payload);
+    for (int i = 0; i < AXL_SERVER_FD_COUNT; i++) close(fds[i]);
+    return status;
+}
+
+int axl_serve(const char* socket_path, AxlRequestHandler handler, void* user_data) {
+    struct sockaddr_un addr;
+    if (!socket_path || !handler || !make_address(socket_path, &addr)) return 1;
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    // A stale socket file from a crashed server would block bind()
+    unlink(socket_path);
+    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 16) != 0) {
+        perror(socket_path);
+        close(listener);
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);      // No SA_RESTART: accept() must return
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);              // Clients may disappear mid-request
+
+    printf("AXL compile server listening on %s\n", socket_path);
+    fflush(stdout);
+
+    while (!server_stopping) {
+        int conn = accept(listener, NULL, NULL);
+        if (conn < 0) {
+            if (errno == EINTR) continue;
+            perror("accept");
+            break;
+        }
+        fcntl(conn, F_SETFD, FD_CLOEXEC);
+
+        int status = serve_request(conn, handler, user_data);
+        if (status >= 0) {
+            int32_t reply = (int32_t)status;
+            write_all(conn, &reply, sizeof(reply));
+        }
+        close(conn);
+    }
+
+    close(listener);
+    unlink(socket_path);
+    printf("AXL compile server stopped\n");
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Client
+ * ------------------------------------------------------------------------- */
+
+int axl_connect(const char* socket_path, int argc, char** argv) {
+    struct sockaddr_un addr;
+    if (!socket_path || argc <= 0 || !make_address(socket_path, &addr)) return -1;
+
+    char* cwd = getcwd(NULL, 0);
+    if (!cwd) return -1;
+
+    // Flatten cwd + argv into one NUL-separated payload
+    size_t size = strlen(cwd) + 1;
+    for (int i = 0; i < argc; i++) size += strlen(argv[i]) + 1;
+    char* payload = (size <= AXL_SERVER_MAX_REQUEST) ? (char*)malloc(size) : NULL;
+    if (!payload) {
+        free(cwd);
+        return -1;
+    }
+
+    char* p = payload;
+    size_t len = strlen(cwd) + 1;
+    memcpy(p, cwd, len);
+    p += len;
+    for (int i = 0; i < argc; i++) {
+        len = strlen(argv[i]) + 1;
+        memcpy(p, argv[i], len);
+        p += len;
+    }
+    free(cwd);
+
+    int conn = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (conn < 0 || connect(conn, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        if (conn >= 0) close(conn);
+        free(payload);
+        return -1;
+    }
+
+    RequestHeader header = { AXL_SERVER_MAGIC, (uint32_t)argc, (uint32_t)size };
+    int fds[AXL_SERVER_FD_COUNT] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    union {
+        char buf[CMSG_SPACE(sizeof(fds))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct iovec iov = { &header, sizeof(header) };
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    // Output goes straight to our descriptors; flush anything buffered first
+    fflush(stdout);
+    fflush(stderr);
+
+    int32_t status = -1;
+    bool sent = sendmsg(conn, &msg, MSG_NOSIGNAL) == (ssize_t)sizeof(header) &&
+                write_all(conn, payload, size);
+    if (!sent || !read_all(conn, &status, sizeof(status))) {
+        // Connected but the exchange broke: report failure, do not fall back
+        fprintf(stderr, "Error: Lost connection to compile server: %s\n", socket_path);
+        status = 1;
+    }
+
+    free(payload);
+    close(conn);
+    return (int)status;
+}
@@ -0,0 +1,24 @@
+// src/cli/server.h
+#ifndef AXL_CLI_SERVER_H
+#define AXL_CLI_SERVER_H
+
+/// Handles one forwarded command line inside the server process.
+/// Standard streams are the client's for the duration of the call.
+typedef int (*AxlRequestHandler)(int argc, char** argv, void* user_data);
+
+/**
+ * Listen on a Unix domain socket and serve forwarded command lines one
+ * at a time until SIGINT/SIGTERM. State in `user_data` persists across
+ * requests.
+ * @return Process exit status
+ */
+int axl_serve(const char* socket_path, AxlRequestHandler handler, void* user_data);
+
+/**
+ * Forward a command line (and this process's standard streams and
+ * working directory) to a running server and wait for its exit status.
+ * @return The remote exit status, or -1 if no server could be reached
+ */
+int axl_connect(const char* socket_path, int argc, char** argv);
+
+#endif // AXL_CLI_SERVER_H
@@ -0,0 +1,229 @@
+// src/core/axml/compact.c
+#include <axl/core/axml/parser.h>
+#include <axl/core/utils/memory.h>
+#include <stdint.h>
+
+/// Growable, deduplicating string pool used while compacting.
+typedef struct {
+    char     *data;
+    size_t    size;
+    size_t    capacity;
+    uint32_t *slots;           // Offsets + 1 (0 = empty), open addressing
+    size_t    slot_capacity;   // Power of two
+    size_t    slot_count;
+} StringPool;
+
+static uint32_t pool_hash(const char *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool pool_init(StringPool *pool, size_t expected_strings) {
+    memset(pool, 0, sizeof(*pool));
+    pool->slot_capacity = 16;
+    while (pool->slot_capacity < expected_strings * 2) pool->slot_capacity <<= 1;
+
+    pool->slots = (uint32_t*)calloc(pool->slot_capacity, sizeof(uint32_t));
+    return pool->slots != NULL;
+}
+
+static bool pool_rehash(StringPool *pool) {
+    size_t capacity = pool->slot_capacity * 2;
+    uint32_t *slots = (uint32_t*)calloc(capacity, sizeof(uint32_t));
+    if (!slots) return false;
+
+    for (size_t i = 0; i < pool->slot_capacity; i++) {
+        uint32_t entry = pool->slots[i];
+        if (!entry) continue;
+
+        size_t slot = pool_hash(pool->data + entry - 1) & (capacity - 1);
+        while (slots[slot]) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = entry;
+    }
+
+    free(pool->slots);
+    pool->slots = slots;
+    pool->slot_capacity = capacity;
+    return true;
+}
+
+/// Intern `s`, returning its offset (AXML_NO_STRING for NULL).
+static bool pool_add(StringPool *pool, const char *s, uint32_t *offset) {
+    if (!s) {
+        *offset = AXML_NO_STRING;
+        return true;
+    }
+
+    size_t slot = pool_hash(s) & (pool->slot_capacity - 1);
+    while (pool->slots[slot]) {
+        uint32_t existing = pool->slots[slot] - 1;
+        if (strcmp(pool->data + existing, s) == 0) {
+            *offset = existing;
+            return true;
+        }
+        slot = (slot + 1) & (pool->slot_capacity - 1);
+    }
+
+    size_t len = strlen(s) + 1;
+    if (pool->size + len >= AXML_NO_STRING) return false;
+
+    if (pool->size + len > pool->capacity) {
+        size_t capacity = pool->capacity ? pool->capacity * 2 : 256;
+        while (capacity < pool->size + len) capacity *= 2;
+        char *data = (char*)axl_realloc(pool->data, capacity, AXL_MEM_AXML);
+        if (!data) return false;
+        pool->data = data;
+        pool->capacity = capacity;
+    }
+
+    *offset = (uint32_t)pool->size;
+    memcpy(pool->data + pool->size, s, len);
+    pool->size += len;
+    pool->slots[slot] = *offset + 1;
+
+    if (++pool->slot_count * 2 > pool->slot_capacity) {
+        return pool_rehash(pool);
+    }
+    return true;
+}
+
+AxmlCompactConfig* axml_compact_config(const AxmlConfig* config) {
+    if (!config) return NULL;
+
+    // First pass: count everything so the arrays are sized exactly
+    size_t concept_count = 0, binding_count = 0, value_count = 0, symbol_count = 0;
+    for (const AxmlConcept* c = config->concepts; c; c = c->next) {
+        concept_count++;
+        for (const AxmlBinding* b = c->bindings; b; b = b->next) {
+            binding_count++;
+            value_count += b->values ? b->value_count : 0;
+        }
+    }
+    for (const AxmlSymbol* s = config->symbols; s; s = s->next) {
+        symbol_count++;
+    }
+
+    // Header and all arrays share one block; strings get the second
+    size_t bytes = sizeof(AxmlCompactConfig)
+                 + concept_count * sizeof(AxmlCompactConcept)
+                 + binding_count * sizeof(AxmlCompactBinding)
+                 + symbol_count * sizeof(AxmlCompactSymbol)
+                 + value_count * sizeof(uint32_t);
+    char* block = (char*)axl_calloc(1, bytes, AXL_MEM_AXML);
+    if (!block) return NULL;
+
+    AxmlCompactConfig* compact = (AxmlCompactConfig*)block;
+    char* p = block + sizeof(AxmlCompactConfig);
+    compact->concepts = (AxmlCompactConcept*)p;  p += concept_count * sizeof(AxmlCompactConcept);
+    compact->bindings = (AxmlCompactBinding*)p;  p += binding_count * sizeof(AxmlCompactBinding);
+    compact->symbols = (AxmlCompactSymbol*)p;    p += symbol_count * sizeof(AxmlCompactSymbol);
+    compact->value_offsets = (uint32_t*)p;
+    compact->bust_policy = config->bust_policy;
+    compact->retain_memory = config->retain_memory;
+    compact->hash_cons = config->hash_cons;
+    compact->memory_budget = config->memory_budget;
+
+    StringPool pool;
+    if (!pool_init(&pool, concept_count + binding_count * 2 + value_count + symbol_count * 2 + 1) ||
+        !pool_add(&pool, config->source_path, &compact->source_path)) {
+        goto fail;
+    }
+
+    // Second pass: fill arrays in list order
+    for (const AxmlConcept* c = config->concepts; c; c = c->next) {
+        AxmlCompactConcept* cc = &compact->concepts[compact->concept_count++];
+        if (!pool_add(&pool, c->id, &cc->id)) goto fail;
+        cc->bindings_begin = (uint32_t)compact->binding_count;
+
+        for (const AxmlBinding* b = c->bindings; b; b = b->next) {
+            AxmlCompactBinding* cb = &compact->bindings[compact->binding_count++];
+            if (!pool_add(&pool, b->name, &cb->name) ||
+                !pool_add(&pool, b->value, &cb->value)) {
+                goto fail;
+            }
+            cb->cardinality = b->cardinality;
+            cb->values_begin = (uint32_t)compact->value_count;
+
+            for (size_t i = 0; b->values && i < b->value_count; i++) {
+                if (!pool_add(&pool, b->values[i], &compact->value_offsets[compact->value_count++])) {
+                    goto fail;
+                }
+            }
+            cb->values_end = (uint32_t)compact->value_count;
+        }
+        cc->bindings_end = (uint32_t)compact->binding_count;
+    }
+
+    for (const AxmlSymbol* s = config->symbols; s; s = s->next) {
+        AxmlCompactSymbol* cs = &compact->symbols[compact->symbol_count++];
+        if (!pool_add(&pool, s->id, &cs->id) ||
+            !pool_add(&pool, s->visual, &cs->visual)) {
+            goto fail;
+        }
+    }
+
+    free(pool.slots);
+
+    // Trim the pool to its final size
+    compact->strings_size = pool.size;
+    compact->strings = pool.size ? (char*)axl_realloc(pool.data, pool.size, AXL_MEM_AXML) : pool.data;
+    if (!compact->strings) compact->strings = pool.data;
+
+    return compact;
+
+fail:
+    free(pool.slots);
+    axl_free(pool.data);
+    axl_free(block);
+    return NULL;
+}
+
+AxmlCompactConfig* axml_copy_compact_config(const AxmlCompactConfig* config) {
+    if (!config) return NULL;
+
+    // Same two-block layout as axml_compact_config()
+    size_t bytes = sizeof(AxmlCompactConfig)
+                 + config->concept_count * sizeof(AxmlCompactConcept)
+                 + config->binding_count * sizeof(AxmlCompactBinding)
+                 + config->symbol_count * sizeof(AxmlCompactSymbol)
+                 + config->value_count * sizeof(uint32_t);
+    char* block = (char*)axl_malloc(bytes, AXL_MEM_AXML);
+    char* strings = config->strings_size ? (char*)axl_malloc(config->strings_size, AXL_MEM_AXML) : NULL;
+    if (!block || (config->strings_size && !strings)) {
+        axl_free(block);
+        axl_free(strings);
+        return NULL;
+    }
+
+    memcpy(block, config, bytes);
+    if (strings) memcpy(strings, config->strings, config->strings_size);
+
+    AxmlCompactConfig* copy = (AxmlCompactConfig*)block;
+    char* p = block + sizeof(AxmlCompactConfig);
+    copy->concepts = (AxmlCompactConcept*)p;  p += copy->concept_count * sizeof(AxmlCompactConcept);
+    copy->bindings = (AxmlCompactBinding*)p;  p += copy->binding_count * sizeof(AxmlCompactBinding);
+    copy->symbols = (AxmlCompactSymbol*)p;    p += copy->symbol_count * sizeof(AxmlCompactSymbol);
+    copy->value_offsets = (uint32_t*)p;
+    copy->strings = strings;
+    return copy;
+}
+
+AxmlCompactConfig* axml_parse_compact(const char* filename) {
+    AxmlConfig* config = axml_parse_file(filename);
+    if (!config) return NULL;
+
+    AxmlCompactConfig* compact = axml_compact_config(config);
+    axml_free_config(config);
+    return compact;
+}
+
+void axml_free_compact_config(AxmlCompactConfig* config) {
+    if (!config) return;
+
+    axl_free(config->strings);
+    axl_free(config);
+}
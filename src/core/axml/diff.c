@@ -0,0 +1,134 @@
+// src/core/axml/diff.c
+#include <axl/core/axml/diff.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t binding;          // Index into old_config->bindings, +1 (0 = empty)
+    uint32_t concept;          // Owning concept index
+    bool     matched;
+} DiffSlot;
+
+static uint32_t diff_hash(const char* concept_id, const char* name) {
+    uint32_t h = 2166136261u;
+    for (const char* p = concept_id; p && *p; p++) h = (h ^ (unsigned char)*p) * 16777619u;
+    h = (h ^ 0xffu) * 16777619u;
+    for (const char* p = name; p && *p; p++) h = (h ^ (unsigned char)*p) * 16777619u;
+    return h;
+}
+
+static bool str_equal(const char* a, const char* b) {
+    if (!a || !b) return a == b;
+    return strcmp(a, b) == 0;
+}
+
+static bool binding_equal(const AxmlCompactConfig* a, const AxmlCompactBinding* ba,
+                          const AxmlCompactConfig* b, const AxmlCompactBinding* bb) {
+    if (ba->cardinality != bb->cardinality ||
+        ba->values_end - ba->values_begin != bb->values_end - bb->values_begin ||
+        !str_equal(axml_string(a, ba->value), axml_string(b, bb->value))) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < ba->values_end - ba->values_begin; i++) {
+        if (!str_equal(axml_string(a, a->value_offsets[ba->values_begin + i]),
+                       axml_string(b, b->value_offsets[bb->values_begin + i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t axml_diff_configs(const AxmlCompactConfig* old_config,
+                         const AxmlCompactConfig* new_config,
+                         AxmlChangeHandler handler,
+                         void* user_data) {
+    if (!old_config || !new_config) return (size_t)-1;
+
+    // Index the old bindings by (concept id, binding name)
+    size_t capacity = 16;
+    while (capacity < old_config->binding_count * 2) capacity <<= 1;
+    DiffSlot* slots = (DiffSlot*)calloc(capacity, sizeof(DiffSlot));
+    if (!slots) return (size_t)-1;
+
+    for (uint32_t c = 0; c < old_config->concept_count; c++) {
+        const AxmlCompactConcept* concept = &old_config->concepts[c];
+        const char* id = axml_string(old_config, concept->id);
+
+        for (uint32_t b = concept->bindings_begin; b < concept->bindings_end; b++) {
+            const char* name = axml_string(old_config, old_config->bindings[b].name);
+            size_t slot = diff_hash(id, name) & (capacity - 1);
+            while (slots[slot].binding) slot = (slot + 1) & (capacity - 1);
+            slots[slot].binding = b + 1;
+            slots[slot].concept = c;
+        }
+    }
+
+    size_t changes = 0;
+
+    for (uint32_t c = 0; c < new_config->concept_count; c++) {
+        const AxmlCompactConcept* concept = &new_config->concepts[c];
+        const char* id = axml_string(new_config, concept->id);
+
+        for (uint32_t b = concept->bindings_begin; b < concept->bindings_end; b++) {
+            const AxmlCompactBinding* binding = &new_config->bindings[b];
+            const char* name = axml_string(new_config, binding->name);
+
+            // Duplicate keys pair up in order of appearance
+            DiffSlot* match = NULL;
+            for (size_t slot = diff_hash(id, name) & (capacity - 1);
+                 slots[slot].binding;
+                 slot = (slot + 1) & (capacity - 1)) {
+                DiffSlot* s = &slots[slot];
+                const AxmlCompactBinding* old_binding = &old_config->bindings[s->binding - 1];
+                if (!s->matched &&
+                    str_equal(axml_string(old_config, old_config->concepts[s->concept].id), id) &&
+                    str_equal(axml_string(old_config, old_binding->name), name)) {
+                    match = s;
+                    break;
+                }
+            }
+
+            AxmlBindingChange change = { .concept_id = id, .new_binding = binding };
+            if (!match) {
+                change.kind = AXML_BINDING_ADDED;
+            } else {
+                match->matched = true;
+                change.old_binding = &old_config->bindings[match->binding - 1];
+                if (binding_equal(old_config, change.old_binding, new_config, binding)) {
+                    continue;
+                }
+                change.kind = AXML_BINDING_CHANGED;
+            }
+
+            changes++;
+            if (handler) handler(&change, user_data);
+        }
+    }
+
+    // Anything left unmatched disappeared
+    for (size_t slot = 0; slot < capacity; slot++) {
+        if (!slots[slot].binding || slots[slot].matched) continue;
+
+        AxmlBindingChange change = {
+            .kind = AXML_BINDING_REMOVED,
+            .concept_id = axml_string(old_config, old_config->concepts[slots[slot].concept].id),
+            .old_binding = &old_config->bindings[slots[slot].binding - 1]
+        };
+        changes++;
+        if (handler) handler(&change, user_data);
+    }
+
+    free(slots);
+    return changes;
+}
+
+bool axml_diff_requires_rebuild(const AxmlCompactConfig* old_config,
+                                const AxmlCompactConfig* new_config) {
+    if (!old_config || !new_config) return true;
+
+    return old_config->bust_policy != new_config->bust_policy ||
+           old_config->retain_memory != new_config->retain_memory ||
+           old_config->hash_cons != new_config->hash_cons ||
+           !str_equal(axml_string(old_config, old_config->source_path),
+                      axml_string(new_config, new_config->source_path));
+}
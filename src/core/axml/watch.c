@@ -0,0 +1,114 @@
+// src/core/axml/watch.c
+#include <axl/core/axml/watch.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Quiet period used to coalesce the several events one save produces
+#define AXML_WATCH_SETTLE_MS 20
+
+struct AxmlWatcher {
+    int   fd;
+    int   wd;
+    char* name;                // Basename of the watched file
+};
+
+AxmlWatcher* axml_watch_create(const char* path) {
+    if (!path) return NULL;
+
+    AxmlWatcher* watcher = (AxmlWatcher*)calloc(1, sizeof(AxmlWatcher));
+    if (!watcher) return NULL;
+
+    // Split into directory and basename
+    const char* slash = strrchr(path, '/');
+    char* dir = slash ? strndup(path, (size_t)(slash - path) + (slash == path)) : strdup(".");
+    watcher->name = strdup(slash ? slash + 1 : path);
+
+    watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (!dir || !watcher->name || watcher->fd < 0) {
+        goto fail;
+    }
+
+    // Editors often write a temp file and rename it over the original
+    watcher->wd = inotify_add_watch(watcher->fd, dir,
+                                    IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (watcher->wd < 0) {
+        goto fail;
+    }
+
+    free(dir);
+    return watcher;
+
+fail:
+    free(dir);
+    if (watcher->fd >= 0) close(watcher->fd);
+    free(watcher->name);
+    free(watcher);
+    return NULL;
+}
+
+int axml_watch_fd(const AxmlWatcher* watcher) {
+    return watcher ? watcher->fd : -1;
+}
+
+/// Drain pending events. Returns 1 if any concern the watched file.
+static int axml_watch_drain(AxmlWatcher* watcher) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int changed = 0;
+
+    for (;;) {
+        ssize_t n = read(watcher->fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) return changed;
+            return -1;
+        }
+        if (n == 0) return changed;
+
+        for (char* p = buffer; p < buffer + n; ) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            if (event->len > 0 && strcmp(event->name, watcher->name) == 0) {
+                changed = 1;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+}
+
+int axml_watch_wait(AxmlWatcher* watcher, int timeout_ms) {
+    if (!watcher) return -1;
+
+    struct pollfd pfd = { .fd = watcher->fd, .events = POLLIN };
+
+    for (;;) {
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (ready == 0) return 0;
+
+        int changed = axml_watch_drain(watcher);
+        if (changed <= 0) {
+            if (changed < 0) return -1;
+            continue;      // Some other file in the directory
+        }
+
+        // Coalesce the rest of this save into the same notification
+        while (poll(&pfd, 1, AXML_WATCH_SETTLE_MS) > 0) {
+            if (axml_watch_drain(watcher) < 0) return -1;
+        }
+        return 1;
+    }
+}
+
+void axml_watch_destroy(AxmlWatcher* watcher) {
+    if (!watcher) return;
+
+    close(watcher->fd);
+    free(watcher->name);
+    free(watcher);
+}
@@ -1,99 +1,708 @@
 // src/core/axml/xml_parser.c
 #include <axl/core/axml/parser.h>
+#include <axl/core/utils/line_index.h>
+#include <axl/core/utils/memory.h>
+#include <axl/core/utils/source.h>
+#include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdio.h>
 
-// Forward declarations for our SAX-style parser
-static void start_element_handler(void* user_data, const char* name, const char** attrs);
-static void end_element_handler(void* user_data, const char* name);
-static void character_data_handler(void* user_data, const char* data, int length);
+/*
+ * AXML documents:
+ *
+ *   <axml source="main.axl" bust="immediate|delayed|conditional"
+ *         retain="true" hash-cons="true" memory-budget="64M">
+ *     <concept id="masquerade">
+ *       <binding name="chant" value="Kwenu!" cardinality="1:N"/>
+ *       <binding name="spirits" cardinality="N:M">
+ *         <value>mmanwu</value>
+ *       </binding>
+ *     </concept>
+ *     <symbol id="mask" visual="..."/>
+ *   </axml>
+ *
+ * Every root attribute is optional. The reader below handles the XML
+ * subset these need (elements, attributes, text, comments, CDATA, the
+ * predefined and numeric entities) and feeds SAX-style handlers.
+ */
+
+// Nesting and attribute limits of the reader
+#define AXML_MAX_DEPTH       16
+#define AXML_MAX_ATTRIBUTES  16
+
+/// Document being turned into an AxmlConfig by the handlers.
+typedef struct {
+    AxmlConfig*   config;
+    AxmlConcept*  concept;         // Open <concept>
+    AxmlBinding*  binding;         // Open <binding>
+    AxmlConcept** concept_tail;    // Keep document order
+    AxmlBinding** binding_tail;
+    AxmlSymbol**  symbol_tail;
+    char*         text;            // Character data of an open <value>
+    size_t        text_size;
+    size_t        text_capacity;
+    bool          in_value;
+    bool          seen_root;
+    const char*   error;           // First error, stops the reader
+} AxmlBuilder;
+
+/* ---------------------------------------------------------------------------
+ * Handlers
+ * ------------------------------------------------------------------------- */
+
+static bool builder_fail(AxmlBuilder* builder, const char* message) {
+    if (!builder->error) builder->error = message;
+    return false;
+}
+
+static const char* find_attribute(const char** attrs, const char* name) {
+    for (size_t i = 0; attrs[i]; i += 2) {
+        if (strcmp(attrs[i], name) == 0) return attrs[i + 1];
+    }
+    return NULL;
+}
+
+static bool parse_bool(const char* text, bool* value) {
+    if (strcasecmp(text, "true") == 0 || strcasecmp(text, "yes") == 0 || strcmp(text, "1") == 0) {
+        *value = true;
+        return true;
+    }
+    if (strcasecmp(text, "false") == 0 || strcasecmp(text, "no") == 0 || strcmp(text, "0") == 0) {
+        *value = false;
+        return true;
+    }
+    return false;
+}
+
+// "512", "64K", "200M" or "2G"
+static bool parse_size(const char* text, size_t* value) {
+    char* end = NULL;
+    unsigned long long bytes = strtoull(text, &end, 10);
+    if (end == text || *text == '-') return false;
+
+    switch (*end) {
+        case 'k': case 'K': bytes <<= 10; end++; break;
+        case 'm': case 'M': bytes <<= 20; end++; break;
+        case 'g': case 'G': bytes <<= 30; end++; break;
+        default: break;
+    }
+    *value = (size_t)bytes;
+    return *end == '\0';
+}
+
+static bool parse_bust_policy(const char* text, BustPolicy* policy) {
+    static const struct { const char* name; BustPolicy policy; } policies[] = {
+        { "immediate",   BUST_IMMEDIATE },
+        { "delayed",     BUST_DELAYED },
+        { "conditional", BUST_CONDITIONAL },
+    };
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (strcasecmp(text, policies[i].name) == 0) {
+            *policy = policies[i].policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parse_cardinality(const char* text, CardinalityType* cardinality) {
+    static const struct { const char* name; CardinalityType cardinality; } kinds[] = {
+        { "0:1", CARDINALITY_ZERO_ONE },
+        { "1:0", CARDINALITY_ONE_ZERO },
+        { "1:1", CARDINALITY_ONE_ONE },
+        { "1:N", CARDINALITY_ONE_MANY },
+        { "N:1", CARDINALITY_MANY_ONE },
+        { "N:M", CARDINALITY_MANY_MANY },
+    };
+    for (size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+        if (strcasecmp(text, kinds[i].name) == 0) {
+            *cardinality = kinds[i].cardinality;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool start_root(AxmlBuilder* builder, const char** attrs) {
+    AxmlConfig* config = builder->config;
+    const char* value;
+
+    if ((value = find_attribute(attrs, "source"))) {
+        config->source_path = axl_strdup(value, AXL_MEM_AXML);
+        if (!config->source_path) return builder_fail(builder, "out of memory");
+    }
+    if ((value = find_attribute(attrs, "bust")) && !parse_bust_policy(value, &config->bust_policy)) {
+        return builder_fail(builder, "bust must be immediate, delayed or conditional");
+    }
+    if ((value = find_attribute(attrs, "retain")) && !parse_bool(value, &config->retain_memory)) {
+        return builder_fail(builder, "retain must be true or false");
+    }
+    if ((value = find_attribute(attrs, "hash-cons")) && !parse_bool(value, &config->hash_cons)) {
+        return builder_fail(builder, "hash-cons must be true or false");
+    }
+    if ((value = find_attribute(attrs, "memory-budget")) && !parse_size(value, &config->memory_budget)) {
+        return builder_fail(builder, "memory-budget must be a size such as 512K or 64M");
+    }
+    return true;
+}
+
+static bool start_concept(AxmlBuilder* builder, const char** attrs) {
+    const char* id = find_attribute(attrs, "id");
+    if (!id) return builder_fail(builder, "<concept> needs an id");
+
+    AxmlConcept* concept = (AxmlConcept*)axl_calloc(1, sizeof(AxmlConcept), AXL_MEM_AXML);
+    if (!concept) return builder_fail(builder, "out of memory");
+
+    // Linked before anything else can fail, so axml_free_config() frees it
+    *builder->concept_tail = concept;
+    builder->concept_tail = &concept->next;
+    builder->concept = concept;
+    builder->binding_tail = &concept->bindings;
+
+    concept->id = axl_strdup(id, AXL_MEM_AXML);
+    return concept->id ? true : builder_fail(builder, "out of memory");
+}
+
+static bool start_binding(AxmlBuilder* builder, const char** attrs) {
+    const char* name = find_attribute(attrs, "name");
+    const char* value = find_attribute(attrs, "value");
+    const char* cardinality = find_attribute(attrs, "cardinality");
+    if (!name) return builder_fail(builder, "<binding> needs a name");
+
+    AxmlBinding* binding = (AxmlBinding*)axl_calloc(1, sizeof(AxmlBinding), AXL_MEM_AXML);
+    if (!binding) return builder_fail(builder, "out of memory");
+
+    *builder->binding_tail = binding;
+    builder->binding_tail = &binding->next;
+    builder->binding = binding;
+
+    binding->cardinality = CARDINALITY_ONE_ONE;
+    if (cardinality && !parse_cardinality(cardinality, &binding->cardinality)) {
+        return builder_fail(builder, "cardinality must be 0:1, 1:0, 1:1, 1:N, N:1 or N:M");
+    }
+
+    binding->name = axl_strdup(name, AXL_MEM_AXML);
+    if (value) binding->value = axl_strdup(value, AXL_MEM_AXML);
+    if (!binding->name || (value && !binding->value)) return builder_fail(builder, "out of memory");
+    return true;
+}
+
+static bool start_symbol(AxmlBuilder* builder, const char** attrs) {
+    const char* id = find_attribute(attrs, "id");
+    const char* visual = find_attribute(attrs, "visual");
+    if (!id) return builder_fail(builder, "<symbol> needs an id");
+
+    AxmlSymbol* symbol = (AxmlSymbol*)axl_calloc(1, sizeof(AxmlSymbol), AXL_MEM_AXML);
+    if (!symbol) return builder_fail(builder, "out of memory");
+
+    *builder->symbol_tail = symbol;
+    builder->symbol_tail = &symbol->next;
+
+    symbol->id = axl_strdup(id, AXL_MEM_AXML);
+    if (visual) symbol->visual = axl_strdup(visual, AXL_MEM_AXML);
+    if (!symbol->id || (visual && !symbol->visual)) return builder_fail(builder, "out of memory");
+    return true;
+}
+
+static void start_element_handler(void* user_data, const char* name, const char** attrs) {
+    AxmlBuilder* builder = (AxmlBuilder*)user_data;
+    bool at_root = !builder->concept && !builder->in_value;
+
+    if (strcmp(name, "axml") == 0) {
+        if (builder->seen_root) {
+            builder_fail(builder, "only one <axml> element is allowed");
+            return;
+        }
+        builder->seen_root = true;
+        start_root(builder, attrs);
+    } else if (!builder->seen_root) {
+        builder_fail(builder, "the document element must be <axml>");
+    } else if (strcmp(name, "concept") == 0 && at_root) {
+        start_concept(builder, attrs);
+    } else if (strcmp(name, "symbol") == 0 && at_root) {
+        start_symbol(builder, attrs);
+    } else if (strcmp(name, "binding") == 0 && builder->concept && !builder->binding) {
+        start_binding(builder, attrs);
+    } else if (strcmp(name, "value") == 0 && builder->binding && !builder->in_value) {
+        builder->in_value = true;
+        builder->text_size = 0;
+    } else {
+        builder_fail(builder, "unexpected element");
+    }
+}
+
+static void end_element_handler(void* user_data, const char* name) {
+    AxmlBuilder* builder = (AxmlBuilder*)user_data;
+
+    if (strcmp(name, "value") == 0 && builder->in_value) {
+        AxmlBinding* binding = builder->binding;
+        char** values = (char**)axl_realloc(binding->values,
+                                            (binding->value_count + 1) * sizeof(char*),
+                                            AXL_MEM_AXML);
+        if (!values) {
+            builder_fail(builder, "out of memory");
+            return;
+        }
+        binding->values = values;
+
+        char* value = (char*)axl_malloc(builder->text_size + 1, AXL_MEM_AXML);
+        if (!value) {
+            builder_fail(builder, "out of memory");
+            return;
+        }
+        if (builder->text_size > 0) memcpy(value, builder->text, builder->text_size);
+        value[builder->text_size] = '\0';
+        binding->values[binding->value_count++] = value;
+        builder->in_value = false;
+    } else if (strcmp(name, "binding") == 0) {
+        builder->binding = NULL;
+    } else if (strcmp(name, "concept") == 0) {
+        builder->concept = NULL;
+    }
+}
+
+static void character_data_handler(void* user_data, const char* data, int length) {
+    AxmlBuilder* builder = (AxmlBuilder*)user_data;
+
+    if (!builder->in_value) {
+        // Only indentation may appear between elements
+        for (int i = 0; i < length; i++) {
+            if (!isspace((unsigned char)data[i])) {
+                builder_fail(builder, "unexpected text");
+                return;
+            }
+        }
+        return;
+    }
+
+    if (builder->text_size + (size_t)length > builder->text_capacity) {
+        size_t capacity = builder->text_capacity ? builder->text_capacity * 2 : 64;
+        while (capacity < builder->text_size + (size_t)length) capacity *= 2;
+        char* text = (char*)realloc(builder->text, capacity);
+        if (!text) {
+            builder_fail(builder, "out of memory");
+            return;
+        }
+        builder->text = text;
+        builder->text_capacity = capacity;
+    }
+    memcpy(builder->text + builder->text_size, data, (size_t)length);
+    builder->text_size += (size_t)length;
+}
+
+/* ---------------------------------------------------------------------------
+ * Reader
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    const char*  data;
+    size_t       size;
+    size_t       pos;
+    AxmlBuilder* builder;
+    const char*  open[AXML_MAX_DEPTH];    // Names of open elements (decoded copies)
+    size_t       depth;
+} XmlReader;
+
+static bool reader_fail(XmlReader* reader, const char* message) {
+    return builder_fail(reader->builder, message);
+}
+
+static bool is_name_char(char c) {
+    return isalnum((unsigned char)c) || c == '-' || c == '_' || c == ':' || c == '.';
+}
+
+static bool starts_with(const XmlReader* reader, const char* prefix) {
+    size_t len = strlen(prefix);
+    return reader->size - reader->pos >= len && memcmp(reader->data + reader->pos, prefix, len) == 0;
+}
+
+/// Skip past the next `terminator`; false if it never comes.
+static bool skip_past(XmlReader* reader, const char* terminator) {
+    size_t len = strlen(terminator);
+    while (reader->size - reader->pos >= len) {
+        if (memcmp(reader->data + reader->pos, terminator, len) == 0) {
+            reader->pos += len;
+            return true;
+        }
+        reader->pos++;
+    }
+    return false;
+}
+
+static void skip_space(XmlReader* reader) {
+    while (reader->pos < reader->size && isspace((unsigned char)reader->data[reader->pos])) {
+        reader->pos++;
+    }
+}
+
+/// Append `code` as UTF-8.
+static size_t encode_utf8(unsigned long code, char* out) {
+    if (code < 0x80) {
+        out[0] = (char)code;
+        return 1;
+    }
+    if (code < 0x800) {
+        out[0] = (char)(0xC0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if (code < 0x10000) {
+        out[0] = (char)(0xE0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (code >> 18));
+    out[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+/// Decode entities in `text[0..len)` into `out` (at most `len` bytes).
+/// Returns the decoded length, or (size_t)-1 on a bad entity.
+static size_t decode_text(const char* text, size_t len, char* out) {
+    static const struct { const char* name; char value; } entities[] = {
+        { "lt", '<' }, { "gt", '>' }, { "amp", '&' }, { "quot", '"' }, { "apos", '\'' },
+    };
+
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] != '&') {
+            out[n++] = text[i];
+            continue;
+        }
+
+        const char* semi = (const char*)memchr(text + i, ';', len - i);
+        if (!semi) return (size_t)-1;
+        const char* name = text + i + 1;
+        size_t name_len = (size_t)(semi - name);
+        bool decoded = false;
+
+        if (name_len > 1 && name[0] == '#') {
+            char digits[16];
+            bool hex = name[1] == 'x' || name[1] == 'X';
+            size_t digit_len = name_len - (hex ? 2 : 1);
+            if (digit_len == 0 || digit_len >= sizeof(digits)) return (size_t)-1;
+            memcpy(digits, name + (hex ? 2 : 1), digit_len);
+            digits[digit_len] = '\0';
+
+            char* end = NULL;
+            unsigned long code = strtoul(digits, &end, hex ? 16 : 10);
+            // A reference takes at least 4 bytes and decodes to at most 4
+            if (*end != '\0' || code == 0 || code > 0x10FFFF) return (size_t)-1;
+            n += encode_utf8(code, out + n);
+            decoded = true;
+        } else {
+            for (size_t e = 0; e < sizeof(entities) / sizeof(entities[0]); e++) {
+                if (strlen(entities[e].name) == name_len && memcmp(entities[e].name, name, name_len) == 0) {
+                    out[n++] = entities[e].value;
+                    decoded = true;
+                    break;
+                }
+            }
+        }
+
+        if (!decoded) return (size_t)-1;
+        i = (size_t)(semi - text);
+    }
+    return n;
+}
+
+static bool read_text(XmlReader* reader) {
+    size_t start = reader->pos;
+    const char* lt = (const char*)memchr(reader->data + start, '<', reader->size - start);
+    size_t end = lt ? (size_t)(lt - reader->data) : reader->size;
+    reader->pos = end;
+
+    size_t len = end - start;
+    if (len == 0) return true;
+    if (len > (size_t)INT32_MAX) return reader_fail(reader, "text too long");
+
+    char* decoded = (char*)malloc(len);
+    if (!decoded) return reader_fail(reader, "out of memory");
+    size_t decoded_len = decode_text(reader->data + start, len, decoded);
+    if (decoded_len == (size_t)-1) {
+        free(decoded);
+        reader->pos = start;
+        return reader_fail(reader, "invalid entity reference");
+    }
+
+    character_data_handler(reader->builder, decoded, (int)decoded_len);
+    free(decoded);
+    return !reader->builder->error;
+}
+
+static bool read_cdata(XmlReader* reader) {
+    reader->pos += strlen("<![CDATA[");
+    size_t start = reader->pos;
+    if (!skip_past(reader, "]]>")) return reader_fail(reader, "unterminated CDATA section");
+
+    size_t len = reader->pos - 3 - start;
+    if (len > (size_t)INT32_MAX) return reader_fail(reader, "text too long");
+    character_data_handler(reader->builder, reader->data + start, (int)len);
+    return !reader->builder->error;
+}
+
+/// Copy of the element or attribute name at the cursor.
+static char* read_name(XmlReader* reader) {
+    size_t start = reader->pos;
+    while (reader->pos < reader->size && is_name_char(reader->data[reader->pos])) reader->pos++;
+    if (reader->pos == start) return NULL;
+
+    size_t len = reader->pos - start;
+    char* name = (char*)malloc(len + 1);
+    if (!name) return NULL;
+    memcpy(name, reader->data + start, len);
+    name[len] = '\0';
+    return name;
+}
+
+static bool read_end_tag(XmlReader* reader) {
+    reader->pos += 2;
+    char* name = read_name(reader);
+    skip_space(reader);
+    if (!name || reader->pos >= reader->size || reader->data[reader->pos] != '>') {
+        free(name);
+        return reader_fail(reader, "malformed end tag");
+    }
+    reader->pos++;
+
+    if (reader->depth == 0 || strcmp(reader->open[reader->depth - 1], name) != 0) {
+        free(name);
+        return reader_fail(reader, "mismatched end tag");
+    }
+
+    end_element_handler(reader->builder, name);
+    free(name);
+    free((char*)reader->open[--reader->depth]);
+    return !reader->builder->error;
+}
+
+static void free_attributes(const char** attrs) {
+    for (size_t i = 0; attrs[i]; i++) free((char*)attrs[i]);
+}
+
+static bool read_start_tag(XmlReader* reader) {
+    reader->pos++;
+    char* name = read_name(reader);
+    if (!name) return reader_fail(reader, "malformed start tag");
+
+    const char* attrs[2 * AXML_MAX_ATTRIBUTES + 1] = {0};
+    size_t attr_count = 0;
+    bool empty = false;
+
+    for (;;) {
+        skip_space(reader);
+        if (reader->pos >= reader->size) {
+            reader_fail(reader, "unterminated start tag");
+            break;
+        }
+
+        char c = reader->data[reader->pos];
+        if (c == '>') {
+            reader->pos++;
+            break;
+        }
+        if (c == '/' && starts_with(reader, "/>")) {
+            reader->pos += 2;
+            empty = true;
+            break;
+        }
+
+        if (attr_count == AXML_MAX_ATTRIBUTES) {
+            reader_fail(reader, "too many attributes");
+            break;
+        }
+        char* attr_name = read_name(reader);
+        skip_space(reader);
+        if (!attr_name || reader->pos >= reader->size || reader->data[reader->pos] != '=') {
+            free(attr_name);
+            reader_fail(reader, "expected attribute=\"value\"");
+            break;
+        }
+        reader->pos++;
+        skip_space(reader);
+
+        char quote = reader->pos < reader->size ? reader->data[reader->pos] : '\0';
+        const char* close = (quote == '"' || quote == '\'')
+                          ? (const char*)memchr(reader->data + reader->pos + 1, quote,
+                                                reader->size - reader->pos - 1)
+                          : NULL;
+        if (!close) {
+            free(attr_name);
+            reader_fail(reader, "unterminated attribute value");
+            break;
+        }
+
+        const char* raw = reader->data + reader->pos + 1;
+        size_t raw_len = (size_t)(close - raw);
+        char* value = (char*)malloc(raw_len + 1);
+        size_t value_len = value ? decode_text(raw, raw_len, value) : (size_t)-1;
+        if (value_len == (size_t)-1) {
+            free(attr_name);
+            free(value);
+            reader_fail(reader, value ? "invalid entity reference" : "out of memory");
+            break;
+        }
+        value[value_len] = '\0';
+
+        attrs[2 * attr_count] = attr_name;
+        attrs[2 * attr_count + 1] = value;
+        attr_count++;
+        reader->pos = (size_t)(close - reader->data) + 1;
+    }
+
+    if (!reader->builder->error) {
+        if (!empty && reader->depth == AXML_MAX_DEPTH) {
+            reader_fail(reader, "elements nested too deeply");
+        } else {
+            start_element_handler(reader->builder, name, attrs);
+            if (empty) {
+                end_element_handler(reader->builder, name);
+            } else {
+                reader->open[reader->depth++] = name;
+                name = NULL;
+            }
+        }
+    }
+
+    free(name);
+    free_attributes(attrs);
+    return !reader->builder->error;
+}
+
+static bool read_document(XmlReader* reader) {
+    // Skip a UTF-8 byte order mark
+    if (starts_with(reader, "\xEF\xBB\xBF")) reader->pos += 3;
+
+    while (reader->pos < reader->size) {
+        bool ok;
+        if (reader->data[reader->pos] != '<') {
+            ok = read_text(reader);
+        } else if (starts_with(reader, "<?")) {
+            ok = skip_past(reader, "?>") || reader_fail(reader, "unterminated processing instruction");
+        } else if (starts_with(reader, "<!--")) {
+            ok = skip_past(reader, "-->") || reader_fail(reader, "unterminated comment");
+        } else if (starts_with(reader, "<![CDATA[")) {
+            ok = read_cdata(reader);
+        } else if (starts_with(reader, "<!")) {
+            ok = skip_past(reader, ">") || reader_fail(reader, "unterminated declaration");
+        } else if (starts_with(reader, "</")) {
+            ok = read_end_tag(reader);
+        } else {
+            ok = read_start_tag(reader);
+        }
+        if (!ok) return false;
+    }
+
+    if (reader->depth > 0) return reader_fail(reader, "unclosed element");
+    if (!reader->builder->seen_root) return reader_fail(reader, "missing <axml> element");
+    return true;
+}
+
+static void report_error(const char* filename, AxlSource* source, size_t offset,
+                         const char* message) {
+    AxlLinePosition position;
+    if (axl_source_position(source, offset, &position)) {
+        fprintf(stderr, "%s:%zu:%zu: error: %s\n", filename, position.line, position.column, message);
+    } else {
+        fprintf(stderr, "%s: error: %s\n", filename, message);
+    }
+}
 
 AxmlConfig* axml_parse_file(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+    if (!filename) return NULL;
+
+    AxlSource source;
+    if (!axl_source_open(filename, &source)) {
         return NULL;
     }
-    
+
     // Initialize config structure
-    AxmlConfig* config = (AxmlConfig*)calloc(1, sizeof(AxmlConfig));
+    AxmlConfig* config = (AxmlConfig*)axl_calloc(1, sizeof(AxmlConfig), AXL_MEM_AXML);
     if (!config) {
-        fclose(file);
+        axl_source_close(&source);
         return NULL;
     }
-    
+
     // Default values
     config->bust_policy = BUST_IMMEDIATE;
     config->retain_memory = false;
-    
-    // Set up XML parser
-    // Implementation detail: We would use a lightweight SAX parser here
-    // like expat or a minimal custom implementation
-    
-    // For this code sketch, we'll assume the parsing succeeds
-    // and manually populate a sample config
-    
-    // Sample initialization (in real code, this would come from XML parsing)
-    config->source_path = strdup("main.axl");
-    
-    // Create sample concept
-    AxmlConcept* concept = (AxmlConcept*)calloc(1, sizeof(AxmlConcept));
-    concept->id = strdup("masquerade");
-    
-    // Create sample binding
-    AxmlBinding* binding = (AxmlBinding*)calloc(1, sizeof(AxmlBinding));
-    binding->name = strdup("chant");
-    binding->value = strdup("Kwenu!");
-    binding->cardinality = CARDINALITY_ONE_MANY;
-    concept->bindings = binding;
-    
-    config->concepts = concept;
-    
-    // Clean up
-    fclose(file);
-    
+    config->hash_cons = false;
+    config->memory_budget = 0;
+
+    AxmlBuilder builder = {
+        .config = config,
+        .concept_tail = &config->concepts,
+        .symbol_tail = &config->symbols
+    };
+    XmlReader reader = {
+        .data = source.data,
+        .size = source.size,
+        .builder = &builder
+    };
+
+    bool ok = read_document(&reader);
+    if (!ok) {
+        report_error(filename, &source, reader.pos, builder.error);
+    }
+
+    while (reader.depth > 0) {
+        free((char*)reader.open[--reader.depth]);
+    }
+    free(builder.text);
+    axl_source_close(&source);
+
+    if (!ok) {
+        axml_free_config(config);
+        return NULL;
+    }
     return config;
 }
 
 void axml_free_config(AxmlConfig* config) {
     if (!config) return;
-    
+
     // Free source path
-    free(config->source_path);
-    
+    axl_free(config->source_path);
+
     // Free concepts and bindings
     AxmlConcept* concept = config->concepts;
     while (concept) {
         AxmlBinding* binding = concept->bindings;
         while (binding) {
             AxmlBinding* next_binding = binding->next;
-            free(binding->name);
-            free(binding->value);
+            axl_free(binding->name);
+            axl_free(binding->value);
             if (binding->values) {
                 for (size_t i = 0; i < binding->value_count; i++) {
-                    free(binding->values[i]);
+                    axl_free(binding->values[i]);
                 }
-                free(binding->values);
+                axl_free(binding->values);
             }
-            free(binding);
+            axl_free(binding);
             binding = next_binding;
         }
-        
+
         AxmlConcept* next_concept = concept->next;
-        free(concept->id);
-        free(concept);
+        axl_free(concept->id);
+        axl_free(concept);
         concept = next_concept;
     }
-    
+
     // Free symbols
     AxmlSymbol* symbol = config->symbols;
     while (symbol) {
         AxmlSymbol* next_symbol = symbol->next;
-        free(symbol->id);
-        free(symbol->visual);
-        free(symbol);
+        axl_free(symbol->id);
+        axl_free(symbol->visual);
+        axl_free(symbol);
         symbol = next_symbol;
     }
-    
+
     // Free config
-    free(config);
+    axl_free(config);
 }
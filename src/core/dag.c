@@ -1,10 +1,15 @@
 #include <axl/core/dag.h>
+#include <axl/core/utils/memory.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <string.h>
-// Forward declaration of helper function
-static void resolve_node_recursive(DAGNode *nodes[], size_t node_count, 
-                                  size_t current, bool *visited, bool *resolved);
+#include <stdint.h>
+
+// New nodes have no edges, so numbering them in creation order is a
+// valid topological order; dag_add_edge repairs it as edges arrive
+static atomic_size_t dag_next_ord;
+
 /**
  * Initialize the DAG subsystem
  * Returns 0 on success, non-zero on failure
@@ -16,7 +21,7 @@ int dag_init(void) {
                                 
 
 DAGNode* dag_node_create(TokenType t, TaxonomyCategory cat) {
-    DAGNode *node = (DAGNode*)calloc(1, sizeof(DAGNode));
+    DAGNode *node = (DAGNode*)axl_calloc(1, sizeof(DAGNode), AXL_MEM_DAG_NODE);
     if (!node) return NULL;
     
     node->type = t;
@@ -26,32 +31,205 @@ DAGNode* dag_node_create(TokenType t, TaxonomyCategory cat) {
     node->out_edges = NULL;
     node->in_count = 0;
     node->out_count = 0;
+    node->ord = atomic_fetch_add_explicit(&dag_next_ord, 1, memory_order_relaxed);
+    node->id = node->ord;
     
     return node;
 }
 
-void dag_add_edge(DAGNode *from, DAGNode *to, float weight) {
-    if (!from || !to) return;
+void dag_node_destroy(DAGNode *node) {
+    if (!node) return;
     
-    // Allocate/reallocate outgoing edge array
-    from->out_edges = (DAGEdge*)realloc(from->out_edges, 
-                                       (from->out_count + 1) * sizeof(DAGEdge));
-    if (!from->out_edges) return;
+    axl_free(node->in_edges);
+    axl_free(node->out_edges);
+    axl_free(node);
+}
+
+/* ---------------------------------------------------------------------------
+ * Online topological order (Pearce–Kelly)
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    DAGNode **items;
+    size_t    count;
+    size_t    capacity;
+} DAGNodeList;
+
+static bool node_list_push(DAGNodeList *list, DAGNode *node) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 32;
+        DAGNode **items = (DAGNode**)realloc(list->items, capacity * sizeof(DAGNode*));
+        if (!items) return false;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = node;
+    return true;
+}
+
+static int node_ord_compare(const void *a, const void *b) {
+    size_t oa = (*(DAGNode * const *)a)->ord;
+    size_t ob = (*(DAGNode * const *)b)->ord;
+    return (oa > ob) - (oa < ob);
+}
+
+/**
+ * Collect into `found` every node reachable from `start` (forward along
+ * out-edges, or backward along in-edges) whose ord lies strictly inside
+ * (lb, ub). Returns DAG_ERR_CYCLE if the forward search meets `stop`.
+ */
+static int dag_pk_search(DAGNode *start, bool forward, size_t lb, size_t ub,
+                         const DAGNode *stop, DAGNodeList *stack, DAGNodeList *found) {
+    // A node is marked exactly while it is on `stack` or in `found`
+    stack->count = 0;
+    if (!node_list_push(stack, start)) return DAG_ERR_NOMEM;
+    start->mark = true;
+
+    while (stack->count > 0) {
+        DAGNode *node = stack->items[--stack->count];
+        if (!node_list_push(found, node)) {
+            node->mark = false;
+            return DAG_ERR_NOMEM;
+        }
+
+        DAGEdge *edges = forward ? node->out_edges : node->in_edges;
+        size_t count = forward ? node->out_count : node->in_count;
+        for (size_t i = 0; i < count; i++) {
+            DAGNode *next = edges[i].target;
+            if (next == stop) return DAG_ERR_CYCLE;
+            if (next->mark || next->ord <= lb || next->ord >= ub) continue;
+
+            if (!node_list_push(stack, next)) return DAG_ERR_NOMEM;
+            next->mark = true;
+        }
+    }
+    return DAG_OK;
+}
+
+/// Restore ord(from) < ord(to) by renumbering only the affected region.
+static int dag_pk_reorder(DAGNode *from, DAGNode *to) {
+    size_t lb = to->ord;
+    size_t ub = from->ord;
+    DAGNodeList stack = {0}, delta_f = {0}, delta_b = {0};
+
+    // Forward from `to` within the region; reaching `from` means a cycle
+    int status = dag_pk_search(to, true, lb, ub, from, &stack, &delta_f);
+    if (status == DAG_OK) {
+        status = dag_pk_search(from, false, lb, ub, NULL, &stack, &delta_b);
+    }
+
+    size_t total = delta_f.count + delta_b.count;
+    size_t *pool = status == DAG_OK ? (size_t*)malloc(total * sizeof(size_t)) : NULL;
+    if (status == DAG_OK && !pool) status = DAG_ERR_NOMEM;
+
+    if (status == DAG_OK) {
+        // Everything reaching `from` goes first, then everything `to`
+        // reaches, reusing the same set of ord values
+        qsort(delta_b.items, delta_b.count, sizeof(DAGNode*), node_ord_compare);
+        qsort(delta_f.items, delta_f.count, sizeof(DAGNode*), node_ord_compare);
+
+        size_t b = 0, f = 0, k = 0;
+        while (b < delta_b.count || f < delta_f.count) {
+            if (f == delta_f.count ||
+                (b < delta_b.count && delta_b.items[b]->ord < delta_f.items[f]->ord)) {
+                pool[k++] = delta_b.items[b++]->ord;
+            } else {
+                pool[k++] = delta_f.items[f++]->ord;
+            }
+        }
+
+        k = 0;
+        for (size_t i = 0; i < delta_b.count; i++) delta_b.items[i]->ord = pool[k++];
+        for (size_t i = 0; i < delta_f.count; i++) delta_f.items[i]->ord = pool[k++];
+    }
+
+    for (size_t i = 0; i < delta_f.count; i++) delta_f.items[i]->mark = false;
+    for (size_t i = 0; i < delta_b.count; i++) delta_b.items[i]->mark = false;
+    for (size_t i = 0; i < stack.count; i++) stack.items[i]->mark = false;
+
+    free(pool);
+    free(stack.items);
+    free(delta_f.items);
+    free(delta_b.items);
+    return status;
+}
+
+int dag_add_edge(DAGNode *from, DAGNode *to, float weight) {
+    if (!from || !to) return DAG_ERR_INVALID;
+    if (from == to) return DAG_ERR_CYCLE;
     
-    // Allocate/reallocate incoming edge array
-    to->in_edges = (DAGEdge*)realloc(to->in_edges, 
-                                    (to->in_count + 1) * sizeof(DAGEdge));
-    if (!to->in_edges) return;
+    // Only edges against the current order need any work
+    if (from->ord > to->ord) {
+        int status = dag_pk_reorder(from, to);
+        if (status != DAG_OK) return status;
+    }
+    
+    // Grow both arrays before linking so a failure leaves no half-edge
+    DAGEdge *out_edges = (DAGEdge*)axl_realloc(from->out_edges,
+                                               (from->out_count + 1) * sizeof(DAGEdge),
+                                               AXL_MEM_DAG_EDGE);
+    if (!out_edges) return DAG_ERR_NOMEM;
+    from->out_edges = out_edges;
+    
+    DAGEdge *in_edges = (DAGEdge*)axl_realloc(to->in_edges,
+                                              (to->in_count + 1) * sizeof(DAGEdge),
+                                              AXL_MEM_DAG_EDGE);
+    if (!in_edges) return DAG_ERR_NOMEM;
+    to->in_edges = in_edges;
     
     // Set up the new outgoing edge
     from->out_edges[from->out_count].target = to;
     from->out_edges[from->out_count].weight = weight;
     from->out_count++;
     
-    // Set up the new incoming edge
+    // Set up the new incoming edge (target holds the source node)
     to->in_edges[to->in_count].target = from;
     to->in_edges[to->in_count].weight = weight;
     to->in_count++;
+    
+    return DAG_OK;
+}
+
+size_t dag_memory_footprint(DAGNode *nodes[], size_t node_count) {
+    if (!nodes) return 0;
+    
+    size_t bytes = 0;
+    for (size_t i = 0; i < node_count; i++) {
+        if (!nodes[i]) continue;
+        bytes += sizeof(DAGNode);
+        bytes += nodes[i]->in_count * sizeof(DAGEdge);
+        bytes += nodes[i]->out_count * sizeof(DAGEdge);
+    }
+    return bytes;
+}
+
+static void resolve_node(DAGNode *node) {
+    // Default to true for root nodes (no incoming edges)
+    if (node->in_count == 0) {
+        node->state = STATE_TRUE;
+        return;
+    }
+    
+    // Sources precede `node` in the order, so their states are final
+    float true_weight = 0.0f;
+    float false_weight = 0.0f;
+    for (size_t i = 0; i < node->in_count; i++) {
+        const DAGNode *source = node->in_edges[i].target;
+        if (source->state == STATE_TRUE) {
+            true_weight += node->in_edges[i].weight;
+        } else if (source->state == STATE_FALSE) {
+            false_weight += node->in_edges[i].weight;
+        }
+    }
+    
+    if (true_weight > false_weight) {
+        node->state = STATE_TRUE;
+    } else if (false_weight > true_weight) {
+        node->state = STATE_FALSE;
+    } else {
+        // Equal weights or no resolved inputs
+        node->state = STATE_UNKNOWN;
+    }
 }
 
 void dag_resolve(DAGNode *nodes[], size_t node_count) {
@@ -59,99 +237,209 @@ void dag_resolve(DAGNode *nodes[], size_t node_count) {
         return;
     }
     
-    // Track visited and resolved states for topological sort
-    bool *visited = (bool *)calloc(node_count, sizeof(bool));
-    bool *resolved = (bool *)calloc(node_count, sizeof(bool));
+    // Arrays built in creation order are usually already sorted by ord
+    // and are walked as they are
+    bool ordered = true;
+    for (size_t i = 1; i < node_count && ordered; i++) {
+        ordered = nodes[i - 1]->ord < nodes[i]->ord;
+    }
     
-    if (!visited || !resolved) {
-        free(visited);
-        free(resolved);
+    if (ordered) {
+        for (size_t i = 0; i < node_count; i++) {
+            resolve_node(nodes[i]);
+        }
         return;
     }
     
-    // Perform depth-first topological resolution
+    DAGNode **order = (DAGNode**)malloc(node_count * sizeof(DAGNode*));
+    if (!order) return;
+    
+    memcpy(order, nodes, node_count * sizeof(DAGNode*));
+    qsort(order, node_count, sizeof(DAGNode*), node_ord_compare);
     for (size_t i = 0; i < node_count; i++) {
-        if (!visited[i]) {
-            resolve_node_recursive(nodes, node_count, i, visited, resolved);
+        resolve_node(order[i]);
+    }
+    free(order);
+}
+
+/* ---------------------------------------------------------------------------
+ * Hash-consing
+ * ------------------------------------------------------------------------- */
+
+#define DAG_CONS_INITIAL_CAPACITY 64
+
+typedef struct {
+    uint64_t  hash;
+    DAGNode  *node;
+} DAGConsEntry;
+
+struct DAGConsTable {
+    DAGConsEntry *entries;
+    size_t        capacity;        // Power of two
+    size_t        count;
+    DAGConsStats  stats;
+};
+
+// Orders by source id, not address: addresses differ from run to run,
+// and ord is renumbered when edges are added to the sources later
+static int dag_edge_compare(const void *a, const void *b) {
+    const DAGEdge *ea = (const DAGEdge *)a;
+    const DAGEdge *eb = (const DAGEdge *)b;
+    size_t ia = ea->target->id;
+    size_t ib = eb->target->id;
+
+    if (ia != ib) return ia < ib ? -1 : 1;
+    if (ea->weight != eb->weight) return ea->weight < eb->weight ? -1 : 1;
+    return 0;
+}
+
+static uint64_t dag_cons_hash(TokenType t, TaxonomyCategory cat,
+                              const DAGEdge *edges, size_t count) {
+    uint64_t h = 1469598103934665603ull;
+    h = (h ^ (uint64_t)t) * 1099511628211ull;
+    h = (h ^ (uint64_t)cat) * 1099511628211ull;
+    h = (h ^ (uint64_t)count) * 1099511628211ull;
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t weight_bits;
+        memcpy(&weight_bits, &edges[i].weight, sizeof(weight_bits));
+        h = (h ^ (uint64_t)edges[i].target->id) * 1099511628211ull;
+        h = (h ^ weight_bits) * 1099511628211ull;
+    }
+
+    return h;
+}
+
+static bool dag_cons_equal(const DAGNode *node, TokenType t, TaxonomyCategory cat,
+                           const DAGEdge *edges, size_t count) {
+    if (node->type != t || node->category != cat || node->in_count != count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (node->in_edges[i].target != edges[i].target ||
+            node->in_edges[i].weight != edges[i].weight) {
+            return false;
         }
     }
-    
-    free(visited);
-    free(resolved);
+    return true;
 }
 
-static void resolve_node_recursive(DAGNode *nodes[], size_t node_count, 
-                                  size_t current, bool *visited, bool *resolved) {
-    visited[current] = true;
-    
-    // Process all outgoing edges
-    DAGNode *node = nodes[current];
-    for (size_t i = 0; i < node->out_count; i++) {
-        // Find index of the target node
-        DAGNode *target = node->out_edges[i].target;
-        size_t target_idx = 0;
-        
-        // Find the index of this target node in our nodes array
-        for (size_t j = 0; j < node_count; j++) {
-            if (nodes[j] == target) {
-                target_idx = j;
-                break;
-            }
+static bool dag_cons_grow(DAGConsTable *table) {
+    size_t capacity = table->capacity * 2;
+    DAGConsEntry *entries = (DAGConsEntry *)calloc(capacity, sizeof(DAGConsEntry));
+    if (!entries) return false;
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        DAGConsEntry *e = &table->entries[i];
+        if (!e->node) continue;
+
+        size_t slot = (size_t)e->hash & (capacity - 1);
+        while (entries[slot].node) {
+            slot = (slot + 1) & (capacity - 1);
         }
-        
-        // Recursive resolution of dependencies
-        if (!visited[target_idx]) {
-            resolve_node_recursive(nodes, node_count, target_idx, visited, resolved);
+        entries[slot] = *e;
+    }
+
+    free(table->entries);
+    table->entries = entries;
+    table->capacity = capacity;
+    return true;
+}
+
+DAGConsTable* dag_cons_create(void) {
+    DAGConsTable *table = (DAGConsTable *)calloc(1, sizeof(DAGConsTable));
+    if (!table) return NULL;
+
+    table->entries = (DAGConsEntry *)calloc(DAG_CONS_INITIAL_CAPACITY, sizeof(DAGConsEntry));
+    if (!table->entries) {
+        free(table);
+        return NULL;
+    }
+    table->capacity = DAG_CONS_INITIAL_CAPACITY;
+
+    return table;
+}
+
+DAGNode* dag_node_intern(DAGConsTable *table,
+                         TokenType t,
+                         TaxonomyCategory cat,
+                         const DAGEdge *in_edges,
+                         size_t in_count) {
+    if (!table || (in_count > 0 && !in_edges)) {
+        return NULL;
+    }
+
+    // Canonicalize: edge order must not affect identity
+    DAGEdge *sorted = NULL;
+    if (in_count > 0) {
+        sorted = (DAGEdge *)malloc(in_count * sizeof(DAGEdge));
+        if (!sorted) return NULL;
+        memcpy(sorted, in_edges, in_count * sizeof(DAGEdge));
+        qsort(sorted, in_count, sizeof(DAGEdge), dag_edge_compare);
+    }
+
+    uint64_t hash = dag_cons_hash(t, cat, sorted, in_count);
+    size_t slot = (size_t)hash & (table->capacity - 1);
+
+    while (table->entries[slot].node) {
+        DAGConsEntry *e = &table->entries[slot];
+        if (e->hash == hash && dag_cons_equal(e->node, t, cat, sorted, in_count)) {
+            table->stats.shared++;
+            free(sorted);
+            return e->node;
         }
+        slot = (slot + 1) & (table->capacity - 1);
     }
-    
-    // Now resolve this node's truth value
-    if (!resolved[current]) {
-        // Default to true for root nodes (no incoming edges)
-        if (node->in_count == 0) {
-            node->state = STATE_TRUE;
-        } else {
-            // Determine truth based on weighted incoming edges
-            float true_weight = 0.0f;
-            float false_weight = 0.0f;
-            
-            for (size_t i = 0; i < node->in_count; i++) {
-                // Find the source node
-                DAGNode *source = NULL;
-                
-                // Search for the source node that has this edge
-                for (size_t j = 0; j < node_count; j++) {
-                    for (size_t k = 0; k < nodes[j]->out_count; k++) {
-                        if (nodes[j]->out_edges[k].target == node) {
-                            source = nodes[j];
-                            break;
-                        }
-                    }
-                    if (source) break;
-                }
-                
-                if (!source) continue;
-                
-                // Accumulate weighted influence from source nodes
-                float edge_weight = node->in_edges[i].weight;
-                if (source->state == STATE_TRUE) {
-                    true_weight += edge_weight;
-                } else if (source->state == STATE_FALSE) {
-                    false_weight += edge_weight;
-                }
-            }
-            
-            // Final truth determination based on weighted influences
-            if (true_weight > false_weight) {
-                node->state = STATE_TRUE;
-            } else if (false_weight > true_weight) {
-                node->state = STATE_FALSE;
-            } else {
-                // Equal weights or no resolved inputs
-                node->state = STATE_UNKNOWN;
+
+    DAGNode *node = dag_node_create(t, cat);
+    if (!node) {
+        free(sorted);
+        return NULL;
+    }
+
+    // Linking in sorted order keeps node->in_edges canonical for dag_cons_equal.
+    // `node` is newer than every source, so no edge needs reordering
+    for (size_t i = 0; i < in_count; i++) {
+        if (dag_add_edge(sorted[i].target, node, sorted[i].weight) != DAG_OK) {
+            // Each linked edge is the last out-edge of its source
+            while (i-- > 0) {
+                sorted[i].target->out_count--;
             }
+            dag_node_destroy(node);
+            free(sorted);
+            return NULL;
         }
-        
-        resolved[current] = true;
     }
+    free(sorted);
+    table->stats.created++;
+
+    // Keep the load factor at or below 1/2 so every probe meets an empty
+    // slot. If the table cannot grow, the node is returned uninterned:
+    // later duplicates are not shared with it, which is only less compact
+    if ((table->count + 1) * 2 > table->capacity) {
+        if (!dag_cons_grow(table)) return node;
+
+        slot = (size_t)hash & (table->capacity - 1);
+        while (table->entries[slot].node) {
+            slot = (slot + 1) & (table->capacity - 1);
+        }
+    }
+
+    table->entries[slot].hash = hash;
+    table->entries[slot].node = node;
+    table->count++;
+
+    return node;
+}
+
+DAGConsStats dag_cons_stats(const DAGConsTable *table) {
+    DAGConsStats empty = {0};
+    return table ? table->stats : empty;
+}
+
+void dag_cons_destroy(DAGConsTable *table) {
+    if (!table) return;
+
+    free(table->entries);
+    free(table);
 }
@@ -0,0 +1,466 @@
+// src/core/dag/csr.c
+#include <axl/core/dag/csr.h>
+#include <axl/core/utils/memory.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ---------------------------------------------------------------------------
+ * Pointer -> node id map (open addressing)
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    const DAGNode **keys;
+    uint32_t       *values;
+    size_t          capacity;      // Power of two
+} DAGPtrMap;
+
+static size_t ptr_hash(const DAGNode *p) {
+    uint64_t x = (uint64_t)(uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+static bool ptr_map_init(DAGPtrMap *map, size_t count) {
+    map->capacity = 16;
+    while (map->capacity < count * 2) map->capacity <<= 1;
+
+    map->keys = (const DAGNode **)calloc(map->capacity, sizeof(*map->keys));
+    map->values = (uint32_t *)malloc(map->capacity * sizeof(*map->values));
+    return map->keys && map->values;
+}
+
+static void ptr_map_free(DAGPtrMap *map) {
+    free(map->keys);
+    free(map->values);
+}
+
+/// Insert `key` if absent. Returns false if it was already present.
+static bool ptr_map_insert(DAGPtrMap *map, const DAGNode *key, uint32_t value) {
+    size_t slot = ptr_hash(key) & (map->capacity - 1);
+    while (map->keys[slot]) {
+        if (map->keys[slot] == key) return false;
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+    map->keys[slot] = key;
+    map->values[slot] = value;
+    return true;
+}
+
+static bool ptr_map_find(const DAGPtrMap *map, const DAGNode *key, uint32_t *value) {
+    size_t slot = ptr_hash(key) & (map->capacity - 1);
+    while (map->keys[slot]) {
+        if (map->keys[slot] == key) {
+            *value = map->values[slot];
+            return true;
+        }
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+    return false;
+}
+
+/* ---------------------------------------------------------------------------
+ * Freezing
+ * ------------------------------------------------------------------------- */
+
+/// Round `n` up so the following array starts suitably aligned.
+static size_t csr_align(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+size_t dag_csr_block_bytes(size_t node_count, size_t edge_count) {
+    size_t offsets_size = csr_align((node_count + 1) * sizeof(uint32_t));
+    size_t edges_u32 = csr_align(edge_count * sizeof(uint32_t));
+    size_t edges_f32 = csr_align(edge_count * sizeof(float));
+    size_t attrs_size = csr_align(node_count);
+    return csr_align(sizeof(DAGCsr)) + 2 * offsets_size + 2 * edges_u32 + edges_f32 + 3 * attrs_size;
+}
+
+/// Allocate a CSR with room for the given counts. Arrays read on every
+/// resolve (in-edges, weights, states) come first and share as few
+/// pages as possible; out-edges and the cold type/category arrays follow.
+static DAGCsr* csr_allocate(size_t node_count, size_t edge_count) {
+    size_t offsets_size = csr_align((node_count + 1) * sizeof(uint32_t));
+    size_t edges_u32 = csr_align(edge_count * sizeof(uint32_t));
+    size_t edges_f32 = csr_align(edge_count * sizeof(float));
+    size_t attrs_size = csr_align(node_count);
+    size_t bytes = dag_csr_block_bytes(node_count, edge_count);
+
+    char *block = (char *)axl_malloc(bytes, AXL_MEM_CSR);
+    if (!block) return NULL;
+
+    DAGCsr *csr = (DAGCsr *)block;
+    char *p = block + csr_align(sizeof(DAGCsr));
+    csr->in_offsets  = (uint32_t *)p; p += offsets_size;
+    csr->in_sources  = (uint32_t *)p; p += edges_u32;
+    csr->in_weights  = (float *)p;    p += edges_f32;
+    csr->states      = (uint8_t *)p;  p += attrs_size;
+    csr->out_offsets = (uint32_t *)p; p += offsets_size;
+    csr->out_targets = (uint32_t *)p; p += edges_u32;
+    csr->types       = (uint8_t *)p;  p += attrs_size;
+    csr->categories  = (uint8_t *)p;
+    csr->node_count = (uint32_t)node_count;
+    csr->edge_count = (uint32_t)edge_count;
+    csr->sorted = false;
+    csr->bytes = bytes;
+    return csr;
+}
+
+/// Derive the outgoing edges from the incoming ones, so both views agree.
+static bool csr_build_out_edges(DAGCsr *csr) {
+    uint32_t n = csr->node_count;
+    uint32_t e = csr->in_offsets[n];
+
+    memset(csr->out_offsets, 0, ((size_t)n + 1) * sizeof(uint32_t));
+    for (uint32_t k = 0; k < e; k++) {
+        csr->out_offsets[csr->in_sources[k] + 1]++;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        csr->out_offsets[i + 1] += csr->out_offsets[i];
+    }
+
+    uint32_t *cursor = (uint32_t *)malloc(((size_t)n + 1) * sizeof(uint32_t));
+    if (!cursor) return false;
+    memcpy(cursor, csr->out_offsets, (size_t)n * sizeof(uint32_t));
+
+    for (uint32_t v = 0; v < n; v++) {
+        for (uint32_t k = csr->in_offsets[v]; k < csr->in_offsets[v + 1]; k++) {
+            csr->out_targets[cursor[csr->in_sources[k]]++] = v;
+        }
+    }
+
+    free(cursor);
+    return true;
+}
+
+/// True if every edge goes from a lower id to a higher one.
+static bool csr_is_sorted(const DAGCsr *csr) {
+    for (uint32_t v = 0; v < csr->node_count; v++) {
+        for (uint32_t k = csr->in_offsets[v]; k < csr->in_offsets[v + 1]; k++) {
+            if (csr->in_sources[k] >= v) return false;
+        }
+    }
+    return true;
+}
+
+DAGCsr* dag_freeze(DAGNode *nodes[], size_t node_count) {
+    if (!nodes || node_count >= UINT32_MAX) {
+        return NULL;
+    }
+
+    DAGPtrMap ids;
+    if (!ptr_map_init(&ids, node_count)) {
+        ptr_map_free(&ids);
+        return NULL;
+    }
+
+    size_t edge_count = 0;
+    for (size_t i = 0; i < node_count; i++) {
+        if (!nodes[i] || !ptr_map_insert(&ids, nodes[i], (uint32_t)i)) {
+            ptr_map_free(&ids);
+            return NULL;
+        }
+        edge_count += nodes[i]->in_count;
+    }
+    if (edge_count >= UINT32_MAX) {
+        ptr_map_free(&ids);
+        return NULL;
+    }
+
+    DAGCsr *csr = csr_allocate(node_count, edge_count);
+    if (!csr) {
+        ptr_map_free(&ids);
+        return NULL;
+    }
+
+    // Incoming edges, in node order
+    uint32_t e = 0;
+    for (size_t i = 0; i < node_count; i++) {
+        const DAGNode *node = nodes[i];
+        csr->in_offsets[i] = e;
+        csr->types[i] = (uint8_t)node->type;
+        csr->categories[i] = (uint8_t)node->category;
+        csr->states[i] = (uint8_t)node->state;
+
+        for (size_t k = 0; k < node->in_count; k++) {
+            uint32_t source;
+            if (!ptr_map_find(&ids, node->in_edges[k].target, &source)) {
+                goto fail;
+            }
+            csr->in_sources[e] = source;
+            csr->in_weights[e] = node->in_edges[k].weight;
+            e++;
+        }
+    }
+    csr->in_offsets[node_count] = e;
+
+    if (!csr_build_out_edges(csr)) goto fail;
+    csr->sorted = csr_is_sorted(csr);
+
+    ptr_map_free(&ids);
+    return csr;
+
+fail:
+    axl_free(csr);
+    ptr_map_free(&ids);
+    return NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ * Resolution
+ * ------------------------------------------------------------------------- */
+
+static TruthValue csr_resolve_node(const DAGCsr *csr, uint32_t v) {
+    uint32_t begin = csr->in_offsets[v];
+    uint32_t end = csr->in_offsets[v + 1];
+
+    // Default to true for root nodes (no incoming edges)
+    if (begin == end) {
+        return STATE_TRUE;
+    }
+
+    float true_weight = 0.0f;
+    float false_weight = 0.0f;
+    for (uint32_t k = begin; k < end; k++) {
+        uint8_t source_state = csr->states[csr->in_sources[k]];
+        if (source_state == STATE_TRUE) {
+            true_weight += csr->in_weights[k];
+        } else if (source_state == STATE_FALSE) {
+            false_weight += csr->in_weights[k];
+        }
+    }
+
+    if (true_weight > false_weight) return STATE_TRUE;
+    if (false_weight > true_weight) return STATE_FALSE;
+    return STATE_UNKNOWN;
+}
+
+int dag_csr_resolve(DAGCsr *csr) {
+    if (!csr) return -1;
+
+    uint32_t n = csr->node_count;
+
+    // Ids already in topological order: one sequential sweep
+    if (csr->sorted) {
+        for (uint32_t v = 0; v < n; v++) {
+            csr->states[v] = (uint8_t)csr_resolve_node(csr, v);
+        }
+        return 0;
+    }
+
+    uint32_t *pending = (uint32_t *)malloc(n * sizeof(uint32_t));
+    uint32_t *queue = (uint32_t *)malloc(n * sizeof(uint32_t));
+    if (!pending || !queue) {
+        free(pending);
+        free(queue);
+        return -1;
+    }
+
+    // Kahn's algorithm: a node resolves once all of its sources have
+    uint32_t head = 0, tail = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        pending[v] = csr->in_offsets[v + 1] - csr->in_offsets[v];
+        csr->states[v] = STATE_UNKNOWN;
+        if (pending[v] == 0) queue[tail++] = v;
+    }
+
+    while (head < tail) {
+        uint32_t v = queue[head++];
+        csr->states[v] = (uint8_t)csr_resolve_node(csr, v);
+
+        for (uint32_t k = csr->out_offsets[v]; k < csr->out_offsets[v + 1]; k++) {
+            uint32_t target = csr->out_targets[k];
+            if (--pending[target] == 0) queue[tail++] = target;
+        }
+    }
+
+    free(pending);
+    free(queue);
+    return tail == n ? 0 : 1;
+}
+
+uint32_t* dag_csr_topological_order(const DAGCsr *csr, uint32_t *count) {
+    if (!csr || !count) return NULL;
+
+    uint32_t n = csr->node_count;
+    uint32_t *order = (uint32_t *)malloc(((size_t)n + 1) * sizeof(uint32_t));
+    if (order && csr->sorted) {
+        for (uint32_t v = 0; v < n; v++) order[v] = v;
+        *count = n;
+        return order;
+    }
+
+    uint32_t *pending = (uint32_t *)malloc(((size_t)n + 1) * sizeof(uint32_t));
+    if (!order || !pending) {
+        free(order);
+        free(pending);
+        return NULL;
+    }
+
+    uint32_t head = 0, tail = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        pending[v] = csr->in_offsets[v + 1] - csr->in_offsets[v];
+        if (pending[v] == 0) order[tail++] = v;
+    }
+    while (head < tail) {
+        uint32_t v = order[head++];
+        for (uint32_t k = csr->out_offsets[v]; k < csr->out_offsets[v + 1]; k++) {
+            uint32_t target = csr->out_targets[k];
+            if (--pending[target] == 0) order[tail++] = target;
+        }
+    }
+
+    free(pending);
+    *count = tail;
+    return order;
+}
+
+/* ---------------------------------------------------------------------------
+ * Locality reordering
+ * ------------------------------------------------------------------------- */
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/// Reverse Cuthill–McKee over the undirected graph: breadth-first from a
+/// minimum-degree node of each component, neighbours by ascending degree,
+/// then reversed. Keeps each node's neighbours within a narrow id band.
+static uint32_t* csr_rcm_order(const DAGCsr *csr) {
+    uint32_t n = csr->node_count;
+    uint32_t *order = (uint32_t *)malloc((size_t)n * sizeof(uint32_t));
+    uint64_t *keys = (uint64_t *)malloc((size_t)n * sizeof(uint64_t));
+    uint64_t *scratch = (uint64_t *)malloc((size_t)n * sizeof(uint64_t));
+    bool *visited = (bool *)calloc(n, sizeof(bool));
+    if (!order || !keys || !scratch || !visited) {
+        free(order);
+        free(keys);
+        free(scratch);
+        free(visited);
+        return NULL;
+    }
+
+    // (degree, id) pairs sort by degree, then id
+    for (uint32_t v = 0; v < n; v++) {
+        uint64_t degree = (uint64_t)(csr->in_offsets[v + 1] - csr->in_offsets[v]) +
+                          (csr->out_offsets[v + 1] - csr->out_offsets[v]);
+        keys[v] = degree << 32 | v;
+    }
+    qsort(keys, n, sizeof(uint64_t), compare_u64);
+
+    uint32_t head = 0, tail = 0;
+    for (uint32_t s = 0; s < n; s++) {
+        uint32_t start = (uint32_t)keys[s];
+        if (visited[start]) continue;
+        visited[start] = true;
+        order[tail++] = start;
+
+        while (head < tail) {
+            uint32_t v = order[head++];
+            uint32_t found = 0;
+
+            for (int dir = 0; dir < 2; dir++) {
+                const uint32_t *offsets = dir ? csr->out_offsets : csr->in_offsets;
+                const uint32_t *targets = dir ? csr->out_targets : csr->in_sources;
+
+                for (uint32_t k = offsets[v]; k < offsets[v + 1]; k++) {
+                    uint32_t u = targets[k];
+                    if (visited[u]) continue;
+                    visited[u] = true;
+                    uint64_t degree = (uint64_t)(csr->in_offsets[u + 1] - csr->in_offsets[u]) +
+                                      (csr->out_offsets[u + 1] - csr->out_offsets[u]);
+                    scratch[found++] = degree << 32 | u;
+                }
+            }
+
+            qsort(scratch, found, sizeof(uint64_t), compare_u64);
+            for (uint32_t i = 0; i < found; i++) {
+                order[tail++] = (uint32_t)scratch[i];
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < n / 2; i++) {
+        uint32_t t = order[i];
+        order[i] = order[n - 1 - i];
+        order[n - 1 - i] = t;
+    }
+
+    free(keys);
+    free(scratch);
+    free(visited);
+    return order;
+}
+
+uint32_t* dag_csr_locality_order(const DAGCsr *csr, DAGOrderKind kind) {
+    if (!csr || csr->node_count == 0) return NULL;
+
+    if (kind == DAG_ORDER_RCM) return csr_rcm_order(csr);
+
+    // Kahn's FIFO order visits the DAG level by level
+    uint32_t count;
+    uint32_t *order = dag_csr_topological_order(csr, &count);
+    if (order && count < csr->node_count) {
+        free(order);
+        return NULL;
+    }
+    return order;
+}
+
+DAGCsr* dag_csr_reorder(const DAGCsr *csr, const uint32_t *order) {
+    if (!csr || !order || csr->node_count == 0) return NULL;
+
+    uint32_t n = csr->node_count;
+    uint32_t *rank = (uint32_t *)malloc((size_t)n * sizeof(uint32_t));
+    if (!rank) return NULL;
+
+    // Invert the order, rejecting anything that is not a permutation
+    memset(rank, 0xff, (size_t)n * sizeof(uint32_t));
+    for (uint32_t u = 0; u < n; u++) {
+        if (order[u] >= n || rank[order[u]] != UINT32_MAX) {
+            free(rank);
+            return NULL;
+        }
+        rank[order[u]] = u;
+    }
+
+    DAGCsr *reordered = csr_allocate(n, csr->edge_count);
+    if (!reordered) {
+        free(rank);
+        return NULL;
+    }
+
+    uint32_t e = 0;
+    for (uint32_t u = 0; u < n; u++) {
+        uint32_t v = order[u];
+        reordered->in_offsets[u] = e;
+        reordered->types[u] = csr->types[v];
+        reordered->categories[u] = csr->categories[v];
+        reordered->states[u] = csr->states[v];
+
+        // In-edges keep their order: resolution sums weights in edge
+        // order, and float sums are not associative
+        for (uint32_t k = csr->in_offsets[v]; k < csr->in_offsets[v + 1]; k++) {
+            reordered->in_sources[e] = rank[csr->in_sources[k]];
+            reordered->in_weights[e] = csr->in_weights[k];
+            e++;
+        }
+    }
+    reordered->in_offsets[n] = e;
+    free(rank);
+
+    if (!csr_build_out_edges(reordered)) {
+        axl_free(reordered);
+        return NULL;
+    }
+    reordered->sorted = csr_is_sorted(reordered);
+    return reordered;
+}
+
+void dag_csr_destroy(DAGCsr *csr) {
+    // The header and all arrays share a single allocation
+    axl_free(csr);
+}
@@ -0,0 +1,223 @@
+// src/core/dag/overlay.c
+#include <axl/core/dag/overlay.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void dag_overlay_init(DAGOverlay *overlay) {
+    if (overlay) memset(overlay, 0, sizeof(*overlay));
+}
+
+bool dag_overlay_set(DAGOverlay *overlay, uint32_t node,
+                     TruthValue state, const void *binding) {
+    if (!overlay) return false;
+
+    for (size_t i = 0; i < overlay->count; i++) {
+        if (overlay->entries[i].node == node) {
+            overlay->entries[i].state = state;
+            overlay->entries[i].binding = binding;
+            return true;
+        }
+    }
+
+    if (overlay->count == overlay->capacity) {
+        size_t capacity = overlay->capacity ? overlay->capacity * 2 : 8;
+        DAGOverlayEntry *entries = (DAGOverlayEntry *)realloc(overlay->entries,
+                                                              capacity * sizeof(DAGOverlayEntry));
+        if (!entries) return false;
+        overlay->entries = entries;
+        overlay->capacity = capacity;
+    }
+
+    DAGOverlayEntry *entry = &overlay->entries[overlay->count++];
+    entry->node = node;
+    entry->state = state;
+    entry->binding = binding;
+    return true;
+}
+
+void dag_overlay_free(DAGOverlay *overlay) {
+    if (!overlay) return;
+    free(overlay->entries);
+    memset(overlay, 0, sizeof(*overlay));
+}
+
+/// Resolve with a caller-provided `pinned` scratch bitmap (node_count bits).
+static DAGVariantResult overlay_resolve(const DAGCsr *csr,
+                                        const uint32_t *order,
+                                        uint32_t order_count,
+                                        const DAGOverlay *overlay,
+                                        uint8_t *states,
+                                        uint64_t *pinned) {
+    DAGVariantResult result = {0};
+    uint32_t n = csr->node_count;
+
+    memset(states, STATE_UNKNOWN, n);
+    memset(pinned, 0, ((n + 63) / 64) * sizeof(uint64_t));
+
+    if (overlay) {
+        for (size_t i = 0; i < overlay->count; i++) {
+            const DAGOverlayEntry *entry = &overlay->entries[i];
+            if (entry->node >= n || entry->state == STATE_UNKNOWN) continue;
+            states[entry->node] = (uint8_t)entry->state;
+            pinned[entry->node / 64] |= 1ull << (entry->node % 64);
+        }
+    }
+
+    for (uint32_t i = 0; i < order_count; i++) {
+        uint32_t v = order ? order[i] : i;
+        if (pinned[v / 64] & (1ull << (v % 64))) continue;
+
+        uint32_t begin = csr->in_offsets[v];
+        uint32_t end = csr->in_offsets[v + 1];
+
+        // Default to true for root nodes (no incoming edges)
+        if (begin == end) {
+            states[v] = STATE_TRUE;
+            continue;
+        }
+
+        float true_weight = 0.0f;
+        float false_weight = 0.0f;
+        for (uint32_t k = begin; k < end; k++) {
+            uint8_t source_state = states[csr->in_sources[k]];
+            if (source_state == STATE_TRUE) {
+                true_weight += csr->in_weights[k];
+            } else if (source_state == STATE_FALSE) {
+                false_weight += csr->in_weights[k];
+            }
+        }
+
+        if (true_weight > false_weight) states[v] = STATE_TRUE;
+        else if (false_weight > true_weight) states[v] = STATE_FALSE;
+    }
+
+    for (uint32_t v = 0; v < n; v++) {
+        if (states[v] == STATE_TRUE) result.true_count++;
+        else if (states[v] == STATE_FALSE) result.false_count++;
+        else result.unknown_count++;
+    }
+    result.ok = (order_count == n);
+    return result;
+}
+
+DAGVariantResult dag_overlay_resolve(const DAGCsr *csr,
+                                     const uint32_t *order,
+                                     uint32_t order_count,
+                                     const DAGOverlay *overlay,
+                                     uint8_t *states) {
+    DAGVariantResult failed = {0};
+    if (!csr || (!order && !csr->sorted) || !states) return failed;
+
+    uint64_t *pinned = (uint64_t *)malloc(((csr->node_count + 63) / 64) * sizeof(uint64_t) + 1);
+    if (!pinned) return failed;
+
+    DAGVariantResult result = overlay_resolve(csr, order, order_count, overlay, states, pinned);
+    free(pinned);
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * Parallel variant evaluation
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    const DAGCsr      *csr;
+    const uint32_t    *order;
+    uint32_t           order_count;
+    const DAGOverlay  *overlays;
+    size_t             variant_count;
+    uint8_t          **states;
+    DAGVariantResult  *results;
+    atomic_size_t      next;       // Next variant to claim
+} VariantJob;
+
+static void* variant_worker(void *arg) {
+    VariantJob *job = (VariantJob *)arg;
+    uint32_t n = job->csr->node_count;
+
+    // Scratch is per worker; only caller-visible output is per variant
+    uint64_t *pinned = (uint64_t *)malloc(((n + 63) / 64) * sizeof(uint64_t) + 1);
+    uint8_t *scratch = (uint8_t *)malloc(n + 1);
+    if (!pinned || !scratch) {
+        free(pinned);
+        free(scratch);
+        return NULL;
+    }
+
+    for (;;) {
+        size_t i = atomic_fetch_add(&job->next, 1);
+        if (i >= job->variant_count) break;
+
+        uint8_t *states = (job->states && job->states[i]) ? job->states[i] : scratch;
+        job->results[i] = overlay_resolve(job->csr, job->order, job->order_count,
+                                          &job->overlays[i], states, pinned);
+    }
+
+    free(pinned);
+    free(scratch);
+    return NULL;
+}
+
+bool dag_resolve_variants(const DAGCsr *csr,
+                          const DAGOverlay *overlays,
+                          size_t variant_count,
+                          uint8_t **states,
+                          DAGVariantResult *results,
+                          size_t threads) {
+    if (!csr || !overlays || !results) return false;
+    if (variant_count == 0) return true;
+
+    memset(results, 0, variant_count * sizeof(DAGVariantResult));
+
+    VariantJob job = {
+        .csr = csr,
+        .overlays = overlays,
+        .variant_count = variant_count,
+        .states = states,
+        .results = results
+    };
+    atomic_init(&job.next, 0);
+
+    // The topology and its order are computed once and shared read-only;
+    // sorted ids are their own order
+    uint32_t *order = NULL;
+    if (csr->sorted) {
+        job.order_count = csr->node_count;
+    } else {
+        order = dag_csr_topological_order(csr, &job.order_count);
+        if (!order) return false;
+    }
+    job.order = order;
+
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (threads > variant_count) threads = variant_count;
+
+    pthread_t *workers = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    if (!workers) {
+        free(order);
+        return false;
+    }
+
+    // The calling thread works too; spawn failures just mean fewer helpers
+    size_t spawned = 0;
+    for (size_t t = 1; t < threads; t++) {
+        if (pthread_create(&workers[spawned], NULL, variant_worker, &job) == 0) {
+            spawned++;
+        }
+    }
+    variant_worker(&job);
+
+    for (size_t t = 0; t < spawned; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    free(workers);
+    free(order);
+    return true;
+}
@@ -0,0 +1,295 @@
+// src/core/dag/quantized.c
+#include <axl/core/dag/quantized.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DAG_QUANT_X86 1
+#endif
+
+// Blocks accumulated in int32 lanes before flushing to int64: each
+// madd lane adds at most 2 * INT16_MAX, so 16384 blocks cannot overflow
+#define DAG_QUANT_FLUSH_BLOCKS 16384
+
+/// Sum of weights whose source is TRUE minus those whose source is FALSE.
+typedef int64_t (*NetSumFn)(const int16_t *weights, const uint32_t *states, uint32_t count);
+
+/* ---------------------------------------------------------------------------
+ * Kernels
+ * ------------------------------------------------------------------------- */
+
+static int64_t net_sum_scalar(const int16_t *weights, const uint32_t *states, uint32_t count) {
+    int64_t total = 0;
+    for (uint32_t j = 0; j < count; j++) {
+        uint32_t state = (states[j / DAG_QUANT_STATES_PER_WORD] >> (2 * (j % DAG_QUANT_STATES_PER_WORD))) & 3u;
+        if (state == STATE_TRUE) total += weights[j];
+        else if (state == STATE_FALSE) total -= weights[j];
+    }
+    return total;
+}
+
+#ifdef DAG_QUANT_X86
+
+// Lane i of a group of 8 tests bit 2i (TRUE) or bit 2i + 1 (FALSE)
+#define QUANT_TRUE_BITS  1 << 0, 1 << 2, 1 << 4, 1 << 6, 1 << 8, 1 << 10, 1 << 12, 1 << 14
+#define QUANT_FALSE_BITS 1 << 1, 1 << 3, 1 << 5, 1 << 7, 1 << 9, 1 << 11, 1 << 13, (short)0x8000
+
+/// +1 for lanes whose 2-bit state in `v` is TRUE, -1 for FALSE, else 0.
+static inline __m128i select_sse2(__m128i v) {
+    const __m128i true_bits = _mm_setr_epi16(QUANT_TRUE_BITS);
+    const __m128i false_bits = _mm_setr_epi16(QUANT_FALSE_BITS);
+    __m128i t = _mm_cmpeq_epi16(_mm_and_si128(v, true_bits), true_bits);
+    __m128i f = _mm_cmpeq_epi16(_mm_and_si128(v, false_bits), false_bits);
+    return _mm_sub_epi16(f, t);
+}
+
+static int64_t hsum_epi32_sse2(__m128i v) {
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, v);
+    return (int64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static int64_t net_sum_sse2(const int16_t *weights, const uint32_t *states, uint32_t count) {
+    if (count < DAG_QUANT_STATES_PER_WORD) return net_sum_scalar(weights, states, count);
+
+    uint32_t blocks = count / DAG_QUANT_STATES_PER_WORD;
+    __m128i acc = _mm_setzero_si128();
+    int64_t total = 0;
+
+    for (uint32_t i = 0; i < blocks; i++) {
+        uint32_t word = states[i];
+        const int16_t *w = weights + (size_t)i * DAG_QUANT_STATES_PER_WORD;
+
+        __m128i lo = select_sse2(_mm_set1_epi16((short)(word & 0xFFFFu)));
+        __m128i hi = select_sse2(_mm_set1_epi16((short)(word >> 16)));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)w), lo));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(w + 8)), hi));
+
+        if ((i + 1) % (DAG_QUANT_FLUSH_BLOCKS / 2) == 0) {
+            total += hsum_epi32_sse2(acc);
+            acc = _mm_setzero_si128();
+        }
+    }
+    total += hsum_epi32_sse2(acc);
+
+    uint32_t done = blocks * DAG_QUANT_STATES_PER_WORD;
+    return total + net_sum_scalar(weights + done, states + blocks, count - done);
+}
+
+__attribute__((target("avx2")))
+static int64_t net_sum_avx2(const int16_t *weights, const uint32_t *states, uint32_t count) {
+    // Most nodes have a few inputs: skip the 256-bit setup and reduction,
+    // which costs far more than the scalar loop for a partial block
+    if (count < DAG_QUANT_STATES_PER_WORD) return net_sum_scalar(weights, states, count);
+
+    const __m256i true_bits = _mm256_setr_epi16(QUANT_TRUE_BITS, QUANT_TRUE_BITS);
+    const __m256i false_bits = _mm256_setr_epi16(QUANT_FALSE_BITS, QUANT_FALSE_BITS);
+    uint32_t blocks = count / DAG_QUANT_STATES_PER_WORD;
+    __m256i acc = _mm256_setzero_si256();
+    int64_t total = 0;
+
+    for (uint32_t i = 0; i < blocks; i++) {
+        uint32_t word = states[i];
+
+        // Low half-word feeds lanes 0-7, high half-word lanes 8-15
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_set1_epi16((short)(word & 0xFFFFu))),
+            _mm_set1_epi16((short)(word >> 16)), 1);
+        __m256i t = _mm256_cmpeq_epi16(_mm256_and_si256(v, true_bits), true_bits);
+        __m256i f = _mm256_cmpeq_epi16(_mm256_and_si256(v, false_bits), false_bits);
+        __m256i w = _mm256_loadu_si256((const __m256i *)(weights + (size_t)i * DAG_QUANT_STATES_PER_WORD));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(w, _mm256_sub_epi16(f, t)));
+
+        if ((i + 1) % DAG_QUANT_FLUSH_BLOCKS == 0) {
+            total += hsum_epi32_sse2(_mm_add_epi32(_mm256_castsi256_si128(acc),
+                                                   _mm256_extracti128_si256(acc, 1)));
+            acc = _mm256_setzero_si256();
+        }
+    }
+    total += hsum_epi32_sse2(_mm_add_epi32(_mm256_castsi256_si128(acc),
+                                           _mm256_extracti128_si256(acc, 1)));
+
+    uint32_t done = blocks * DAG_QUANT_STATES_PER_WORD;
+    return total + net_sum_scalar(weights + done, states + blocks, count - done);
+}
+
+#endif // DAG_QUANT_X86
+
+static NetSumFn net_sum;
+static const char *net_sum_name;
+
+bool dag_quantized_use_kernel(DAGQuantKernel kernel) {
+#ifdef DAG_QUANT_X86
+    __builtin_cpu_init();
+    bool has_avx2 = __builtin_cpu_supports("avx2");
+
+    if (kernel == DAG_QUANT_KERNEL_AUTO) {
+        kernel = has_avx2 ? DAG_QUANT_KERNEL_AVX2 : DAG_QUANT_KERNEL_SSE2;
+    }
+    switch (kernel) {
+        case DAG_QUANT_KERNEL_AVX2:
+            if (!has_avx2) return false;
+            net_sum = net_sum_avx2;
+            net_sum_name = "avx2";
+            return true;
+        case DAG_QUANT_KERNEL_SSE2:
+            net_sum = net_sum_sse2;
+            net_sum_name = "sse2";
+            return true;
+        default:
+            break;
+    }
+#else
+    if (kernel != DAG_QUANT_KERNEL_AUTO && kernel != DAG_QUANT_KERNEL_SCALAR) return false;
+#endif
+    net_sum = net_sum_scalar;
+    net_sum_name = "scalar";
+    return true;
+}
+
+const char* dag_quantized_kernel_name(void) {
+    if (!net_sum) dag_quantized_use_kernel(DAG_QUANT_KERNEL_AUTO);
+    return net_sum_name;
+}
+
+/* ---------------------------------------------------------------------------
+ * Layout
+ * ------------------------------------------------------------------------- */
+
+static size_t quant_align(size_t n) {
+    return (n + 31) & ~(size_t)31;
+}
+
+DAGQuantized* dag_quantize(const DAGCsr *csr) {
+    if (!csr) return NULL;
+    if (!net_sum) dag_quantized_use_kernel(DAG_QUANT_KERNEL_AUTO);
+
+    uint32_t n = csr->node_count;
+    uint32_t e = csr->edge_count;
+
+    // Each node's packed states start on a word boundary
+    size_t words = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        uint32_t degree = csr->in_offsets[v + 1] - csr->in_offsets[v];
+        words += (degree + DAG_QUANT_STATES_PER_WORD - 1) / DAG_QUANT_STATES_PER_WORD;
+    }
+    if (words > UINT32_MAX) return NULL;
+
+    uint32_t order_count = 0;
+    uint32_t *order = dag_csr_topological_order(csr, &order_count);
+    if (!order) return NULL;
+
+    size_t bytes = quant_align(sizeof(DAGQuantized))
+                 + quant_align((size_t)(n + 1) * sizeof(uint32_t))   // in_offsets
+                 + quant_align((size_t)e * sizeof(uint32_t))         // in_sources
+                 + quant_align((size_t)e * sizeof(int16_t))          // in_weights
+                 + quant_align((size_t)(n + 1) * sizeof(uint32_t))   // state_offsets
+                 + quant_align(words * sizeof(uint32_t))             // edge_states
+                 + quant_align((size_t)n * sizeof(uint32_t))         // order
+                 + quant_align(n);                                   // states
+    char *block = (char *)aligned_alloc(32, bytes);
+    if (!block) {
+        free(order);
+        return NULL;
+    }
+    memset(block, 0, bytes);
+
+    DAGQuantized *q = (DAGQuantized *)block;
+    char *p = block + quant_align(sizeof(DAGQuantized));
+    q->in_offsets = (uint32_t *)p;    p += quant_align((size_t)(n + 1) * sizeof(uint32_t));
+    q->in_sources = (uint32_t *)p;    p += quant_align((size_t)e * sizeof(uint32_t));
+    q->in_weights = (int16_t *)p;     p += quant_align((size_t)e * sizeof(int16_t));
+    q->state_offsets = (uint32_t *)p; p += quant_align((size_t)(n + 1) * sizeof(uint32_t));
+    q->edge_states = (uint32_t *)p;   p += quant_align(words * sizeof(uint32_t));
+    q->order = (uint32_t *)p;         p += quant_align((size_t)n * sizeof(uint32_t));
+    q->states = (uint8_t *)p;
+    q->node_count = n;
+    q->edge_count = e;
+    q->order_count = order_count;
+    q->bytes = bytes;
+
+    memcpy(q->in_offsets, csr->in_offsets, (size_t)(n + 1) * sizeof(uint32_t));
+    memcpy(q->in_sources, csr->in_sources, (size_t)e * sizeof(uint32_t));
+    memcpy(q->order, order, (size_t)order_count * sizeof(uint32_t));
+    memcpy(q->states, csr->states, n);
+    free(order);
+
+    uint32_t offset = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        q->state_offsets[v] = offset;
+        uint32_t degree = csr->in_offsets[v + 1] - csr->in_offsets[v];
+        offset += (degree + DAG_QUANT_STATES_PER_WORD - 1) / DAG_QUANT_STATES_PER_WORD;
+    }
+    q->state_offsets[n] = offset;
+
+    // One scale for the whole DAG keeps comparisons between nodes exact
+    float max_weight = 0.0f;
+    for (uint32_t k = 0; k < e; k++) {
+        float magnitude = fabsf(csr->in_weights[k]);
+        if (magnitude > max_weight) max_weight = magnitude;
+    }
+    q->scale = max_weight > 0.0f ? (float)INT16_MAX / max_weight : 1.0f;
+
+    for (uint32_t k = 0; k < e; k++) {
+        long value = lrintf(csr->in_weights[k] * q->scale);
+        if (value > INT16_MAX) value = INT16_MAX;
+        if (value < -INT16_MAX) value = -INT16_MAX;
+        q->in_weights[k] = (int16_t)value;
+    }
+
+    return q;
+}
+
+/* ---------------------------------------------------------------------------
+ * Resolution
+ * ------------------------------------------------------------------------- */
+
+/// Pack the current states of `v`'s sources into its state words.
+static void quant_gather(DAGQuantized *q, uint32_t v, uint32_t begin, uint32_t degree) {
+    uint32_t *words = q->edge_states + q->state_offsets[v];
+    const uint32_t *sources = q->in_sources + begin;
+
+    for (uint32_t base = 0; base < degree; base += DAG_QUANT_STATES_PER_WORD) {
+        uint32_t packed = 0;
+        uint32_t count = degree - base;
+        if (count > DAG_QUANT_STATES_PER_WORD) count = DAG_QUANT_STATES_PER_WORD;
+        for (uint32_t b = 0; b < count; b++) {
+            packed |= (uint32_t)(q->states[sources[base + b]] & 3u) << (2 * b);
+        }
+        *words++ = packed;
+    }
+}
+
+int dag_quantized_resolve(DAGQuantized *q) {
+    if (!q) return -1;
+
+    memset(q->states, STATE_UNKNOWN, q->node_count);
+
+    for (uint32_t i = 0; i < q->order_count; i++) {
+        uint32_t v = q->order[i];
+        uint32_t begin = q->in_offsets[v];
+        uint32_t degree = q->in_offsets[v + 1] - begin;
+
+        // Default to true for root nodes (no incoming edges)
+        if (degree == 0) {
+            q->states[v] = STATE_TRUE;
+            continue;
+        }
+
+        quant_gather(q, v, begin, degree);
+        int64_t net = net_sum(q->in_weights + begin, q->edge_states + q->state_offsets[v], degree);
+
+        if (net > 0) q->states[v] = STATE_TRUE;
+        else if (net < 0) q->states[v] = STATE_FALSE;
+        else q->states[v] = STATE_UNKNOWN;
+    }
+
+    return q->order_count == q->node_count ? 0 : 1;
+}
+
+void dag_quantized_destroy(DAGQuantized *quantized) {
+    // The header and all arrays share a single allocation
+    free(quantized);
+}
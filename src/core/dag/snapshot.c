@@ -0,0 +1,280 @@
+// src/core/dag/snapshot.c
+#include <axl/core/dag/snapshot.h>
+#include <axl/core/runtime/epoch.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct DAGVersioned {
+    const DAGCsr           *topology;
+    uint32_t               *order;         // Topological order of the topology
+    uint32_t                order_count;
+    _Atomic(DAGSnapshot *)  current;
+    EpochDomain            *epoch;
+    uint64_t                next_version;  // Writer side only
+};
+
+static DAGSnapshot* snapshot_alloc(uint32_t node_count) {
+    uint32_t page_count = (node_count + DAG_SNAPSHOT_PAGE_MASK) >> DAG_SNAPSHOT_PAGE_SHIFT;
+    DAGSnapshot *snapshot = (DAGSnapshot *)calloc(1, sizeof(DAGSnapshot) +
+                                                     page_count * sizeof(DAGSnapshotPage *));
+    if (!snapshot) return NULL;
+
+    snapshot->node_count = node_count;
+    snapshot->page_count = page_count;
+    return snapshot;
+}
+
+static void page_release(DAGSnapshotPage *page) {
+    if (page && atomic_fetch_sub_explicit(&page->refs, 1, memory_order_acq_rel) == 1) {
+        free(page);
+    }
+}
+
+/// Drop a version's page references. Used as the epoch free callback.
+static void snapshot_release(void *ptr) {
+    DAGSnapshot *snapshot = (DAGSnapshot *)ptr;
+    for (uint32_t i = 0; i < snapshot->page_count; i++) {
+        page_release(snapshot->pages[i]);
+    }
+    free(snapshot);
+}
+
+DAGVersioned* dag_versioned_create(const DAGCsr *topology, size_t max_readers) {
+    if (!topology) return NULL;
+
+    DAGVersioned *versioned = (DAGVersioned *)calloc(1, sizeof(DAGVersioned));
+    if (!versioned) return NULL;
+
+    versioned->topology = topology;
+    versioned->order = dag_csr_topological_order(topology, &versioned->order_count);
+    versioned->epoch = epoch_domain_create(max_readers);
+    DAGSnapshot *initial = snapshot_alloc(topology->node_count);
+
+    if (!versioned->order || !versioned->epoch || !initial) {
+        free(initial);
+        epoch_domain_destroy(versioned->epoch);
+        free(versioned->order);
+        free(versioned);
+        return NULL;
+    }
+
+    initial->version = 1;
+    for (uint32_t p = 0; p < initial->page_count; p++) {
+        DAGSnapshotPage *page = (DAGSnapshotPage *)calloc(1, sizeof(DAGSnapshotPage));
+        if (!page) {
+            snapshot_release(initial);
+            epoch_domain_destroy(versioned->epoch);
+            free(versioned->order);
+            free(versioned);
+            return NULL;
+        }
+
+        atomic_init(&page->refs, 1);
+        page->owner = initial->version;
+        uint32_t first = p << DAG_SNAPSHOT_PAGE_SHIFT;
+        uint32_t count = topology->node_count - first;
+        if (count > DAG_SNAPSHOT_PAGE_NODES) count = DAG_SNAPSHOT_PAGE_NODES;
+        memcpy(page->states, topology->states + first, count);
+        initial->pages[p] = page;
+    }
+
+    atomic_init(&versioned->current, initial);
+    versioned->next_version = 2;
+    return versioned;
+}
+
+void dag_versioned_destroy(DAGVersioned *versioned) {
+    if (!versioned) return;
+
+    snapshot_release(atomic_load(&versioned->current));
+    epoch_domain_destroy(versioned->epoch);
+    free(versioned->order);
+    free(versioned);
+}
+
+int dag_versioned_register_reader(DAGVersioned *versioned) {
+    return versioned ? epoch_register(versioned->epoch) : -1;
+}
+
+void dag_versioned_unregister_reader(DAGVersioned *versioned, int reader) {
+    if (versioned) epoch_unregister(versioned->epoch, reader);
+}
+
+const DAGSnapshot* dag_snapshot_pin(DAGVersioned *versioned, int reader) {
+    epoch_enter(versioned->epoch, reader);
+    return atomic_load(&versioned->current);
+}
+
+void dag_snapshot_unpin(DAGVersioned *versioned, int reader) {
+    epoch_exit(versioned->epoch, reader);
+}
+
+DAGSnapshot* dag_snapshot_begin(DAGVersioned *versioned) {
+    if (!versioned) return NULL;
+
+    // The writer is the only thread that replaces `current`
+    const DAGSnapshot *base = atomic_load_explicit(&versioned->current, memory_order_relaxed);
+    DAGSnapshot *draft = snapshot_alloc(base->node_count);
+    if (!draft) return NULL;
+
+    draft->version = versioned->next_version++;
+    for (uint32_t p = 0; p < base->page_count; p++) {
+        draft->pages[p] = base->pages[p];
+        atomic_fetch_add_explicit(&draft->pages[p]->refs, 1, memory_order_relaxed);
+    }
+
+    return draft;
+}
+
+/// Page holding `node`, copied first if the draft still shares it.
+static DAGSnapshotPage* draft_page(DAGSnapshot *draft, uint32_t node) {
+    uint32_t p = node >> DAG_SNAPSHOT_PAGE_SHIFT;
+    DAGSnapshotPage *page = draft->pages[p];
+    if (page->owner == draft->version) {
+        return page;
+    }
+
+    DAGSnapshotPage *copy = (DAGSnapshotPage *)malloc(sizeof(DAGSnapshotPage));
+    if (!copy) return NULL;
+
+    memcpy(copy->states, page->states, sizeof(copy->states));
+    memcpy(copy->bindings, page->bindings, sizeof(copy->bindings));
+    atomic_init(&copy->refs, 1);
+    copy->owner = draft->version;
+
+    // The published version still holds `page`, so this never frees it
+    page_release(page);
+    draft->pages[p] = copy;
+    return copy;
+}
+
+bool dag_snapshot_set_state(DAGVersioned *versioned, DAGSnapshot *draft,
+                            uint32_t node, TruthValue state) {
+    if (!versioned || !draft || node >= draft->node_count) return false;
+    if (dag_snapshot_state(draft, node) == state) return true;
+
+    DAGSnapshotPage *page = draft_page(draft, node);
+    if (!page) return false;
+
+    page->states[node & DAG_SNAPSHOT_PAGE_MASK] = (uint8_t)state;
+    return true;
+}
+
+bool dag_snapshot_set_binding(DAGVersioned *versioned, DAGSnapshot *draft,
+                              uint32_t node, const void *binding) {
+    if (!versioned || !draft || node >= draft->node_count) return false;
+    if (dag_snapshot_binding(draft, node) == binding) return true;
+
+    DAGSnapshotPage *page = draft_page(draft, node);
+    if (!page) return false;
+
+    page->bindings[node & DAG_SNAPSHOT_PAGE_MASK] = binding;
+    return true;
+}
+
+/// State `v` resolves to from its sources' states in `draft`.
+static TruthValue snapshot_resolve_node(const DAGCsr *csr, const DAGSnapshot *draft, uint32_t v) {
+    float true_weight = 0.0f;
+    float false_weight = 0.0f;
+    for (uint32_t k = csr->in_offsets[v]; k < csr->in_offsets[v + 1]; k++) {
+        TruthValue source_state = dag_snapshot_state(draft, csr->in_sources[k]);
+        if (source_state == STATE_TRUE) {
+            true_weight += csr->in_weights[k];
+        } else if (source_state == STATE_FALSE) {
+            false_weight += csr->in_weights[k];
+        }
+    }
+
+    if (true_weight > false_weight) return STATE_TRUE;
+    if (false_weight > true_weight) return STATE_FALSE;
+    return STATE_UNKNOWN;
+}
+
+bool dag_snapshot_resolve(DAGVersioned *versioned, DAGSnapshot *draft) {
+    if (!versioned || !draft) return false;
+
+    const DAGCsr *csr = versioned->topology;
+    for (uint32_t i = 0; i < versioned->order_count; i++) {
+        uint32_t v = versioned->order[i];
+
+        // Roots and bound nodes keep the state they were given
+        if (csr->in_offsets[v] == csr->in_offsets[v + 1] || dag_snapshot_binding(draft, v)) continue;
+
+        if (!dag_snapshot_set_state(versioned, draft, v, snapshot_resolve_node(csr, draft, v))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool dag_snapshot_resolve_from(DAGVersioned *versioned, DAGSnapshot *draft,
+                               const uint32_t *changed, size_t count) {
+    if (!versioned || !draft || (count > 0 && !changed)) return false;
+    if (count == 0) return true;
+
+    const DAGCsr *csr = versioned->topology;
+    size_t words = ((size_t)csr->node_count + 63) / 64;
+    uint64_t *dirty = (uint64_t *)calloc(words, sizeof(uint64_t));
+    uint64_t *seeds = (uint64_t *)calloc(words, sizeof(uint64_t));
+    bool ok = dirty && seeds;
+
+    for (size_t i = 0; ok && i < count; i++) {
+        if (changed[i] >= csr->node_count) {
+            ok = false;
+            break;
+        }
+        dirty[changed[i] / 64] |= 1ull << (changed[i] % 64);
+        seeds[changed[i] / 64] |= 1ull << (changed[i] % 64);
+    }
+
+    // A node is dirty once one of its sources changed; the rest keep
+    // the state the previous version resolved them to
+    for (uint32_t i = 0; ok && i < versioned->order_count; i++) {
+        uint32_t v = versioned->order[i];
+        if (!(dirty[v / 64] & (1ull << (v % 64)))) continue;
+
+        bool propagate = (seeds[v / 64] & (1ull << (v % 64))) != 0;
+        if (csr->in_offsets[v] != csr->in_offsets[v + 1] && !dag_snapshot_binding(draft, v)) {
+            TruthValue state = snapshot_resolve_node(csr, draft, v);
+            if (state != dag_snapshot_state(draft, v)) {
+                ok = dag_snapshot_set_state(versioned, draft, v, state);
+                propagate = true;
+            }
+        }
+
+        for (uint32_t k = csr->out_offsets[v]; propagate && k < csr->out_offsets[v + 1]; k++) {
+            uint32_t target = csr->out_targets[k];
+            dirty[target / 64] |= 1ull << (target % 64);
+        }
+    }
+
+    free(dirty);
+    free(seeds);
+    return ok;
+}
+
+void dag_snapshot_publish(DAGVersioned *versioned, DAGSnapshot *draft) {
+    if (!versioned || !draft) return;
+
+    DAGSnapshot *old = atomic_exchange(&versioned->current, draft);
+
+    // Readers that pinned `old` keep it alive until they unpin
+    if (!epoch_retire(versioned->epoch, old, snapshot_release)) {
+        // Out of memory: leaking the version is the only safe choice
+        return;
+    }
+    epoch_reclaim(versioned->epoch);
+}
+
+bool dag_versioned_retire(DAGVersioned *versioned, void *ptr, EpochFreeFn free_fn) {
+    if (!versioned || !ptr || !free_fn) return false;
+    if (!epoch_retire(versioned->epoch, ptr, free_fn)) return false;
+    epoch_reclaim(versioned->epoch);
+    return true;
+}
+
+void dag_snapshot_abort(DAGVersioned *versioned, DAGSnapshot *draft) {
+    if (!versioned || !draft) return;
+    snapshot_release(draft);
+}
@@ -1,127 +1,826 @@
 // src/core/integration/axml_integration.c
-// Patch for src/cli/main.c
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>   // Required for clock() and CLOCKS_PER_SEC
-#include <stdbool.h> // Required for bool type
+#include <strings.h>
+#include <stdbool.h>
 #include <axl/core/integration/trie_dag.h>
+#include <axl/core/integration/semantic.h>
+#include <axl/core/axml/diff.h>
+#include <axl/core/axml/parser.h>
+#include <axl/core/axml/watch.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/dag/overlay.h>
+#include <axl/core/dag/snapshot.h>
+#include <axl/core/runtime/cache.h>
+#include <axl/core/runtime/governor.h>
+#include <axl/core/runtime/reclaimer.h>
+#include <axl/core/utils/source.h>
 
-bool apply_axml_to_dag(DAGNode* root, AxmlConfig* config) {
-    if (!root || !config) return false;
-    
-    // Apply concept bindings to DAG nodes
-    AxmlConcept* concept = config->concepts;
-    while (concept) {
-        // Find DAG node matching concept ID
-        DAGNode* concept_node = find_dag_node_by_id(root, concept->id);
-        if (concept_node) {
-            // Apply bindings
-            AxmlBinding* binding = concept->bindings;
-            while (binding) {
-                apply_binding_to_node(concept_node, binding);
-                binding = binding->next;
+// Reader slots on a retained DAG's snapshots
+#define AXL_RETAINED_READERS 64
+
+/// A configuration bindings of the published version point into.
+typedef struct AxlRetainedConfig {
+    AxmlCompactConfig* config;
+    size_t             bound;         // Nodes bound to one of its bindings
+} AxlRetainedConfig;
+
+/// An executed DAG kept alive: frozen topology, its published binding
+/// snapshots and the configurations those bindings point into.
+typedef struct AxlRetainedDag {
+    AxlFrozenDag*      frozen;
+    DAGVersioned*      versioned;
+    AxmlCompactConfig* config;        // Latest configuration; base of the next diff
+    AxlRetainedConfig* configs;       // Latest first, then older ones still bound
+    size_t             config_count;
+    size_t             config_capacity;
+} AxlRetainedDag;
+
+static void retired_config_free(void* ptr) {
+    axml_free_compact_config((AxmlCompactConfig*)ptr);
+}
+
+static void retained_dag_destroy(void* ptr) {
+    AxlRetainedDag* retained = (AxlRetainedDag*)ptr;
+    dag_versioned_destroy(retained->versioned);
+    axl_frozen_destroy(retained->frozen);
+    for (size_t i = 0; i < retained->config_count; i++) {
+        axml_free_compact_config(retained->configs[i].config);
+    }
+    free(retained->configs);
+    free(retained);
+}
+
+static void reclaim_semantic_dag(void* ptr) {
+    axl_semantic_destroy((AxlSemanticDag*)ptr);
+    free(ptr);
+}
+
+// Only BUST_IMMEDIATE tears DAGs down on the caller's critical path
+static Reclaimer* bust_reclaimer(const AxmlCompactConfig* config) {
+    return config->bust_policy == BUST_IMMEDIATE ? NULL : reclaimer_shared();
+}
+
+// Free the pointer layout once frozen, on the reclaimer thread if any
+static void bust_semantic_dag(AxlSemanticDag* dag, Reclaimer* reclaimer) {
+    AxlSemanticDag* busted = reclaimer ? (AxlSemanticDag*)malloc(sizeof(AxlSemanticDag)) : NULL;
+    if (busted) {
+        *busted = *dag;
+        if (reclaimer_defer(reclaimer, busted, reclaim_semantic_dag)) return;
+        free(busted);
+    }
+    axl_semantic_destroy(dag);
+}
+
+// Command-line overrides of the AXML settings, for later executions
+static AxlExecutionOverrides execution_overrides;
+
+void axl_set_execution_overrides(const AxlExecutionOverrides* overrides) {
+    if (overrides) {
+        execution_overrides = *overrides;
+    } else {
+        memset(&execution_overrides, 0, sizeof(execution_overrides));
+    }
+}
+
+// Truth value an AXML binding pins its concept's node to
+static TruthValue binding_truth_value(const AxmlCompactConfig* config,
+                                      const AxmlCompactBinding* binding) {
+    const char* value = axml_string(config, binding->value);
+    if (value) {
+        if (strcasecmp(value, "true") == 0 || strcasecmp(value, "yes") == 0 || strcmp(value, "1") == 0) {
+            return STATE_TRUE;
+        }
+        if (strcasecmp(value, "false") == 0 || strcasecmp(value, "no") == 0 || strcmp(value, "0") == 0) {
+            return STATE_FALSE;
+        }
+    }
+
+    switch (binding->cardinality) {
+        case CARDINALITY_ONE_ZERO: return STATE_FALSE;      // Bound to nothing
+        case CARDINALITY_ZERO_ONE: return STATE_UNKNOWN;    // Optional; left derived
+        default:                   return STATE_TRUE;
+    }
+}
+
+// Combined truth value of a concept's bindings; any false binding wins
+static TruthValue concept_truth_value(const AxmlCompactConfig* config,
+                                      const AxmlCompactConcept* concept) {
+    TruthValue state = STATE_UNKNOWN;
+    for (uint32_t b = concept->bindings_begin; b < concept->bindings_end; b++) {
+        TruthValue value = binding_truth_value(config, &config->bindings[b]);
+        if (value == STATE_FALSE) return STATE_FALSE;
+        if (value == STATE_TRUE) state = STATE_TRUE;
+    }
+    return state;
+}
+
+// Pin every bound concept's identifier node; unknown identifiers are skipped
+static bool build_overlay(const AxlFrozenDag* frozen, const AxmlCompactConfig* config,
+                          DAGOverlay* overlay) {
+    dag_overlay_init(overlay);
+
+    for (size_t c = 0; c < config->concept_count; c++) {
+        const AxmlCompactConcept* concept = &config->concepts[c];
+        uint32_t node_id;
+        if (concept->bindings_begin == concept->bindings_end ||
+            !axl_frozen_lookup(frozen, axml_string(config, concept->id), &node_id)) {
+            continue;
+        }
+
+        if (!dag_overlay_set(overlay, node_id, concept_truth_value(config, concept),
+                             &config->bindings[concept->bindings_begin])) {
+            dag_overlay_free(overlay);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void report_build_error(const char* name, AxlSource* source,
+                               const AxlSemanticError* error) {
+    // Line and column are only worked out for the diagnostic
+    AxlLinePosition position;
+    if (axl_source_position(source, error->offset, &position)) {
+        fprintf(stderr, "%s:%zu:%zu: error: %s\n", name, position.line, position.column, error->message);
+    } else {
+        fprintf(stderr, "%s: error: %s\n", name, error->message);
+    }
+}
+
+static void report_result(const char* name, const DAGVariantResult* result) {
+    printf("%s: %zu nodes resolved (%zu true, %zu false, %zu unknown)\n", name,
+           result->true_count + result->false_count + result->unknown_count,
+           result->true_count, result->false_count, result->unknown_count);
+}
+
+// Build the semantic DAG of one source and freeze it for execution
+static AxlFrozenDag* build_frozen_dag(const char* name, AxlSource* source,
+                                      const AxmlCompactConfig* config) {
+    // With hash-consing, repeated sub-expressions share a node
+    DAGConsTable* cons = config->hash_cons ? dag_cons_create() : NULL;
+    if (config->hash_cons && !cons) {
+        fprintf(stderr, "Failed to build semantic DAG for %s: out of memory\n", name);
+        return NULL;
+    }
+
+    AxlSemanticDag dag;
+    AxlSemanticError error;
+    bool built = axl_semantic_build(source->data, source->size, cons, &dag, &error);
+    dag_cons_destroy(cons);
+    if (!built) {
+        report_build_error(name, source, &error);
+        return NULL;
+    }
+
+    AxlFrozenDag* frozen = axl_semantic_freeze(&dag);
+    bust_semantic_dag(&dag, bust_reclaimer(config));
+    if (!frozen) {
+        fprintf(stderr, "Failed to freeze semantic DAG for %s\n", name);
+    }
+    return frozen;
+}
+
+// Resolve a frozen DAG under one configuration's bindings
+static bool resolve_frozen_dag(const char* name, const AxlFrozenDag* frozen,
+                               const AxmlCompactConfig* config) {
+    DAGOverlay overlay;
+    if (!build_overlay(frozen, config, &overlay)) {
+        fprintf(stderr, "Failed to apply AXML bindings to %s\n", name);
+        return false;
+    }
+
+    // Frozen semantic DAGs are in topological id order already
+    uint32_t order_count = frozen->csr->node_count;
+    uint32_t* order = NULL;
+    if (!frozen->csr->sorted) {
+        order = dag_csr_topological_order(frozen->csr, &order_count);
+    }
+    uint8_t* states = (uint8_t*)malloc((size_t)frozen->csr->node_count + 1);
+
+    DAGVariantResult result = {0};
+    if ((order || frozen->csr->sorted) && states) {
+        result = dag_overlay_resolve(frozen->csr, order, order_count, &overlay, states);
+    }
+
+    free(states);
+    free(order);
+    dag_overlay_free(&overlay);
+
+    if (!result.ok) {
+        fprintf(stderr, "Failed to resolve semantic DAG for %s\n", name);
+        return false;
+    }
+    report_result(name, &result);
+    return true;
+}
+
+// Track `config` as the latest configuration of `retained`
+static bool retained_add_config(AxlRetainedDag* retained, AxmlCompactConfig* config) {
+    if (retained->config_count == retained->config_capacity) {
+        size_t capacity = retained->config_capacity ? retained->config_capacity * 2 : 4;
+        AxlRetainedConfig* configs = (AxlRetainedConfig*)realloc(retained->configs,
+                                                                 capacity * sizeof(AxlRetainedConfig));
+        if (!configs) return false;
+        retained->configs = configs;
+        retained->config_capacity = capacity;
+    }
+
+    memmove(&retained->configs[1], &retained->configs[0],
+            retained->config_count * sizeof(AxlRetainedConfig));
+    retained->configs[0] = (AxlRetainedConfig){ config, 0 };
+    retained->config_count++;
+    retained->config = config;
+    return true;
+}
+
+// Index of the configuration whose bindings array holds `binding`
+static size_t retained_binding_owner(const AxlRetainedDag* retained, const void* binding) {
+    uintptr_t address = (uintptr_t)binding;
+    for (size_t i = 0; binding && i < retained->config_count; i++) {
+        const AxmlCompactConfig* config = retained->configs[i].config;
+        uintptr_t begin = (uintptr_t)config->bindings;
+        if (address >= begin && address < begin + config->binding_count * sizeof(AxmlCompactBinding)) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/// One draft's binding changes to a retained DAG.
+typedef struct AxlRebind {
+    AxlRetainedDag* retained;
+    DAGSnapshot*    draft;
+    uint32_t*       changed;          // Nodes whose state or binding was set
+    size_t          changed_count;
+    size_t          changed_capacity;
+    ptrdiff_t*      bound;            // Change to each configuration's bound count
+} AxlRebind;
+
+static bool rebind_begin(AxlRebind* rebind, AxlRetainedDag* retained) {
+    memset(rebind, 0, sizeof(*rebind));
+    rebind->retained = retained;
+    rebind->bound = (ptrdiff_t*)calloc(retained->config_count, sizeof(ptrdiff_t));
+    rebind->draft = rebind->bound ? dag_snapshot_begin(retained->versioned) : NULL;
+    if (!rebind->draft) {
+        free(rebind->bound);
+        return false;
+    }
+    return true;
+}
+
+// Pin `node` to `state` and `binding`, or return it to its unbound state
+static bool rebind_node(AxlRebind* rebind, uint32_t node, TruthValue state, const void* binding) {
+    AxlRetainedDag* retained = rebind->retained;
+    const void* previous = dag_snapshot_binding(rebind->draft, node);
+    if (!binding) state = (TruthValue)retained->frozen->csr->states[node];
+
+    if (rebind->changed_count == rebind->changed_capacity) {
+        size_t capacity = rebind->changed_capacity ? rebind->changed_capacity * 2 : 16;
+        uint32_t* changed = (uint32_t*)realloc(rebind->changed, capacity * sizeof(uint32_t));
+        if (!changed) return false;
+        rebind->changed = changed;
+        rebind->changed_capacity = capacity;
+    }
+
+    if (!dag_snapshot_set_state(retained->versioned, rebind->draft, node, state) ||
+        !dag_snapshot_set_binding(retained->versioned, rebind->draft, node, binding)) {
+        return false;
+    }
+    rebind->changed[rebind->changed_count++] = node;
+
+    if (previous != binding) {
+        size_t owner = retained_binding_owner(retained, previous);
+        if (owner != SIZE_MAX) rebind->bound[owner]--;
+        owner = retained_binding_owner(retained, binding);
+        if (owner != SIZE_MAX) rebind->bound[owner]++;
+    }
+    return true;
+}
+
+// Re-resolve downstream of the changed nodes and publish atomically
+static bool rebind_commit(AxlRebind* rebind, bool ok) {
+    AxlRetainedDag* retained = rebind->retained;
+    ok = ok && dag_snapshot_resolve_from(retained->versioned, rebind->draft,
+                                         rebind->changed, rebind->changed_count);
+    if (ok) {
+        dag_snapshot_publish(retained->versioned, rebind->draft);
+        for (size_t i = 0; i < retained->config_count; i++) {
+            retained->configs[i].bound += rebind->bound[i];
+        }
+    } else {
+        dag_snapshot_abort(retained->versioned, rebind->draft);
+    }
+
+    free(rebind->changed);
+    free(rebind->bound);
+    return ok;
+}
+
+// Retire older configurations no node is bound into any more. Pinned
+// readers of earlier versions may still follow their bindings, so they
+// are freed through the snapshots' epoch, not here.
+static void retained_release_configs(AxlRetainedDag* retained) {
+    size_t kept = 1;
+    for (size_t i = 1; i < retained->config_count; i++) {
+        AxlRetainedConfig* entry = &retained->configs[i];
+        // Kept (and freed with the DAG) if it cannot be retired
+        if (entry->bound > 0 || !dag_versioned_retire(retained->versioned, entry->config,
+                                                       retired_config_free)) {
+            retained->configs[kept++] = *entry;
+        }
+    }
+    retained->config_count = kept;
+}
+
+// Apply a new retained DAG's configuration to its unbound first version
+static bool apply_axml_to_snapshot(AxlRetainedDag* retained) {
+    DAGOverlay overlay;
+    if (!build_overlay(retained->frozen, retained->config, &overlay)) return false;
+
+    AxlRebind rebind;
+    bool ok = rebind_begin(&rebind, retained);
+    if (!ok) {
+        dag_overlay_free(&overlay);
+        return false;
+    }
+
+    for (size_t i = 0; ok && i < overlay.count; i++) {
+        const DAGOverlayEntry* entry = &overlay.entries[i];
+        if (entry->state == STATE_UNKNOWN) continue;    // Left derived
+        ok = rebind_node(&rebind, entry->node, entry->state, entry->binding);
+    }
+
+    dag_overlay_free(&overlay);
+    return rebind_commit(&rebind, ok);
+}
+
+/// One binding the AXML diff reported.
+typedef struct AxlBindingChangeEntry {
+    AxmlChangeKind kind;
+    const char*    concept_id;
+    const char*    name;
+} AxlBindingChangeEntry;
+
+/// Every binding the AXML diff reported, in diff order.
+typedef struct AxlBindingChanges {
+    const AxmlCompactConfig* old_config;
+    const AxmlCompactConfig* new_config;
+    AxlBindingChangeEntry*   entries;
+    size_t                   count;
+    size_t                   capacity;
+    bool                     failed;
+} AxlBindingChanges;
+
+static void collect_binding_change(const AxmlBindingChange* change, void* user_data) {
+    AxlBindingChanges* changes = (AxlBindingChanges*)user_data;
+    if (changes->failed) return;
+
+    if (changes->count == changes->capacity) {
+        size_t capacity = changes->capacity ? changes->capacity * 2 : 16;
+        AxlBindingChangeEntry* entries = (AxlBindingChangeEntry*)realloc(changes->entries,
+                                                                         capacity * sizeof(AxlBindingChangeEntry));
+        if (!entries) {
+            changes->failed = true;
+            return;
+        }
+        changes->entries = entries;
+        changes->capacity = capacity;
+    }
+
+    AxlBindingChangeEntry* entry = &changes->entries[changes->count++];
+    entry->kind = change->kind;
+    entry->concept_id = change->concept_id;
+    entry->name = change->new_binding
+        ? axml_string(changes->new_config, change->new_binding->name)
+        : axml_string(changes->old_config, change->old_binding->name);
+}
+
+// Last concept `id` names with any bindings; it decides the node's state
+static const AxmlCompactConcept* find_bound_concept(const AxmlCompactConfig* config, const char* id) {
+    for (size_t c = config->concept_count; c-- > 0;) {
+        const AxmlCompactConcept* concept = &config->concepts[c];
+        if (concept->bindings_begin != concept->bindings_end &&
+            strcmp(axml_string(config, concept->id), id) == 0) {
+            return concept;
+        }
+    }
+    return NULL;
+}
+
+// Rebind only the concepts whose bindings changed to `updated`. Other
+// nodes keep pointing into the configuration they were bound from.
+static bool rebind_changed_concepts(AxlRetainedDag* retained, AxmlCompactConfig* updated,
+                                    const AxlBindingChanges* changes) {
+    AxmlCompactConfig* previous = retained->config;
+    if (!retained_add_config(retained, updated)) return false;
+
+    AxlRebind rebind;
+    bool ok = rebind_begin(&rebind, retained);
+    if (ok) {
+        for (size_t i = 0; ok && i < changes->count; i++) {
+            // A concept's bindings are reported one after another; rebind it once
+            const char* id = changes->entries[i].concept_id;
+            uint32_t node;
+            if ((i > 0 && strcmp(changes->entries[i - 1].concept_id, id) == 0) ||
+                !axl_frozen_lookup(retained->frozen, id, &node)) {
+                continue;
             }
+
+            const AxmlCompactConcept* concept = find_bound_concept(updated, id);
+            TruthValue state = concept ? concept_truth_value(updated, concept) : STATE_UNKNOWN;
+            const void* binding = state != STATE_UNKNOWN ? &updated->bindings[concept->bindings_begin] : NULL;
+            ok = rebind_node(&rebind, node, state, binding);
         }
-        
-        concept = concept->next;
+        ok = rebind_commit(&rebind, ok);
     }
-    
+    if (ok) return true;
+
+    // Nothing was published; `updated` goes back to the caller
+    retained->config_count--;
+    memmove(&retained->configs[0], &retained->configs[1],
+            retained->config_count * sizeof(AxlRetainedConfig));
+    retained->config = previous;
+    return false;
+}
+
+// Report the latest published snapshot, pinned like any other reader
+static bool report_snapshot(const char* name, DAGVersioned* versioned) {
+    int reader = dag_versioned_register_reader(versioned);
+    if (reader < 0) return false;
+
+    const DAGSnapshot* snapshot = dag_snapshot_pin(versioned, reader);
+    DAGVariantResult result = { .ok = true };
+    for (uint32_t v = 0; v < snapshot->node_count; v++) {
+        TruthValue state = dag_snapshot_state(snapshot, v);
+        if (state == STATE_TRUE) result.true_count++;
+        else if (state == STATE_FALSE) result.false_count++;
+        else result.unknown_count++;
+    }
+    dag_snapshot_unpin(versioned, reader);
+    dag_versioned_unregister_reader(versioned, reader);
+
+    report_result(name, &result);
     return true;
 }
 
-// Enhanced execute_axl_with_busting with AXML integration
+// Resolve a frozen DAG into a retained one whose bindings are published
+// as snapshots, so later configurations never block readers. Takes
+// ownership of `frozen` and `config`; NULL if it could not be resolved.
+static AxlRetainedDag* create_retained_dag(const char* name, AxlFrozenDag* frozen,
+                                           AxmlCompactConfig* config) {
+    AxlRetainedDag* retained = (AxlRetainedDag*)calloc(1, sizeof(AxlRetainedDag));
+    if (!retained) {
+        fprintf(stderr, "Failed to retain semantic DAG for %s\n", name);
+        axl_frozen_destroy(frozen);
+        axml_free_compact_config(config);
+        return NULL;
+    }
+    retained->frozen = frozen;
+    if (!retained_add_config(retained, config)) {
+        fprintf(stderr, "Failed to retain semantic DAG for %s\n", name);
+        axml_free_compact_config(config);
+        retained_dag_destroy(retained);
+        return NULL;
+    }
+
+    // Version 1 holds the unbound resolution
+    if (dag_csr_resolve(frozen->csr) == 0) {
+        retained->versioned = dag_versioned_create(frozen->csr, AXL_RETAINED_READERS);
+    }
+    if (!retained->versioned || !apply_axml_to_snapshot(retained) ||
+        !report_snapshot(name, retained->versioned)) {
+        fprintf(stderr, "Failed to resolve semantic DAG for %s\n", name);
+        retained_dag_destroy(retained);
+        return NULL;
+    }
+    return retained;
+}
+
+// Keep an executed DAG in the process-wide governor
+static bool retain_frozen_dag(const char* name, AxlFrozenDag* frozen, AxmlCompactConfig* config) {
+    AxlRetainedDag* retained = create_retained_dag(name, frozen, config);
+    if (!retained) return false;
+
+    uint32_t pages = (frozen->csr->node_count + DAG_SNAPSHOT_PAGE_MASK) >> DAG_SNAPSHOT_PAGE_SHIFT;
+    size_t bytes = sizeof(AxlRetainedDag) + frozen->bytes + pages * sizeof(DAGSnapshotPage);
+
+    // The command-line budget wins; the AXML one only binds BUST_CONDITIONAL
+    MemoryGovernor* governor = governor_shared();
+    size_t budget = execution_overrides.memory_budget;
+    if (budget == 0 && config->bust_policy == BUST_CONDITIONAL) {
+        budget = config->memory_budget;
+    }
+    if (budget > 0) {
+        governor_set_budget(governor, budget, execution_overrides.budget_rss);
+    }
+
+    // Over budget, least recently used DAGs are evicted (never this one)
+    if (!governor_track(governor, retained, bytes, retained_dag_destroy)) {
+        fprintf(stderr, "Failed to retain semantic DAG for %s: out of memory\n", name);
+        retained_dag_destroy(retained);
+        return false;
+    }
+    return true;
+}
+
+// Read an AXL file and build its frozen DAG under `config`
+static AxlFrozenDag* load_frozen_dag(const char* axl_path, const AxmlCompactConfig* config) {
+    // Map AXL source read-only; pipes fall back to a buffered read
+    AxlSource axl_source;
+    if (!axl_source_open(axl_path, &axl_source)) {
+        fprintf(stderr, "Failed to read AXL file: %s\n", axl_path);
+        return NULL;
+    }
+
+    AxlFrozenDag* frozen = build_frozen_dag(axl_path, &axl_source, config);
+
+    // DAG construction is done with the source text
+    axl_source_close(&axl_source);
+    return frozen;
+}
+
+// Execute one source under `config`; any diagnostics share its line index
+static bool execute_source(const char* name, AxlSource* source, const AxmlCompactConfig* config) {
+    AxlFrozenDag* frozen = build_frozen_dag(name, source, config);
+    if (!frozen) return false;
+
+    // Retained DAGs stay frozen, with a configuration of their own for
+    // their bindings to point into; the pointer layout is already gone
+    bool retain = execution_overrides.retain_memory ||
+                  (config->bust_policy != BUST_IMMEDIATE && config->retain_memory);
+    if (retain) {
+        AxmlCompactConfig* owned = axml_copy_compact_config(config);
+        if (!owned) {
+            fprintf(stderr, "Failed to retain semantic DAG for %s: out of memory\n", name);
+            axl_frozen_destroy(frozen);
+            return false;
+        }
+        return retain_frozen_dag(name, frozen, owned);
+    }
+
+    bool result = resolve_frozen_dag(name, frozen, config);
+
+    // BUST_DELAYED tears down on the reclaimer thread, off the result path
+    if (!reclaimer_defer(bust_reclaimer(config), frozen, axl_frozen_destroy)) {
+        axl_frozen_destroy(frozen);
+    }
+    return result;
+}
+
+bool execute_axl_source(const char* name, const char* data, size_t size,
+                        const AxmlCompactConfig* config) {
+    if (!name || !data || !config) return false;
+
+    AxlSource source;
+    axl_source_borrow(data, size, &source);
+    bool result = execute_source(name, &source, config);
+    axl_source_close(&source);
+    return result;
+}
+
 bool execute_axl_with_busting(const char* axl_path, const char* axml_path) {
-    // Parse AXML configuration
-    AxmlConfig* config = axml_parse_file(axml_path);
+    // Parse AXML configuration into its flat, pooled form
+    AxmlCompactConfig* config = axml_parse_compact(axml_path);
     if (!config) {
         fprintf(stderr, "Failed to parse AXML configuration: %s\n", axml_path);
         return false;
     }
-    
-    // Create DAG buster
-    DAGBuster* buster = dag_buster_create();
-    if (!buster) {
-        axml_free_config(config);
+
+    // Map AXL source read-only; pipes fall back to a buffered read
+    AxlSource axl_source;
+    if (!axl_source_open(axl_path, &axl_source)) {
+        fprintf(stderr, "Failed to read AXL file: %s\n", axl_path);
+        axml_free_compact_config(config);
         return false;
     }
-    
-    // Load and parse AXL file
-    FILE* axl_file = fopen(axl_path, "r");
-    if (!axl_file) {
-        fprintf(stderr, "Failed to open AXL file: %s\n", axl_path);
-        axml_free_config(config);
-        free(buster);
+
+    bool result = execute_source(axl_path, &axl_source, config);
+
+    axl_source_close(&axl_source);
+    axml_free_compact_config(config);
+    return result;
+}
+
+// What-if evaluation: one shared DAG per build setting, one overlay per
+// AXML configuration
+bool execute_axl_variants(const char* axl_path, const char** axml_paths,
+                          size_t variant_count, bool* results) {
+    if (!axl_path || !axml_paths || !results || variant_count == 0) return false;
+
+    AxmlCompactConfig** configs = (AxmlCompactConfig**)calloc(variant_count, sizeof(AxmlCompactConfig*));
+    DAGOverlay* overlays = (DAGOverlay*)calloc(variant_count, sizeof(DAGOverlay));
+    DAGVariantResult* group_results = (DAGVariantResult*)calloc(variant_count, sizeof(DAGVariantResult));
+    DAGVariantResult* variant_results = (DAGVariantResult*)calloc(variant_count, sizeof(DAGVariantResult));
+    size_t* members = (size_t*)calloc(variant_count, sizeof(size_t));
+    bool* grouped = (bool*)calloc(variant_count, sizeof(bool));
+    if (!configs || !overlays || !group_results || !variant_results || !members || !grouped) {
+        free(configs);
+        free(overlays);
+        free(group_results);
+        free(variant_results);
+        free(members);
+        free(grouped);
         return false;
     }
-    
-    // Read AXL content
-    fseek(axl_file, 0, SEEK_END);
-    long file_size = ftell(axl_file);
-    rewind(axl_file);
-    
-    char* axl_content = (char*)malloc(file_size + 1);
-    if (!axl_content) {
-        fclose(axl_file);
-        axml_free_config(config);
-        free(buster);
+
+    size_t parsed = 0;
+    for (size_t v = 0; v < variant_count; v++) {
+        results[v] = false;
+        configs[v] = axml_parse_compact(axml_paths[v]);
+        if (!configs[v]) {
+            fprintf(stderr, "Failed to parse AXML configuration: %s\n", axml_paths[v]);
+        } else {
+            parsed++;
+        }
+    }
+    if (parsed == 0) {
+        fprintf(stderr, "No AXML configuration could be parsed\n");
+    }
+
+    // Configurations that build the DAG the same way share one; the first
+    // of each kind decides how it is built
+    bool any_built = false;
+    for (size_t leader = 0; leader < variant_count; leader++) {
+        if (!configs[leader] || grouped[leader]) continue;
+
+        size_t member_count = 0;
+        for (size_t v = leader; v < variant_count; v++) {
+            if (configs[v] && !grouped[v] && !axml_diff_requires_rebuild(configs[leader], configs[v])) {
+                grouped[v] = true;
+                members[member_count++] = v;
+            }
+        }
+
+        // Build and freeze the semantic DAG once per group
+        AxlFrozenDag* frozen = load_frozen_dag(axl_path, configs[leader]);
+        if (!frozen) continue;
+        any_built = true;
+
+        // Each configuration only contributes node state/binding overrides
+        bool ok = true;
+        for (size_t m = 0; ok && m < member_count; m++) {
+            ok = build_overlay(frozen, configs[members[m]], &overlays[m]);
+            if (!ok) {
+                fprintf(stderr, "Failed to apply AXML bindings from %s\n", axml_paths[members[m]]);
+            }
+        }
+
+        ok = ok && dag_resolve_variants(frozen->csr, overlays, member_count, NULL, group_results, 0);
+        for (size_t m = 0; m < member_count; m++) {
+            results[members[m]] = ok && group_results[m].ok;
+            variant_results[members[m]] = group_results[m];
+            dag_overlay_free(&overlays[m]);
+        }
+        axl_frozen_destroy(frozen);
+    }
+
+    for (size_t v = 0; v < variant_count; v++) {
+        if (results[v]) {
+            report_result(axml_paths[v], &variant_results[v]);
+        }
+        axml_free_compact_config(configs[v]);
+    }
+    free(configs);
+    free(overlays);
+    free(group_results);
+    free(variant_results);
+    free(members);
+    free(grouped);
+
+    return any_built;
+}
+
+// Build the retained DAG the watch loop keeps between reloads
+static AxlRetainedDag* load_retained_dag(const char* axl_path, AxmlCompactConfig* config) {
+    AxlFrozenDag* frozen = load_frozen_dag(axl_path, config);
+    if (!frozen) {
+        axml_free_compact_config(config);
+        return NULL;
+    }
+    return create_retained_dag(axl_path, frozen, config);
+}
+
+// Hot reload: keep the DAG alive and publish a new binding snapshot each
+// time the AXML file is saved; only policy-level changes rebuild it
+bool watch_axl_with_busting(const char* axl_path, const char* axml_path) {
+    AxmlCompactConfig* config = axml_parse_compact(axml_path);
+    if (!config) {
+        fprintf(stderr, "Failed to parse AXML configuration: %s\n", axml_path);
         return false;
     }
-    
-    fread(axl_content, 1, file_size, axl_file);
-    axl_content[file_size] = '\0';
-    fclose(axl_file);
-    
-    // Parse AXL content to extract patterns
-    buster->patterns = parse_axl_patterns(axl_content, &buster->pattern_count);
-    free(axl_content);
-    
-    if (!buster->patterns) {
-        fprintf(stderr, "Failed to parse AXL patterns\n");
-        axml_free_config(config);
-        free(buster);
+
+    AxmlWatcher* watcher = axml_watch_create(axml_path);
+    if (!watcher) {
+        fprintf(stderr, "Failed to watch AXML configuration: %s\n", axml_path);
+        axml_free_compact_config(config);
         return false;
     }
-    
-    // Build semantic DAG
-    buster->resolved_root = build_semantic_dag(buster->patterns, buster->pattern_count);
-    if (!buster->resolved_root) {
-        fprintf(stderr, "Failed to build semantic DAG\n");
-        for (size_t i = 0; i < buster->pattern_count; i++) {
-            free_trie_node(buster->patterns[i]);
-        }
-        free(buster->patterns);
-        axml_free_config(config);
-        free(buster);
+
+    AxlRetainedDag* retained = load_retained_dag(axl_path, config);
+    if (!retained) {
+        axml_watch_destroy(watcher);
         return false;
     }
-    
-    // Apply AXML configuration to DAG
-    apply_axml_to_dag(buster->resolved_root, config);
-    
-    // Execute DAG
-    bool result = execute_dag(buster->resolved_root);
-    
-    // Determine if we should destroy the DAG
-    bool should_destroy = (config->bust_policy == BUST_IMMEDIATE) || !config->retain_memory;
-    
-    // Clean up
-    if (should_destroy) {
-        destroy_semantic_dag(buster->resolved_root);
-        buster->resolved_root = NULL;
-    }
-    
-    // Free patterns
-    for (size_t i = 0; i < buster->pattern_count; i++) {
-        free_trie_node(buster->patterns[i]);
-    }
-    free(buster->patterns);
-    buster->patterns = NULL;
-    buster->pattern_count = 0;
-    
-    // Free resources
-    axml_free_config(config);
-    free(buster);
-    
-    return result;
+    printf("Watching %s for changes\n", axml_path);
+    fflush(stdout);
+
+    int status;
+    while ((status = axml_watch_wait(watcher, -1)) > 0) {
+        AxmlCompactConfig* updated = axml_parse_compact(axml_path);
+        if (!updated) {
+            // Keep serving the last good configuration
+            fprintf(stderr, "Failed to parse AXML configuration: %s\n", axml_path);
+            continue;
+        }
+
+        if (axml_diff_requires_rebuild(retained->config, updated)) {
+            AxlRetainedDag* rebuilt = load_retained_dag(axl_path, updated);
+            if (rebuilt) {
+                retained_dag_destroy(retained);
+                retained = rebuilt;
+                printf("Configuration reloaded: DAG rebuilt\n");
+            }
+        } else {
+            AxlBindingChanges changes = { .old_config = retained->config, .new_config = updated };
+            size_t count = axml_diff_configs(retained->config, updated, collect_binding_change, &changes);
+            if (count == (size_t)-1 || changes.failed) {
+                fprintf(stderr, "Failed to compare AXML configurations: %s\n", axml_path);
+            }
+            if (count == 0 || count == (size_t)-1 || changes.failed) {
+                free(changes.entries);
+                axml_free_compact_config(updated);
+                continue;
+            }
+
+            // Only the changed concepts' nodes are rebound, and only
+            // their downstream nodes re-resolved
+            if (!rebind_changed_concepts(retained, updated, &changes)) {
+                fprintf(stderr, "Failed to apply AXML bindings to %s\n", axl_path);
+                free(changes.entries);
+                axml_free_compact_config(updated);
+                continue;
+            }
+
+            printf("Configuration reloaded: %zu binding(s) rebound\n", count);
+            for (size_t i = 0; i < changes.count; i++) {
+                static const char* const kinds[] = { "added", "removed", "changed" };
+                printf("  %s.%s %s\n", changes.entries[i].concept_id,
+                       changes.entries[i].name ? changes.entries[i].name : "",
+                       kinds[changes.entries[i].kind]);
+            }
+            free(changes.entries);
+            retained_release_configs(retained);
+            report_snapshot(axl_path, retained->versioned);
+        }
+        fflush(stdout);
+    }
+
+    retained_dag_destroy(retained);
+    axml_watch_destroy(watcher);
+    return status == 0;
+}
+
+// Compile-server path: parsed configurations and frozen DAGs stay in
+// `cache` and are only rebuilt when their source file changes
+bool execute_axl_cached(AxlCache* cache, const char* axl_path, const char* axml_path) {
+    if (!cache) return execute_axl_with_busting(axl_path, axml_path);
+
+    // Stamps are taken before the files are read (see axl_cache_put)
+    AxlCacheStamp stamp;
+    AxmlCompactConfig* config = axl_cache_get(cache, AXL_CACHE_CONFIG, axml_path, &stamp);
+    if (!config) {
+        config = axml_parse_compact(axml_path);
+        if (!config) {
+            fprintf(stderr, "Failed to parse AXML configuration: %s\n", axml_path);
+            return false;
+        }
+        if (!axl_cache_put(cache, AXL_CACHE_CONFIG, &stamp, config,
+                           (AxlCacheFreeFn)axml_free_compact_config)) {
+            axml_free_compact_config(config);
+            return execute_axl_with_busting(axl_path, axml_path);
+        }
+    }
+
+    // Bindings are applied as an overlay, so one frozen DAG serves every
+    // configuration that builds it the same way. A DAG scanned with
+    // loaded patterns may tokenize differently, so it is not shared.
+    bool shared = !axl_semantic_has_patterns();
+    AxlFrozenDag* frozen = shared ? axl_cache_get(cache, AXL_CACHE_DAG, axl_path, &stamp) : NULL;
+    if (!frozen || frozen->hash_cons != config->hash_cons ||
+        frozen->order != axl_semantic_freeze_order()) {
+        frozen = load_frozen_dag(axl_path, config);
+        if (!frozen) return false;
+
+        if (!shared || !axl_cache_put(cache, AXL_CACHE_DAG, &stamp, frozen, axl_frozen_destroy)) {
+            // Uncached DAGs are freed at the end of the request
+            bool result = resolve_frozen_dag(axl_path, frozen, config);
+            axl_frozen_destroy(frozen);
+            return result;
+        }
+    }
+
+    return resolve_frozen_dag(axl_path, frozen, config);
 }
@@ -0,0 +1,426 @@
+// src/core/integration/estimate.c
+#include <axl/core/integration/estimate.h>
+#include <axl/core/integration/semantic.h>
+#include <axl/core/axml/parser.h>
+#include <axl/core/dag.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/dag/snapshot.h>
+#include <axl/core/utils/source.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Per-allocation bookkeeping of a typical malloc, used in byte estimates
+#define ESTIMATE_MALLOC_OVERHEAD 16
+
+/// 64-bit key -> 32-bit id map (open addressing), for symbol names and
+/// the structural keys of hash-consed nodes.
+typedef struct {
+    uint64_t *keys;            // 0 = empty
+    uint32_t *ids;
+    size_t    capacity;        // Power of two
+    size_t    count;
+} KeyMap;
+
+static bool key_map_grow(KeyMap *map) {
+    size_t capacity = map->capacity ? map->capacity * 2 : 256;
+    uint64_t *keys = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+    uint32_t *ids = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    if (!keys || !ids) {
+        free(keys);
+        free(ids);
+        return false;
+    }
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (!map->keys[i]) continue;
+        size_t slot = map->keys[i] & (capacity - 1);
+        while (keys[slot]) slot = (slot + 1) & (capacity - 1);
+        keys[slot] = map->keys[i];
+        ids[slot] = map->ids[i];
+    }
+    free(map->keys);
+    free(map->ids);
+    map->keys = keys;
+    map->ids = ids;
+    map->capacity = capacity;
+    return true;
+}
+
+/// Id of `key`, adding it with `next_id` if absent. Sets *added.
+static bool key_map_intern(KeyMap *map, uint64_t key, uint32_t next_id,
+                           uint32_t *id, bool *added) {
+    if (key == 0) key = 1;
+    if ((map->count + 1) * 2 > map->capacity && !key_map_grow(map)) return false;
+
+    size_t slot = key & (map->capacity - 1);
+    while (map->keys[slot]) {
+        if (map->keys[slot] == key) {
+            *id = map->ids[slot];
+            *added = false;
+            return true;
+        }
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+    map->keys[slot] = key;
+    map->ids[slot] = next_id;
+    map->count++;
+    *id = next_id;
+    *added = true;
+    return true;
+}
+
+static void key_map_free(KeyMap *map) {
+    free(map->keys);
+    free(map->ids);
+}
+
+static uint64_t hash_mix(uint64_t h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t hash_text(const char *text, size_t len) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (unsigned char)text[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+static uint64_t hash_weight(float weight) {
+    uint32_t bits;
+    memcpy(&bits, &weight, sizeof(bits));
+    return bits;
+}
+
+/* ---------------------------------------------------------------------------
+ * Shape recorder
+ *
+ * Driven by axl_semantic_parse() with the same reductions the DAG
+ * builder gets, so the counts are those of the DAG that would be built.
+ * Handles are plain node index + 1. Each plain node also records its id
+ * in the hash-consed DAG, where literals collapse into one node and an
+ * operation with the same kind and sources as an earlier one is shared.
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    // Plain DAG
+    size_t    node_count;
+    size_t    node_capacity;
+    uint32_t *canonical;       // Hash-consed id of each plain node
+    uint32_t *edge_from;
+    uint32_t *edge_to;
+    size_t    edge_count;
+    size_t    edge_capacity;
+    KeyMap    symbols;         // Name hash -> plain node index
+
+    // Hash-consed DAG
+    size_t    shared_count;
+    size_t    shared_capacity;
+    uint8_t  *shared_ends;     // Bit 0: has in-edges, bit 1: has out-edges
+    size_t    shared_edges;
+    KeyMap    shared;          // Structural key -> hash-consed id
+
+    size_t    tokens;
+    size_t    statements;
+} EstimateShape;
+
+static bool shape_reserve(void **array, size_t *capacity, size_t needed, size_t item_size) {
+    if (needed <= *capacity) return true;
+
+    size_t grown = *capacity ? *capacity * 2 : 256;
+    while (grown < needed) grown *= 2;
+    void *items = realloc(*array, grown * item_size);
+    if (!items) return false;
+    *array = items;
+    *capacity = grown;
+    return true;
+}
+
+static uint32_t shape_new_shared(EstimateShape *shape) {
+    if (!shape_reserve((void **)&shape->shared_ends, &shape->shared_capacity,
+                       shape->shared_count + 1, sizeof(uint8_t))) {
+        return UINT32_MAX;
+    }
+    shape->shared_ends[shape->shared_count] = 0;
+    return (uint32_t)shape->shared_count++;
+}
+
+/// Add a plain node whose hash-consed id is `canonical`; returns its handle.
+static uintptr_t shape_new_node(EstimateShape *shape, uint32_t canonical) {
+    if (canonical == UINT32_MAX ||
+        !shape_reserve((void **)&shape->canonical, &shape->node_capacity,
+                       shape->node_count + 1, sizeof(uint32_t))) {
+        return 0;
+    }
+    shape->canonical[shape->node_count] = canonical;
+    shape->tokens++;
+    return ++shape->node_count;
+}
+
+static bool shape_add_edge(EstimateShape *shape, uintptr_t from, uintptr_t to) {
+    size_t capacity = shape->edge_capacity;
+    if (!shape_reserve((void **)&shape->edge_from, &capacity, shape->edge_count + 1, sizeof(uint32_t)) ||
+        !shape_reserve((void **)&shape->edge_to, &shape->edge_capacity, shape->edge_count + 1,
+                       sizeof(uint32_t))) {
+        return false;
+    }
+    shape->edge_from[shape->edge_count] = (uint32_t)(from - 1);
+    shape->edge_to[shape->edge_count] = (uint32_t)(to - 1);
+    shape->edge_count++;
+    return true;
+}
+
+static void shape_add_shared_edge(EstimateShape *shape, uint32_t from, uint32_t to) {
+    shape->shared_ends[from] |= 2;
+    shape->shared_ends[to] |= 1;
+    shape->shared_edges++;
+}
+
+static uintptr_t shape_symbol(void *ctx, const char *name, size_t len) {
+    EstimateShape *shape = (EstimateShape *)ctx;
+    uint32_t index;
+    bool added;
+    if (!key_map_intern(&shape->symbols, hash_text(name, len), (uint32_t)shape->node_count,
+                        &index, &added)) {
+        return 0;
+    }
+    if (!added) {
+        shape->tokens++;
+        return (uintptr_t)index + 1;
+    }
+
+    // Identifiers are never interned: one node per name either way
+    return shape_new_node(shape, shape_new_shared(shape));
+}
+
+static uintptr_t shape_literal(void *ctx) {
+    EstimateShape *shape = (EstimateShape *)ctx;
+    uint32_t id;
+    bool added;
+    uint64_t key = hash_mix((uint64_t)TOKEN_LITERAL, (uint64_t)NOUN_OBJECT);
+    if (!key_map_intern(&shape->shared, key, (uint32_t)shape->shared_count, &id, &added)) {
+        return 0;
+    }
+    if (added && shape_new_shared(shape) == UINT32_MAX) return 0;
+    return shape_new_node(shape, id);
+}
+
+static uintptr_t shape_operation(void *ctx, TokenType type, TaxonomyCategory category,
+                                 uintptr_t lhs, float lhs_weight,
+                                 uintptr_t rhs, float rhs_weight) {
+    EstimateShape *shape = (EstimateShape *)ctx;
+
+    // dag_node_intern orders sources by creation, i.e. by hash-consed id
+    uint32_t a = shape->canonical[lhs - 1], b = shape->canonical[rhs - 1];
+    float wa = lhs_weight, wb = rhs_weight;
+    if (b < a) {
+        uint32_t t = a; a = b; b = t;
+        float w = wa; wa = wb; wb = w;
+    }
+    uint64_t key = hash_mix(hash_mix((uint64_t)type, (uint64_t)category), 2);
+    key = hash_mix(hash_mix(key, a), hash_weight(wa));
+    key = hash_mix(hash_mix(key, b), hash_weight(wb));
+
+    uint32_t id;
+    bool added;
+    if (!key_map_intern(&shape->shared, key, (uint32_t)shape->shared_count, &id, &added)) {
+        return 0;
+    }
+    if (added) {
+        if (shape_new_shared(shape) == UINT32_MAX) return 0;
+        shape_add_shared_edge(shape, a, id);
+        shape_add_shared_edge(shape, b, id);
+    }
+
+    uintptr_t node = shape_new_node(shape, id);
+    if (!node || !shape_add_edge(shape, lhs, node) || !shape_add_edge(shape, rhs, node)) return 0;
+    return node;
+}
+
+static int shape_define(void *ctx, uintptr_t target, uintptr_t value, float weight) {
+    EstimateShape *shape = (EstimateShape *)ctx;
+    (void)weight;
+
+    // Self-definitions fail like dag_add_edge; longer cycles are found
+    // when the depth is computed
+    if (target == value) return DAG_ERR_CYCLE;
+    if (!shape_add_edge(shape, value, target)) return DAG_ERR_NOMEM;
+    shape_add_shared_edge(shape, shape->canonical[value - 1], shape->canonical[target - 1]);
+    return DAG_OK;
+}
+
+static void shape_statement(void *ctx) {
+    ((EstimateShape *)ctx)->statements++;
+}
+
+static void shape_free(EstimateShape *shape) {
+    free(shape->canonical);
+    free(shape->edge_from);
+    free(shape->edge_to);
+    free(shape->shared_ends);
+    key_map_free(&shape->symbols);
+    key_map_free(&shape->shared);
+}
+
+/// Longest chain of the plain DAG, in nodes (Kahn's algorithm).
+/// Fails on a cycle, which the builder would reject.
+static bool shape_max_depth(const EstimateShape *shape, size_t *max_depth) {
+    size_t n = shape->node_count;
+    size_t e = shape->edge_count;
+    uint32_t *offsets = (uint32_t*)calloc(n + 2, sizeof(uint32_t));
+    uint32_t *targets = (uint32_t*)malloc((e + 1) * sizeof(uint32_t));
+    uint32_t *pending = (uint32_t*)calloc(n + 1, sizeof(uint32_t));
+    uint32_t *depth = (uint32_t*)malloc((n + 1) * sizeof(uint32_t));
+    uint32_t *queue = (uint32_t*)malloc((n + 1) * sizeof(uint32_t));
+    bool ok = offsets && targets && pending && depth && queue;
+
+    size_t head = 0, tail = 0;
+    if (ok) {
+        for (size_t i = 0; i < e; i++) {
+            offsets[shape->edge_from[i] + 2]++;
+            pending[shape->edge_to[i]]++;
+        }
+        for (size_t v = 0; v < n; v++) offsets[v + 2] += offsets[v + 1];
+        for (size_t i = 0; i < e; i++) {
+            targets[offsets[shape->edge_from[i] + 1]++] = shape->edge_to[i];
+        }
+
+        *max_depth = 0;
+        for (size_t v = 0; v < n; v++) {
+            depth[v] = 1;
+            if (pending[v] == 0) queue[tail++] = (uint32_t)v;
+        }
+        while (head < tail) {
+            uint32_t v = queue[head++];
+            if (depth[v] > *max_depth) *max_depth = depth[v];
+            for (uint32_t k = offsets[v]; k < offsets[v + 1]; k++) {
+                uint32_t t = targets[k];
+                if (depth[v] + 1 > depth[t]) depth[t] = depth[v] + 1;
+                if (--pending[t] == 0) queue[tail++] = t;
+            }
+        }
+        ok = tail == n;
+    }
+
+    free(offsets);
+    free(targets);
+    free(pending);
+    free(depth);
+    free(queue);
+    return ok;
+}
+
+/// Heap of the pointer-based DAG the builder allocates: one block per
+/// node, one exactly sized edge array per endpoint with edges, and the
+/// builder's node list (doubling from 256).
+static size_t estimate_dag_bytes(size_t nodes, size_t edges, size_t edge_arrays) {
+    size_t list = 256;
+    while (list < nodes) list *= 2;
+    return nodes * (sizeof(DAGNode) + ESTIMATE_MALLOC_OVERHEAD)
+         + edges * 2 * sizeof(DAGEdge)
+         + edge_arrays * ESTIMATE_MALLOC_OVERHEAD
+         + list * sizeof(DAGNode *);
+}
+
+static size_t count_edge_arrays(const EstimateShape *shape, bool hash_cons) {
+    size_t arrays = 0;
+    if (hash_cons) {
+        for (size_t i = 0; i < shape->shared_count; i++) {
+            arrays += (shape->shared_ends[i] & 1) + (shape->shared_ends[i] >> 1);
+        }
+        return arrays;
+    }
+
+    uint8_t *ends = (uint8_t*)calloc(shape->node_count + 1, 1);
+    if (!ends) return shape->edge_count * 2;
+    for (size_t i = 0; i < shape->edge_count; i++) {
+        ends[shape->edge_from[i]] |= 2;
+        ends[shape->edge_to[i]] |= 1;
+    }
+    for (size_t v = 0; v < shape->node_count; v++) {
+        arrays += (ends[v] & 1) + (ends[v] >> 1);
+    }
+    free(ends);
+    return arrays;
+}
+
+/// Parse `data` into a shape; the DAG-size fields follow `hash_cons`.
+static bool estimate_shape(const char* data, size_t size, bool hash_cons,
+                           AxlCostEstimate* out, EstimateShape* shape) {
+    memset(out, 0, sizeof(*out));
+    out->source_bytes = size;
+
+    AxlSemanticReducer reducer = {
+        .ctx = shape,
+        .symbol = shape_symbol,
+        .literal = shape_literal,
+        .operation = shape_operation,
+        .define = shape_define,
+        .statement = shape_statement
+    };
+    if (!axl_semantic_parse(data, size, &reducer, NULL) ||
+        !shape_max_depth(shape, &out->max_depth)) {
+        return false;
+    }
+
+    out->tokens = shape->tokens;
+    out->statements = shape->statements;
+    out->nodes = shape->node_count;
+    out->shared_nodes = shape->shared_count;
+    out->edges = shape->edge_count;
+    out->hash_cons = hash_cons;
+
+    size_t nodes = hash_cons ? shape->shared_count : shape->node_count;
+    size_t edges = hash_cons ? shape->shared_edges : shape->edge_count;
+    out->dag_bytes = estimate_dag_bytes(nodes, edges, count_edge_arrays(shape, hash_cons));
+    out->resolve_work = nodes + edges;
+    return true;
+}
+
+bool axl_estimate_source(const char* data, size_t size, AxlCostEstimate* out) {
+    if (!data || !out) return false;
+
+    EstimateShape shape = {0};
+    bool ok = estimate_shape(data, size, false, out, &shape);
+    shape_free(&shape);
+    return ok;
+}
+
+bool axl_estimate_cost(const char* axl_path, const char* axml_path, AxlCostEstimate* out) {
+    if (!axl_path || !axml_path || !out) return false;
+
+    AxmlCompactConfig* config = axml_parse_compact(axml_path);
+    if (!config) return false;
+
+    AxlSource source;
+    if (!axl_source_open(axl_path, &source)) {
+        axml_free_compact_config(config);
+        return false;
+    }
+
+    EstimateShape shape = {0};
+    bool ok = estimate_shape(source.data, source.size, config->hash_cons, out, &shape);
+    axl_source_close(&source);
+
+    if (ok) {
+        out->bindings = config->binding_count;
+        out->resolve_work += out->bindings;
+
+        // A retained DAG keeps its CSR block and one set of snapshot pages
+        bool retained = config->bust_policy != BUST_IMMEDIATE && config->retain_memory;
+        size_t nodes = config->hash_cons ? shape.shared_count : shape.node_count;
+        size_t edges = config->hash_cons ? shape.shared_edges : shape.edge_count;
+        size_t pages = (nodes + DAG_SNAPSHOT_PAGE_MASK) >> DAG_SNAPSHOT_PAGE_SHIFT;
+        out->retained_bytes = retained ? dag_csr_block_bytes(nodes, edges) +
+                                         pages * sizeof(DAGSnapshotPage) : 0;
+    }
+
+    shape_free(&shape);
+    axml_free_compact_config(config);
+    return ok;
+}
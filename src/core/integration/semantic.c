@@ -0,0 +1,1006 @@
+// src/core/integration/semantic.c
+#include <axl/core/integration/semantic.h>
+#include <axl/core/taxonomy.h>
+#include <axl/core/trie/scanner.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Parentheses deeper than this are rejected rather than recursed into
+#define SEMANTIC_MAX_NESTING 256
+
+/* ---------------------------------------------------------------------------
+ * Symbol table (open addressing, names pooled)
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t  name;            // Offset in `names`
+    uint32_t  length;          // 0 = empty slot
+    DAGNode  *node;            // While building
+    uint32_t  id;              // Once frozen
+} AxlSymbol;
+
+struct AxlSymbols {
+    AxlSymbol *slots;
+    size_t     capacity;       // Power of two
+    size_t     count;
+    char      *names;          // NUL-terminated names, back to back
+    size_t     names_size;
+    size_t     names_capacity;
+};
+
+static uint64_t symbol_hash(const char *name, size_t len) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (unsigned char)name[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+static AxlSymbols* symbols_create(void) {
+    AxlSymbols *symbols = (AxlSymbols *)calloc(1, sizeof(AxlSymbols));
+    if (!symbols) return NULL;
+
+    symbols->capacity = 64;
+    symbols->slots = (AxlSymbol *)calloc(symbols->capacity, sizeof(AxlSymbol));
+    if (!symbols->slots) {
+        free(symbols);
+        return NULL;
+    }
+    return symbols;
+}
+
+static void symbols_destroy(AxlSymbols *symbols) {
+    if (!symbols) return;
+    free(symbols->slots);
+    free(symbols->names);
+    free(symbols);
+}
+
+/// Slot holding `name`, or the empty slot where it would go.
+static AxlSymbol* symbols_slot(const AxlSymbols *symbols, const char *name, size_t len) {
+    size_t mask = symbols->capacity - 1;
+    size_t slot = (size_t)symbol_hash(name, len) & mask;
+    while (symbols->slots[slot].length) {
+        AxlSymbol *entry = &symbols->slots[slot];
+        if (entry->length == len && memcmp(symbols->names + entry->name, name, len) == 0) {
+            return entry;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return &symbols->slots[slot];
+}
+
+static bool symbols_grow(AxlSymbols *symbols) {
+    size_t capacity = symbols->capacity * 2;
+    AxlSymbol *slots = (AxlSymbol *)calloc(capacity, sizeof(AxlSymbol));
+    if (!slots) return false;
+
+    for (size_t i = 0; i < symbols->capacity; i++) {
+        const AxlSymbol *entry = &symbols->slots[i];
+        if (!entry->length) continue;
+
+        size_t slot = (size_t)symbol_hash(symbols->names + entry->name, entry->length) & (capacity - 1);
+        while (slots[slot].length) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = *entry;
+    }
+
+    free(symbols->slots);
+    symbols->slots = slots;
+    symbols->capacity = capacity;
+    return true;
+}
+
+/// Add `name` (known to be absent) for `node`.
+static bool symbols_insert(AxlSymbols *symbols, const char *name, size_t len, DAGNode *node) {
+    if (len >= UINT32_MAX || symbols->names_size + len + 1 >= UINT32_MAX) return false;
+
+    // Keep the load factor at or below 1/2
+    if ((symbols->count + 1) * 2 > symbols->capacity && !symbols_grow(symbols)) {
+        return false;
+    }
+
+    if (symbols->names_size + len + 1 > symbols->names_capacity) {
+        size_t capacity = symbols->names_capacity ? symbols->names_capacity * 2 : 1024;
+        while (capacity < symbols->names_size + len + 1) capacity *= 2;
+        char *names = (char *)realloc(symbols->names, capacity);
+        if (!names) return false;
+        symbols->names = names;
+        symbols->names_capacity = capacity;
+    }
+
+    AxlSymbol *entry = symbols_slot(symbols, name, len);
+    entry->name = (uint32_t)symbols->names_size;
+    entry->length = (uint32_t)len;
+    entry->node = node;
+    memcpy(symbols->names + symbols->names_size, name, len);
+    symbols->names[symbols->names_size + len] = '\0';
+    symbols->names_size += len + 1;
+    symbols->count++;
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Tokens
+ * ------------------------------------------------------------------------- */
+
+// Loaded patterns scanned instead of the generated DFA, if set
+static TrieNode *const *semantic_patterns;
+static size_t           semantic_pattern_count;
+
+void axl_semantic_set_patterns(TrieNode *const *patterns, size_t count) {
+    semantic_patterns = patterns;
+    semantic_pattern_count = patterns ? count : 0;
+}
+
+bool axl_semantic_has_patterns(void) {
+    return semantic_patterns != NULL;
+}
+
+typedef struct {
+    const char      *data;
+    size_t           size;
+    TrieNode *const *patterns;     // NULL = the generated scanner
+    size_t           pattern_count;
+    const AxlSemanticTokens *tokens;   // Lexed ahead, or NULL to scan
+    size_t           next;         // Next token in `tokens`
+    size_t           pos;          // Next unread byte
+    size_t           offset;       // Current token
+    size_t           length;       // 0 at end of input
+    TokenType        type;
+    TaxonomyCategory category;
+    float            weight;
+} SemanticLexer;
+
+static bool lexer_fail(AxlSemanticError *error, size_t offset, const char *message) {
+    error->offset = offset;
+    error->message = message;
+    return false;
+}
+
+/// Take the next token of a lexed-ahead array.
+static bool lexer_next_token(SemanticLexer *lx, AxlSemanticError *error) {
+    const AxlSemanticTokens *tokens = lx->tokens;
+    if (lx->next == tokens->count) {
+        if (tokens->failed) return lexer_fail(error, tokens->error.offset, tokens->error.message);
+
+        lx->offset = lx->pos = lx->size;
+        lx->length = 0;
+        lx->type = TOKEN_UNKNOWN;
+        lx->category = TAXONOMY_NONE;
+        lx->weight = 0.0f;
+        return true;
+    }
+
+    const AxlSemanticToken *token = &tokens->tokens[lx->next++];
+    lx->offset = token->offset;
+    lx->length = token->length;
+    lx->type = token->type;
+    lx->category = token->category;
+    lx->weight = token->weight;
+    lx->pos = token->offset + token->length;
+    return true;
+}
+
+/// Advance to the next token, skipping whitespace and comments.
+static bool lexer_next(SemanticLexer *lx, AxlSemanticError *error) {
+    if (lx->tokens) return lexer_next_token(lx, error);
+
+    while (lx->pos < lx->size) {
+        const char *p = lx->data + lx->pos;
+        size_t left = lx->size - lx->pos;
+        if (isspace((unsigned char)*p)) {
+            lx->pos++;
+        } else if (left > 1 && p[0] == '/' && p[1] == '/') {
+            const char *eol = (const char *)memchr(p, '\n', left);
+            lx->pos = eol ? (size_t)(eol - lx->data) : lx->size;
+        } else if (left > 1 && p[0] == '/' && p[1] == '*') {
+            size_t q = lx->pos + 2;
+            while (q + 1 < lx->size && !(lx->data[q] == '*' && lx->data[q + 1] == '/')) q++;
+            if (q + 1 >= lx->size) return lexer_fail(error, lx->pos, "unterminated comment");
+            lx->pos = q + 2;
+        } else {
+            break;
+        }
+    }
+
+    lx->offset = lx->pos;
+    lx->length = 0;
+    lx->type = TOKEN_UNKNOWN;
+    lx->category = TAXONOMY_NONE;
+    lx->weight = 0.0f;
+    if (lx->pos == lx->size) return true;
+
+    // Semantic tokens come from the pattern scanner; keywords refine
+    // their token type, and punctuation is only in the keyword table
+    const char *p = lx->data + lx->pos;
+    size_t left = lx->size - lx->pos;
+    TrieScanMatch match;
+    TaxonomyEntry entry;
+    bool scanned = lx->patterns
+        ? trie_scan_interpreted(lx->patterns, lx->pattern_count, p, left, &match)
+        : trie_scan_generated(p, left, &match);
+    if (scanned) {
+        lx->length = match.length;
+        lx->category = match.category;
+        lx->weight = match.weight;
+        if (taxonomy_classify(p, match.length, &entry)) {
+            lx->type = entry.type;
+        } else {
+            lx->type = match.category == NOUN_OBJECT ? TOKEN_LITERAL : TOKEN_IDENT;
+        }
+    } else if (taxonomy_classify(p, 1, &entry) && entry.category == TAXONOMY_NONE) {
+        lx->length = 1;
+        lx->type = entry.type;
+    } else {
+        return lexer_fail(error, lx->pos, *p == '"' ? "unterminated string" : "unexpected character");
+    }
+
+    lx->pos += lx->length;
+    return true;
+}
+
+static bool token_is_identifier(const SemanticLexer *lx) {
+    return lx->type == TOKEN_IDENT && lx->category == NOUN_SUBJECT;
+}
+
+static bool token_is_verb(const SemanticLexer *lx) {
+    return lx->type == TOKEN_ASSIGN || lx->category == VERB_STATE;
+}
+
+/* ---------------------------------------------------------------------------
+ * Lexing ahead, in parallel for large sources
+ * ------------------------------------------------------------------------- */
+
+// Lexer threads for large sources, 0 = every core
+static size_t semantic_lex_threads;
+
+void axl_semantic_set_lex_threads(size_t threads) {
+    semantic_lex_threads = threads;
+}
+
+size_t axl_semantic_lex_threads(size_t size) {
+    if (semantic_patterns) return 1;
+
+    size_t threads = semantic_lex_threads;
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (threads > size / AXL_SEMANTIC_LEX_CHUNK) threads = size / AXL_SEMANTIC_LEX_CHUNK;
+    return threads > 1 ? threads : 1;
+}
+
+void axl_semantic_tokens_free(AxlSemanticTokens *tokens) {
+    if (!tokens) return;
+    free(tokens->tokens);
+    memset(tokens, 0, sizeof(*tokens));
+}
+
+static bool tokens_push(AxlSemanticTokens *tokens, const SemanticLexer *lx) {
+    if (tokens->count == tokens->capacity) {
+        size_t capacity = tokens->capacity ? tokens->capacity * 2 : 256;
+        AxlSemanticToken *grown = (AxlSemanticToken *)realloc(tokens->tokens,
+                                                              capacity * sizeof(AxlSemanticToken));
+        if (!grown) return false;
+        tokens->tokens = grown;
+        tokens->capacity = capacity;
+    }
+
+    tokens->tokens[tokens->count++] = (AxlSemanticToken){
+        .offset = lx->offset,
+        .length = lx->length,
+        .type = lx->type,
+        .category = lx->category,
+        .weight = lx->weight
+    };
+    return true;
+}
+
+static bool tokens_append(AxlSemanticTokens *tokens, const AxlSemanticToken *from, size_t count) {
+    if (tokens->count + count > tokens->capacity) {
+        size_t capacity = tokens->capacity ? tokens->capacity : 256;
+        while (capacity < tokens->count + count) capacity *= 2;
+        AxlSemanticToken *grown = (AxlSemanticToken *)realloc(tokens->tokens,
+                                                              capacity * sizeof(AxlSemanticToken));
+        if (!grown) return false;
+        tokens->tokens = grown;
+        tokens->capacity = capacity;
+    }
+
+    if (count > 0) memcpy(tokens->tokens + tokens->count, from, count * sizeof(AxlSemanticToken));
+    tokens->count += count;
+    return true;
+}
+
+/// Every token of data[pos..size) up to the first lexical error.
+static bool lex_serial(const char *data, size_t size, AxlSemanticTokens *out) {
+    SemanticLexer lx = {
+        .data = data,
+        .size = size,
+        .patterns = semantic_patterns,
+        .pattern_count = semantic_pattern_count
+    };
+
+    for (;;) {
+        if (!lexer_next(&lx, &out->error)) {
+            out->failed = true;
+            return true;
+        }
+        if (lx.length == 0) return true;
+        if (!tokens_push(out, &lx)) return false;
+    }
+}
+
+/// What a chunk boundary, which always follows a newline, can be inside.
+typedef enum {
+    LEX_CODE = 0,
+    LEX_IN_STRING,
+    LEX_IN_COMMENT,
+    LEX_STATE_COUNT
+} LexState;
+
+#define LEX_NOT_CONVERGED SIZE_MAX
+
+/// One chunk lexed from one entry state.
+typedef struct {
+    AxlSemanticTokens tokens;      // `failed` if a lexical error ends the run
+    bool     continues;            // The construct open at entry spans the chunk
+    bool     broken;               // The string open at entry can never close
+    LexState exit;                 // Construct open at the end of the chunk
+    size_t   open;                 // Where that construct started
+    size_t   converged;            // Token index where this run joins the LEX_CODE run
+} LexRun;
+
+/// Find the closing quote of a string body starting at data[p], reading
+/// it as the string pattern of patterns.spec does ("([^"\\]|\\.)*" with
+/// '.' never NUL). Returns true with *close just past the quote; false
+/// with *close = `end` if the body runs past `end`, or SIZE_MAX if an
+/// escaped NUL means it can never close.
+static bool lex_string_close(const char *data, size_t p, size_t end, size_t *close) {
+    while (p < end && data[p] != '"') {
+        if (data[p] == '\\') {
+            if (p + 1 < end && data[p + 1] == '\0') {
+                *close = SIZE_MAX;
+                return false;
+            }
+            p += 2;
+        } else {
+            p++;
+        }
+    }
+    *close = p < end ? p + 1 : end;
+    return p < end;
+}
+
+/// Find the end of a block comment body starting at data[p].
+static bool lex_comment_close(const char *data, size_t p, size_t end, size_t *close) {
+    while (p + 1 < end && !(data[p] == '*' && data[p + 1] == '/')) p++;
+    *close = p + 1 < end ? p + 2 : end;
+    return p + 1 < end;
+}
+
+/**
+ * Lex data[begin..end) entered in `state`. A string or comment still open
+ * at `end` ends the run with `exit` set instead of failing, since a later
+ * chunk may close it. With `converge` (the LEX_CODE run of the same
+ * chunk), stop at the first token it also has: lexing is deterministic
+ * from there, so the rest would be identical.
+ */
+static bool lex_run(const char *data, size_t begin, size_t end, LexState state,
+                    const LexRun *converge, LexRun *run) {
+    run->converged = LEX_NOT_CONVERGED;
+    run->exit = LEX_CODE;
+
+    size_t pos = begin;
+    if (state != LEX_CODE) {
+        bool closed = state == LEX_IN_STRING ? lex_string_close(data, begin, end, &pos)
+                                             : lex_comment_close(data, begin, end, &pos);
+        if (!closed) {
+            run->continues = true;
+            run->broken = pos == SIZE_MAX;
+            run->exit = state;
+            return true;
+        }
+    }
+
+    SemanticLexer lx = { .data = data, .size = end, .pos = pos };
+    size_t cursor = 0;
+    for (;;) {
+        AxlSemanticError error;
+        if (!lexer_next(&lx, &error)) {
+            // lexer_next() only fails at an opening quote or "/*" when the
+            // construct does not close before `end`
+            size_t close = 0;
+            size_t at = error.offset;
+            if (data[at] == '"' && !lex_string_close(data, at + 1, end, &close) && close == end) {
+                run->exit = LEX_IN_STRING;
+            } else if (data[at] == '/' && at + 1 < end && data[at + 1] == '*') {
+                run->exit = LEX_IN_COMMENT;
+            } else {
+                run->tokens.failed = true;
+                run->tokens.error = error;
+                return true;
+            }
+            run->open = at;
+            return true;
+        }
+        if (lx.length == 0) return true;
+
+        if (converge) {
+            const AxlSemanticTokens *base = &converge->tokens;
+            while (cursor < base->count && base->tokens[cursor].offset < lx.offset) cursor++;
+            if (cursor < base->count && base->tokens[cursor].offset == lx.offset) {
+                run->converged = cursor;
+                return true;
+            }
+        }
+        if (!tokens_push(&run->tokens, &lx)) return false;
+    }
+}
+
+typedef struct {
+    const char   *data;
+    const size_t *bounds;          // chunk_count + 1 offsets
+    size_t        chunk_count;
+    LexRun       *runs;            // chunk_count * LEX_STATE_COUNT
+    atomic_size_t next;            // Next chunk to claim
+    atomic_bool   failed;
+} LexJob;
+
+static void* lex_worker(void *arg) {
+    LexJob *job = (LexJob *)arg;
+
+    for (;;) {
+        size_t c = atomic_fetch_add(&job->next, 1);
+        if (c >= job->chunk_count) break;
+
+        LexRun *runs = &job->runs[c * LEX_STATE_COUNT];
+        size_t begin = job->bounds[c];
+        size_t end = job->bounds[c + 1];
+
+        // The first chunk can only start in code
+        bool ok = lex_run(job->data, begin, end, LEX_CODE, NULL, &runs[LEX_CODE]);
+        for (int s = LEX_CODE + 1; ok && c > 0 && s < LEX_STATE_COUNT; s++) {
+            ok = lex_run(job->data, begin, end, (LexState)s, &runs[LEX_CODE], &runs[s]);
+        }
+        if (!ok) {
+            atomic_store(&job->failed, true);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/// Split after newlines into up to `count` chunks; returns the chunk count.
+static size_t lex_split(const char *data, size_t size, size_t count, size_t *bounds) {
+    size_t chunks = 0;
+    bounds[0] = 0;
+
+    for (size_t i = 1; i < count; i++) {
+        size_t target = size / count * i;
+        if (target <= bounds[chunks]) continue;
+
+        const char *newline = (const char *)memchr(data + target, '\n', size - target);
+        if (!newline) break;
+
+        size_t bound = (size_t)(newline - data) + 1;
+        if (bound < size) bounds[++chunks] = bound;
+    }
+
+    bounds[++chunks] = size;
+    return chunks;
+}
+
+/// Follow the real entry state through the chunks, collecting the runs
+/// that apply. A string that closes in a later chunk is lexed again as
+/// one token once its end is known.
+static bool lex_stitch(const char *data, size_t size, const LexRun *runs, size_t chunk_count,
+                       AxlSemanticTokens *out) {
+    LexState state = LEX_CODE;
+    size_t open = 0;
+
+    for (size_t c = 0; c < chunk_count; c++) {
+        const LexRun *base = &runs[c * LEX_STATE_COUNT];
+        const LexRun *run = &base[state];
+
+        if (run->broken) break;
+        if (run->continues) continue;
+
+        if (state == LEX_IN_STRING) {
+            SemanticLexer lx = { .data = data, .size = size, .pos = open };
+            if (!lexer_next(&lx, &out->error)) {
+                out->failed = true;
+                return true;
+            }
+            if (!tokens_push(out, &lx)) return false;
+        }
+
+        if (!tokens_append(out, run->tokens.tokens, run->tokens.count)) return false;
+        if (run->converged != LEX_NOT_CONVERGED) {
+            if (!tokens_append(out, base->tokens.tokens + run->converged,
+                               base->tokens.count - run->converged)) {
+                return false;
+            }
+            run = base;
+        }
+
+        if (run->tokens.failed) {
+            out->failed = true;
+            out->error = run->tokens.error;
+            return true;
+        }
+        state = run->exit;
+        open = run->open;
+    }
+
+    if (state != LEX_CODE) {
+        lexer_fail(&out->error, open, state == LEX_IN_STRING ? "unterminated string"
+                                                             : "unterminated comment");
+        out->failed = true;
+    }
+    return true;
+}
+
+bool axl_semantic_lex(const char *data, size_t size, size_t threads, AxlSemanticTokens *out) {
+    if ((!data && size > 0) || !out) return false;
+    memset(out, 0, sizeof(*out));
+
+    if (semantic_patterns) threads = 1;
+    if (threads > size) threads = size;
+    if (threads <= 1) {
+        if (lex_serial(data, size, out)) return true;
+        axl_semantic_tokens_free(out);
+        return false;
+    }
+
+    size_t *bounds = (size_t *)malloc((threads + 1) * sizeof(size_t));
+    LexRun *runs = (LexRun *)calloc(threads * LEX_STATE_COUNT, sizeof(LexRun));
+    pthread_t *workers = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    bool ok = bounds && runs && workers;
+
+    LexJob job = { .data = data, .bounds = bounds, .runs = runs };
+    atomic_init(&job.next, 0);
+    atomic_init(&job.failed, false);
+
+    if (ok) {
+        job.chunk_count = lex_split(data, size, threads, bounds);
+
+        // The calling thread works too; spawn failures just mean fewer helpers
+        size_t spawned = 0;
+        for (size_t t = 1; t < job.chunk_count; t++) {
+            if (pthread_create(&workers[spawned], NULL, lex_worker, &job) == 0) {
+                spawned++;
+            }
+        }
+        lex_worker(&job);
+
+        for (size_t t = 0; t < spawned; t++) {
+            pthread_join(workers[t], NULL);
+        }
+        ok = !atomic_load(&job.failed) && lex_stitch(data, size, runs, job.chunk_count, out);
+    }
+
+    for (size_t i = 0; runs && i < job.chunk_count * LEX_STATE_COUNT; i++) {
+        axl_semantic_tokens_free(&runs[i].tokens);
+    }
+    free(workers);
+    free(runs);
+    free(bounds);
+
+    if (!ok) axl_semantic_tokens_free(out);
+    return ok;
+}
+
+/* ---------------------------------------------------------------------------
+ * Parser
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    SemanticLexer             lexer;
+    const AxlSemanticReducer *reducer;
+    AxlSemanticError         *error;
+    unsigned                  depth;
+} SemanticParser;
+
+static bool parse_expr(SemanticParser *parser, uintptr_t *value, float *weight);
+
+static bool parse_operand(SemanticParser *parser, uintptr_t *value, float *weight) {
+    SemanticLexer *lx = &parser->lexer;
+    const AxlSemanticReducer *r = parser->reducer;
+    size_t offset = lx->offset;
+
+    if (token_is_identifier(lx)) {
+        *value = r->symbol(r->ctx, lx->data + lx->offset, lx->length);
+        *weight = lx->weight;
+    } else if (lx->type == TOKEN_LITERAL) {
+        *value = r->literal(r->ctx);
+        *weight = lx->weight;
+    } else if (lx->type == TOKEN_LPAREN) {
+        if (++parser->depth > SEMANTIC_MAX_NESTING) {
+            return lexer_fail(parser->error, offset, "expression nested too deeply");
+        }
+        if (!lexer_next(lx, parser->error) || !parse_expr(parser, value, weight)) return false;
+        if (lx->type != TOKEN_RPAREN) return lexer_fail(parser->error, lx->offset, "expected ')'");
+        parser->depth--;
+    } else {
+        return lexer_fail(parser->error, offset, "expected an identifier, literal or '('");
+    }
+
+    if (!*value) return lexer_fail(parser->error, offset, "out of memory");
+    return lexer_next(lx, parser->error);
+}
+
+static bool parse_expr(SemanticParser *parser, uintptr_t *value, float *weight) {
+    SemanticLexer *lx = &parser->lexer;
+    const AxlSemanticReducer *r = parser->reducer;
+
+    if (!parse_operand(parser, value, weight)) return false;
+
+    // Left-associative: a + b - c is (a + b) - c
+    while (lx->type == TOKEN_PLUS || lx->type == TOKEN_MINUS) {
+        TokenType type = lx->type;
+        TaxonomyCategory category = lx->category;
+        float op_weight = lx->weight;
+        size_t offset = lx->offset;
+
+        uintptr_t rhs;
+        float rhs_weight;
+        if (!lexer_next(lx, parser->error) || !parse_operand(parser, &rhs, &rhs_weight)) {
+            return false;
+        }
+
+        *value = r->operation(r->ctx, type, category, *value, *weight, rhs, rhs_weight);
+        *weight = op_weight;
+        if (!*value) return lexer_fail(parser->error, offset, "out of memory");
+    }
+    return true;
+}
+
+static bool parse_statement(SemanticParser *parser) {
+    SemanticLexer *lx = &parser->lexer;
+    const AxlSemanticReducer *r = parser->reducer;
+
+    if (lx->type == TOKEN_LET || lx->type == TOKEN_CONST || lx->type == TOKEN_VAR) {
+        if (!lexer_next(lx, parser->error)) return false;
+    }
+    if (!token_is_identifier(lx)) {
+        return lexer_fail(parser->error, lx->offset, "expected an identifier");
+    }
+
+    size_t target_offset = lx->offset;
+    uintptr_t target = r->symbol(r->ctx, lx->data + lx->offset, lx->length);
+    if (!target) return lexer_fail(parser->error, target_offset, "out of memory");
+    if (!lexer_next(lx, parser->error)) return false;
+
+    if (token_is_verb(lx)) {
+        uintptr_t value;
+        float weight;
+        if (!lexer_next(lx, parser->error) || !parse_expr(parser, &value, &weight)) return false;
+
+        int status = r->define(r->ctx, target, value, weight);
+        if (status == DAG_ERR_CYCLE) {
+            return lexer_fail(parser->error, target_offset, "definition makes the identifier depend on itself");
+        }
+        if (status != DAG_OK) return lexer_fail(parser->error, target_offset, "out of memory");
+    }
+
+    // The last statement may omit its ';'
+    if (lx->type == TOKEN_SEMICOLON) {
+        if (!lexer_next(lx, parser->error)) return false;
+    } else if (lx->length != 0) {
+        return lexer_fail(parser->error, lx->offset, "expected ';'");
+    }
+
+    if (r->statement) r->statement(r->ctx);
+    return true;
+}
+
+static bool parse_source(SemanticParser *parser) {
+    SemanticLexer *lx = &parser->lexer;
+
+    if (!lexer_next(lx, parser->error)) return false;
+    while (lx->length != 0) {
+        if (lx->type == TOKEN_SEMICOLON) {
+            if (!lexer_next(lx, parser->error)) return false;
+        } else if (!parse_statement(parser)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool axl_semantic_parse(const char *data, size_t size,
+                        const AxlSemanticReducer *reducer, AxlSemanticError *error) {
+    AxlSemanticError ignored;
+    if (!error) error = &ignored;
+    if ((!data && size > 0) || !reducer) return lexer_fail(error, 0, "invalid arguments");
+
+    SemanticParser parser = {
+        .lexer = {
+            .data = data,
+            .size = size,
+            .patterns = semantic_patterns,
+            .pattern_count = semantic_pattern_count
+        },
+        .reducer = reducer,
+        .error = error
+    };
+
+    // Large sources are lexed ahead on several threads; a lexical error
+    // still surfaces only when the parser reaches it
+    AxlSemanticTokens tokens = {0};
+    size_t threads = axl_semantic_lex_threads(size);
+    if (threads > 1) {
+        if (!axl_semantic_lex(data, size, threads, &tokens)) return lexer_fail(error, 0, "out of memory");
+        parser.lexer.tokens = &tokens;
+    }
+
+    bool ok = parse_source(&parser);
+    axl_semantic_tokens_free(&tokens);
+    return ok;
+}
+
+/* ---------------------------------------------------------------------------
+ * DAG builder
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    AxlSemanticDag *dag;
+    DAGConsTable   *cons;
+} SemanticBuilder;
+
+/// Make room for one more node, so recording a new node cannot fail.
+static bool builder_reserve(AxlSemanticDag *dag) {
+    if (dag->node_count < dag->capacity) return true;
+
+    size_t capacity = dag->capacity ? dag->capacity * 2 : 256;
+    DAGNode **nodes = (DAGNode **)realloc(dag->nodes, capacity * sizeof(DAGNode *));
+    if (!nodes) return false;
+    dag->nodes = nodes;
+    dag->capacity = capacity;
+    return true;
+}
+
+static DAGNode* builder_create(AxlSemanticDag *dag, TokenType type, TaxonomyCategory category) {
+    if (!builder_reserve(dag)) return NULL;
+
+    DAGNode *node = dag_node_create(type, category);
+    if (node) dag->nodes[dag->node_count++] = node;
+    return node;
+}
+
+static uintptr_t builder_intern(SemanticBuilder *b, TokenType type, TaxonomyCategory category,
+                                const DAGEdge *edges, size_t count) {
+    if (!builder_reserve(b->dag)) return 0;
+
+    size_t created = dag_cons_stats(b->cons).created;
+    DAGNode *node = dag_node_intern(b->cons, type, category, edges, count);
+    if (node && dag_cons_stats(b->cons).created != created) {
+        b->dag->nodes[b->dag->node_count++] = node;
+        b->dag->edge_count += count;
+    }
+    return (uintptr_t)node;
+}
+
+static uintptr_t build_symbol(void *ctx, const char *name, size_t len) {
+    SemanticBuilder *b = (SemanticBuilder *)ctx;
+    AxlSymbol *entry = symbols_slot(b->dag->symbols, name, len);
+    if (entry->length) return (uintptr_t)entry->node;
+
+    DAGNode *node = builder_create(b->dag, TOKEN_IDENT, NOUN_SUBJECT);
+    if (!node || !symbols_insert(b->dag->symbols, name, len, node)) return 0;
+    return (uintptr_t)node;
+}
+
+static uintptr_t build_literal(void *ctx) {
+    SemanticBuilder *b = (SemanticBuilder *)ctx;
+    if (b->cons) return builder_intern(b, TOKEN_LITERAL, NOUN_OBJECT, NULL, 0);
+    return (uintptr_t)builder_create(b->dag, TOKEN_LITERAL, NOUN_OBJECT);
+}
+
+static uintptr_t build_operation(void *ctx, TokenType type, TaxonomyCategory category,
+                                 uintptr_t lhs, float lhs_weight,
+                                 uintptr_t rhs, float rhs_weight) {
+    SemanticBuilder *b = (SemanticBuilder *)ctx;
+    DAGEdge edges[2] = {
+        { (DAGNode *)lhs, lhs_weight },
+        { (DAGNode *)rhs, rhs_weight }
+    };
+    if (b->cons) return builder_intern(b, type, category, edges, 2);
+
+    // Operands are older than the new node, so neither edge reorders
+    DAGNode *node = builder_create(b->dag, type, category);
+    for (size_t i = 0; node && i < 2; i++) {
+        if (dag_add_edge(edges[i].target, node, edges[i].weight) != DAG_OK) return 0;
+        b->dag->edge_count++;
+    }
+    return (uintptr_t)node;
+}
+
+static int build_define(void *ctx, uintptr_t target, uintptr_t value, float weight) {
+    SemanticBuilder *b = (SemanticBuilder *)ctx;
+    int status = dag_add_edge((DAGNode *)value, (DAGNode *)target, weight);
+    if (status == DAG_OK) b->dag->edge_count++;
+    return status;
+}
+
+static void build_statement(void *ctx) {
+    ((SemanticBuilder *)ctx)->dag->statements++;
+}
+
+bool axl_semantic_build(const char *data, size_t size, DAGConsTable *cons,
+                        AxlSemanticDag *dag, AxlSemanticError *error) {
+    AxlSemanticError ignored;
+    if (!error) error = &ignored;
+    if (!dag) return lexer_fail(error, 0, "invalid arguments");
+
+    memset(dag, 0, sizeof(*dag));
+    dag->hash_cons = cons != NULL;
+    dag->symbols = symbols_create();
+    if (!dag->symbols) return lexer_fail(error, 0, "out of memory");
+
+    SemanticBuilder builder = { .dag = dag, .cons = cons };
+    AxlSemanticReducer reducer = {
+        .ctx = &builder,
+        .symbol = build_symbol,
+        .literal = build_literal,
+        .operation = build_operation,
+        .define = build_define,
+        .statement = build_statement
+    };
+
+    if (!axl_semantic_parse(data, size, &reducer, error)) {
+        axl_semantic_destroy(dag);
+        return false;
+    }
+    return true;
+}
+
+void axl_semantic_destroy(AxlSemanticDag *dag) {
+    if (!dag) return;
+
+    for (size_t i = 0; i < dag->node_count; i++) {
+        dag_node_destroy(dag->nodes[i]);
+    }
+    free(dag->nodes);
+    symbols_destroy(dag->symbols);
+    memset(dag, 0, sizeof(*dag));
+}
+
+/* ---------------------------------------------------------------------------
+ * Frozen form
+ * ------------------------------------------------------------------------- */
+
+static int node_ord_compare(const void *a, const void *b) {
+    size_t oa = (*(DAGNode * const *)a)->ord;
+    size_t ob = (*(DAGNode * const *)b)->ord;
+    return (oa > ob) - (oa < ob);
+}
+
+/// Position of `node` in `sorted` (ascending ord), found by its ord.
+static uint32_t frozen_id(DAGNode *const *sorted, size_t count, const DAGNode *node) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (sorted[mid]->ord < node->ord) lo = mid + 1;
+        else hi = mid;
+    }
+    return (uint32_t)lo;
+}
+
+// Layout of frozen DAGs, AXL_FREEZE_ORDER_NONE by default
+static AxlFreezeOrder semantic_freeze_order;
+
+void axl_semantic_set_freeze_order(AxlFreezeOrder order) {
+    semantic_freeze_order = order;
+}
+
+AxlFreezeOrder axl_semantic_freeze_order(void) {
+    return semantic_freeze_order;
+}
+
+/// Lay `frozen` out in `order`, remapping the symbols' node ids.
+static bool frozen_reorder(AxlFrozenDag *frozen, AxlFreezeOrder order) {
+    DAGCsr *csr = frozen->csr;
+    if (order == AXL_FREEZE_ORDER_NONE || csr->node_count == 0) return true;
+
+    DAGOrderKind kind = order == AXL_FREEZE_ORDER_RCM ? DAG_ORDER_RCM : DAG_ORDER_TOPOLOGICAL;
+    uint32_t *layout = dag_csr_locality_order(csr, kind);
+    DAGCsr *reordered = layout ? dag_csr_reorder(csr, layout) : NULL;
+    if (!reordered) {
+        free(layout);
+        return false;
+    }
+
+    // Symbols hold old ids; map them through the inverse layout
+    uint32_t *rank = (uint32_t *)malloc((size_t)csr->node_count * sizeof(uint32_t));
+    if (!rank) {
+        dag_csr_destroy(reordered);
+        free(layout);
+        return false;
+    }
+    for (uint32_t u = 0; u < csr->node_count; u++) {
+        rank[layout[u]] = u;
+    }
+    free(layout);
+
+    AxlSymbols *symbols = frozen->symbols;
+    for (size_t i = 0; i < symbols->capacity; i++) {
+        AxlSymbol *entry = &symbols->slots[i];
+        if (entry->length) entry->id = rank[entry->id];
+    }
+    free(rank);
+
+    dag_csr_destroy(csr);
+    frozen->csr = reordered;
+    return true;
+}
+
+AxlFrozenDag* axl_semantic_freeze(AxlSemanticDag *dag) {
+    if (!dag || !dag->symbols) return NULL;
+
+    AxlFrozenDag *frozen = (AxlFrozenDag *)calloc(1, sizeof(AxlFrozenDag));
+    DAGNode **sorted = (DAGNode **)malloc((dag->node_count + 1) * sizeof(DAGNode *));
+    if (!frozen || !sorted) {
+        free(frozen);
+        free(sorted);
+        return NULL;
+    }
+
+    // Ids in the maintained topological order make the CSR sorted, so
+    // resolving it is a single forward sweep
+    if (dag->node_count > 0) {
+        memcpy(sorted, dag->nodes, dag->node_count * sizeof(DAGNode *));
+        qsort(sorted, dag->node_count, sizeof(DAGNode *), node_ord_compare);
+    }
+    frozen->csr = dag_freeze(sorted, dag->node_count);
+    if (!frozen->csr) {
+        free(sorted);
+        free(frozen);
+        return NULL;
+    }
+
+    AxlSymbols *symbols = dag->symbols;
+    for (size_t i = 0; i < symbols->capacity; i++) {
+        AxlSymbol *entry = &symbols->slots[i];
+        if (!entry->length) continue;
+        entry->id = frozen_id(sorted, dag->node_count, entry->node);
+        entry->node = NULL;
+    }
+    free(sorted);
+
+    frozen->symbols = symbols;
+    dag->symbols = NULL;
+    if (!frozen_reorder(frozen, semantic_freeze_order)) {
+        axl_frozen_destroy(frozen);
+        return NULL;
+    }
+
+    frozen->hash_cons = dag->hash_cons;
+    frozen->order = semantic_freeze_order;
+    frozen->bytes = frozen->csr->bytes + sizeof(AxlSymbols)
+                  + symbols->capacity * sizeof(AxlSymbol) + symbols->names_capacity;
+    return frozen;
+}
+
+bool axl_frozen_lookup(const AxlFrozenDag *frozen, const char *name, uint32_t *node) {
+    if (!frozen || !name || !node) return false;
+
+    const AxlSymbol *entry = symbols_slot(frozen->symbols, name, strlen(name));
+    if (!entry->length) return false;
+    *node = entry->id;
+    return true;
+}
+
+void axl_frozen_destroy(void *ptr) {
+    AxlFrozenDag *frozen = (AxlFrozenDag *)ptr;
+    if (!frozen) return;
+
+    dag_csr_destroy(frozen->csr);
+    symbols_destroy(frozen->symbols);
+    free(frozen);
+}
@@ -1,9 +1,71 @@
 // src/core/integration/trie_dag.c
 #include <axl/core/integration/trie_dag.h>
+#include <axl/core/utils/corpus.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
-bool execute_axl_with_busting(const char* axl_path, const char* axml_path) {
-    printf("Executing AXL file: %s with configuration: %s\n", axl_path, axml_path);
-    // Placeholder implementation until full functionality is developed
+typedef struct {
+    AxlCorpusLoader         *loader;
+    const AxmlCompactConfig *config;
+    bool                    *results;
+} BatchJob;
+
+static void* batch_worker(void *arg) {
+    BatchJob *job = (BatchJob *)arg;
+    AxlLoadedFile file;
+
+    while (axl_corpus_next(job->loader, &file)) {
+        if (file.error) {
+            fprintf(stderr, "Error: Could not read %s: %s\n", file.path, strerror(file.error));
+            job->results[file.index] = false;
+        } else {
+            job->results[file.index] = execute_axl_source(file.path, file.data, file.size,
+                                                          job->config);
+        }
+        axl_corpus_release(job->loader, &file);
+    }
+    return NULL;
+}
+
+bool execute_axl_batch(const char** axl_paths, size_t count,
+                       const char* axml_path, bool* results) {
+    // Every file shares one parsed configuration
+    AxmlCompactConfig *config = axml_parse_compact(axml_path);
+    if (!config) {
+        fprintf(stderr, "Failed to parse AXML configuration: %s\n", axml_path);
+        return false;
+    }
+
+    AxlCorpusLoader *loader = axl_corpus_open(axl_paths, count, NULL);
+    if (!loader) {
+        fprintf(stderr, "Error: Could not start loading %zu AXL files\n", count);
+        axml_free_compact_config(config);
+        return false;
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = cpus > 1 ? (size_t)cpus : 1;
+    if (threads > count) threads = count;
+    pthread_t *workers = threads > 1 ? (pthread_t *)malloc((threads - 1) * sizeof(pthread_t)) : NULL;
+
+    // The calling thread works too; spawn failures just mean fewer helpers
+    BatchJob job = { .loader = loader, .config = config, .results = results };
+    size_t spawned = 0;
+    for (size_t t = 1; workers && t < threads; t++) {
+        if (pthread_create(&workers[spawned], NULL, batch_worker, &job) == 0) {
+            spawned++;
+        }
+    }
+    batch_worker(&job);
+
+    for (size_t t = 0; t < spawned; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    free(workers);
+    axl_corpus_close(loader);
+    axml_free_compact_config(config);
     return true;
 }
@@ -0,0 +1,162 @@
+// src/core/runtime/cache.c
+#include <axl/core/runtime/cache.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+typedef struct {
+    AxlCacheKind    kind;
+    AxlCacheStamp   stamp;         // Of the file the value was built from
+    uint64_t        last_used;
+    void           *value;
+    AxlCacheFreeFn  free_fn;
+} AxlCacheEntry;
+
+struct AxlCache {
+    AxlCacheEntry *entries;
+    size_t         count;
+    size_t         capacity;       // Allocated slots
+    size_t         limit;          // Entries kept after a trim
+    uint64_t       clock;
+    AxlCacheStats  stats;
+};
+
+AxlCache* axl_cache_create(size_t capacity) {
+    if (capacity == 0) return NULL;
+
+    AxlCache *cache = (AxlCache*)calloc(1, sizeof(AxlCache));
+    if (!cache) return NULL;
+
+    cache->limit = capacity;
+    return cache;
+}
+
+static void entry_free(AxlCacheEntry *entry) {
+    if (entry->free_fn) entry->free_fn(entry->value);
+}
+
+/// Remove slot `i`, keeping the array dense.
+static void cache_remove(AxlCache *cache, size_t i) {
+    entry_free(&cache->entries[i]);
+    cache->entries[i] = cache->entries[--cache->count];
+}
+
+static AxlCacheEntry* cache_find(AxlCache *cache, AxlCacheKind kind, const AxlCacheStamp *stamp) {
+    for (size_t i = 0; i < cache->count; i++) {
+        AxlCacheEntry *entry = &cache->entries[i];
+        if (entry->kind == kind && entry->stamp.dev == stamp->dev && entry->stamp.ino == stamp->ino) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool entry_fresh(const AxlCacheEntry *entry, const AxlCacheStamp *stamp) {
+    return entry->stamp.size == stamp->size &&
+           entry->stamp.mtime.tv_sec == stamp->mtime.tv_sec &&
+           entry->stamp.mtime.tv_nsec == stamp->mtime.tv_nsec;
+}
+
+static void cache_stamp(const char *path, AxlCacheStamp *stamp) {
+    struct stat st;
+    stamp->valid = stat(path, &st) == 0;
+    if (!stamp->valid) return;
+
+    stamp->dev = st.st_dev;
+    stamp->ino = st.st_ino;
+    stamp->mtime = st.st_mtim;
+    stamp->size = st.st_size;
+}
+
+void* axl_cache_get(AxlCache *cache, AxlCacheKind kind, const char *path,
+                    AxlCacheStamp *stamp) {
+    AxlCacheStamp local;
+    if (!stamp) stamp = &local;
+    stamp->valid = false;
+    if (!cache || !path) return NULL;
+
+    cache_stamp(path, stamp);
+    if (!stamp->valid) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    AxlCacheEntry *entry = cache_find(cache, kind, stamp);
+    if (!entry) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    if (!entry_fresh(entry, stamp)) {
+        cache_remove(cache, (size_t)(entry - cache->entries));
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    entry->last_used = ++cache->clock;
+    cache->stats.hits++;
+    return entry->value;
+}
+
+bool axl_cache_put(AxlCache *cache, AxlCacheKind kind, const AxlCacheStamp *stamp,
+                   void *value, AxlCacheFreeFn free_fn) {
+    if (!cache || !stamp || !stamp->valid || !value) return false;
+
+    AxlCacheEntry *entry = cache_find(cache, kind, stamp);
+    if (entry) {
+        if (entry->value != value) entry_free(entry);
+    } else {
+        if (cache->count == cache->capacity) {
+            size_t capacity = cache->capacity ? cache->capacity * 2 : 8;
+            AxlCacheEntry *entries = (AxlCacheEntry*)realloc(cache->entries,
+                                                             capacity * sizeof(AxlCacheEntry));
+            if (!entries) return false;
+            cache->entries = entries;
+            cache->capacity = capacity;
+        }
+        entry = &cache->entries[cache->count++];
+    }
+
+    entry->kind = kind;
+    entry->stamp = *stamp;
+    entry->last_used = ++cache->clock;
+    entry->value = value;
+    entry->free_fn = free_fn;
+    return true;
+}
+
+size_t axl_cache_trim(AxlCache *cache) {
+    if (!cache) return 0;
+
+    size_t evicted = 0;
+    while (cache->count > cache->limit) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < cache->count; i++) {
+            if (cache->entries[i].last_used < cache->entries[oldest].last_used) oldest = i;
+        }
+        cache_remove(cache, oldest);
+        evicted++;
+    }
+
+    cache->stats.evictions += evicted;
+    return evicted;
+}
+
+AxlCacheStats axl_cache_stats(const AxlCache *cache) {
+    AxlCacheStats stats = {0};
+    if (!cache) return stats;
+
+    stats = cache->stats;
+    stats.entries = cache->count;
+    return stats;
+}
+
+void axl_cache_destroy(AxlCache *cache) {
+    if (!cache) return;
+
+    for (size_t i = 0; i < cache->count; i++) {
+        entry_free(&cache->entries[i]);
+    }
+    free(cache->entries);
+    free(cache);
+}
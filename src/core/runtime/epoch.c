@@ -0,0 +1,195 @@
+// src/core/runtime/epoch.c
+#include <axl/core/runtime/epoch.h>
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define EPOCH_IDLE 0
+
+/// One reader slot per cache line so pinning never false-shares.
+typedef struct {
+    alignas(64) _Atomic uint64_t active;   // Pinned epoch, or EPOCH_IDLE
+    atomic_bool                  in_use;
+} EpochSlot;
+
+typedef struct {
+    void        *ptr;
+    EpochFreeFn  free_fn;
+    uint64_t     epoch;            // Global epoch when retired
+} EpochRetired;
+
+struct EpochDomain {
+    _Atomic uint64_t  global;      // Starts at 1; EPOCH_IDLE is never a live epoch
+    EpochSlot        *slots;
+    size_t            slot_count;
+
+    pthread_mutex_t   lock;        // Guards the retired list
+    EpochRetired     *retired;
+    size_t            retired_count;
+    size_t            retired_capacity;
+};
+
+EpochDomain* epoch_domain_create(size_t max_readers) {
+    if (max_readers == 0) return NULL;
+
+    EpochDomain *domain = (EpochDomain*)calloc(1, sizeof(EpochDomain));
+    if (!domain) return NULL;
+
+    domain->slots = (EpochSlot*)aligned_alloc(alignof(EpochSlot), max_readers * sizeof(EpochSlot));
+    if (!domain->slots) {
+        free(domain);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < max_readers; i++) {
+        atomic_init(&domain->slots[i].active, EPOCH_IDLE);
+        atomic_init(&domain->slots[i].in_use, false);
+    }
+    domain->slot_count = max_readers;
+    atomic_init(&domain->global, 1);
+    pthread_mutex_init(&domain->lock, NULL);
+
+    return domain;
+}
+
+int epoch_register(EpochDomain *domain) {
+    if (!domain) return -1;
+
+    for (size_t i = 0; i < domain->slot_count; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&domain->slots[i].in_use, &expected, true)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void epoch_unregister(EpochDomain *domain, int slot) {
+    if (!domain || slot < 0 || (size_t)slot >= domain->slot_count) return;
+
+    atomic_store(&domain->slots[slot].active, EPOCH_IDLE);
+    atomic_store(&domain->slots[slot].in_use, false);
+}
+
+void epoch_enter(EpochDomain *domain, int slot) {
+    // seq_cst store: must be visible before any load of shared pointers
+    uint64_t epoch = atomic_load(&domain->global);
+    atomic_store(&domain->slots[slot].active, epoch);
+}
+
+void epoch_exit(EpochDomain *domain, int slot) {
+    atomic_store_explicit(&domain->slots[slot].active, EPOCH_IDLE, memory_order_release);
+}
+
+bool epoch_retire(EpochDomain *domain, void *ptr, EpochFreeFn free_fn) {
+    if (!domain || !free_fn) return false;
+
+    pthread_mutex_lock(&domain->lock);
+
+    if (domain->retired_count == domain->retired_capacity) {
+        size_t capacity = domain->retired_capacity ? domain->retired_capacity * 2 : 16;
+        EpochRetired *grown = (EpochRetired*)realloc(domain->retired, capacity * sizeof(EpochRetired));
+        if (!grown) {
+            pthread_mutex_unlock(&domain->lock);
+            return false;
+        }
+        domain->retired = grown;
+        domain->retired_capacity = capacity;
+    }
+
+    EpochRetired *r = &domain->retired[domain->retired_count++];
+    r->ptr = ptr;
+    r->free_fn = free_fn;
+    r->epoch = atomic_load(&domain->global);
+
+    pthread_mutex_unlock(&domain->lock);
+    return true;
+}
+
+/// Oldest epoch still pinned by a reader, or UINT64_MAX if none.
+static uint64_t epoch_min_active(EpochDomain *domain) {
+    uint64_t min = UINT64_MAX;
+    for (size_t i = 0; i < domain->slot_count; i++) {
+        uint64_t e = atomic_load(&domain->slots[i].active);
+        if (e != EPOCH_IDLE && e < min) min = e;
+    }
+    return min;
+}
+
+size_t epoch_reclaim(EpochDomain *domain) {
+    if (!domain) return 0;
+
+    pthread_mutex_lock(&domain->lock);
+
+    // New readers now pin a later epoch than anything retired so far
+    atomic_fetch_add(&domain->global, 1);
+    uint64_t min_active = epoch_min_active(domain);
+
+    size_t safe_count = 0;
+    for (size_t i = 0; i < domain->retired_count; i++) {
+        if (domain->retired[i].epoch < min_active) safe_count++;
+    }
+
+    EpochRetired *safe = NULL;
+    if (safe_count > 0) {
+        safe = (EpochRetired*)malloc(safe_count * sizeof(EpochRetired));
+        if (!safe) {
+            pthread_mutex_unlock(&domain->lock);
+            return 0;
+        }
+
+        size_t kept = 0, taken = 0;
+        for (size_t i = 0; i < domain->retired_count; i++) {
+            if (domain->retired[i].epoch < min_active) {
+                safe[taken++] = domain->retired[i];
+            } else {
+                domain->retired[kept++] = domain->retired[i];
+            }
+        }
+        domain->retired_count = kept;
+    }
+
+    pthread_mutex_unlock(&domain->lock);
+
+    // Free outside the lock so destructors may retire further objects
+    for (size_t i = 0; i < safe_count; i++) {
+        safe[i].free_fn(safe[i].ptr);
+    }
+    free(safe);
+
+    return safe_count;
+}
+
+size_t epoch_pending(EpochDomain *domain) {
+    if (!domain) return 0;
+
+    pthread_mutex_lock(&domain->lock);
+    size_t count = domain->retired_count;
+    pthread_mutex_unlock(&domain->lock);
+    return count;
+}
+
+void epoch_domain_destroy(EpochDomain *domain) {
+    if (!domain) return;
+
+    // Destructors may retire more objects; drain until empty
+    while (domain->retired_count > 0) {
+        EpochRetired *retired = domain->retired;
+        size_t count = domain->retired_count;
+        domain->retired = NULL;
+        domain->retired_count = 0;
+        domain->retired_capacity = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            retired[i].free_fn(retired[i].ptr);
+        }
+        free(retired);
+    }
+    free(domain->retired);
+
+    pthread_mutex_destroy(&domain->lock);
+    free(domain->slots);
+    free(domain);
+}
@@ -0,0 +1,293 @@
+// src/core/runtime/event_bus.c
+#include <axl/core/runtime/event_bus.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    EventSubscription subscription;
+    int               id;          // 0 = free slot
+} EventSlot;
+
+static pthread_mutex_t bus_lock = PTHREAD_MUTEX_INITIALIZER;
+static EventSlot *bus_slots;
+static size_t bus_slot_count;
+static int bus_next_id = 1;
+
+/// Sampling state per event type. Publishers only touch atomics, so
+/// dropped and coalesced events never take the bus lock.
+typedef struct {
+    _Atomic int      mode;         // EventSampleMode; written last when set
+    _Atomic uint64_t every;
+    _Atomic uint64_t limit;
+    _Atomic uint64_t interval_ns;
+    _Atomic uint64_t seen;         // EVERY_NTH: events since the policy was set
+    _Atomic uint64_t window;       // RATE_LIMIT: index of the current window
+    _Atomic uint64_t window_count; // RATE_LIMIT: events in the current window
+    _Atomic uint64_t pending;      // COALESCE: events not yet aggregated
+    _Atomic uint64_t pending_bytes;
+    _Atomic uint64_t next_flush;   // COALESCE: monotonic ns of the next aggregate
+    _Atomic uint64_t suppressed;
+} EventTypeState;
+
+static EventTypeState bus_types[EVENT_TYPE_COUNT];
+static pthread_mutex_t policy_lock = PTHREAD_MUTEX_INITIALIZER;
+
+bool event_bus_init(void) {
+    // State is statically initialized; kept for API symmetry
+    return true;
+}
+
+int event_bus_subscribe(EventHandler handler, void* user_data,
+                        EventType* event_types, size_t event_type_count) {
+    if (!handler) return -1;
+
+    EventType* types = NULL;
+    if (event_type_count > 0) {
+        if (!event_types) return -1;
+        types = (EventType*)malloc(event_type_count * sizeof(EventType));
+        if (!types) return -1;
+        memcpy(types, event_types, event_type_count * sizeof(EventType));
+    }
+
+    pthread_mutex_lock(&bus_lock);
+
+    EventSlot* slot = NULL;
+    for (size_t i = 0; i < bus_slot_count; i++) {
+        if (bus_slots[i].id == 0) {
+            slot = &bus_slots[i];
+            break;
+        }
+    }
+    if (!slot) {
+        EventSlot* grown = (EventSlot*)realloc(bus_slots, (bus_slot_count + 1) * sizeof(EventSlot));
+        if (!grown) {
+            pthread_mutex_unlock(&bus_lock);
+            free(types);
+            return -1;
+        }
+        bus_slots = grown;
+        slot = &bus_slots[bus_slot_count++];
+    }
+
+    // An empty type list subscribes to every event
+    slot->subscription.handler = handler;
+    slot->subscription.user_data = user_data;
+    slot->subscription.event_types = types;
+    slot->subscription.event_type_count = event_type_count;
+    slot->id = bus_next_id++;
+    int id = slot->id;
+
+    pthread_mutex_unlock(&bus_lock);
+    return id;
+}
+
+void event_bus_unsubscribe(int subscription_id) {
+    if (subscription_id <= 0) return;
+
+    pthread_mutex_lock(&bus_lock);
+    for (size_t i = 0; i < bus_slot_count; i++) {
+        if (bus_slots[i].id == subscription_id) {
+            free(bus_slots[i].subscription.event_types);
+            memset(&bus_slots[i], 0, sizeof(EventSlot));
+            break;
+        }
+    }
+    pthread_mutex_unlock(&bus_lock);
+}
+
+static bool subscription_wants(const EventSubscription* subscription, EventType type) {
+    if (subscription->event_type_count == 0) return true;
+
+    for (size_t i = 0; i < subscription->event_type_count; i++) {
+        if (subscription->event_types[i] == type) return true;
+    }
+    return false;
+}
+
+static void bus_deliver(const Event* event) {
+    // Handlers run outside the lock so they may publish or (un)subscribe
+    EventSubscription matched[16];
+    EventSubscription* targets = matched;
+    size_t count = 0;
+
+    pthread_mutex_lock(&bus_lock);
+    if (bus_slot_count > sizeof(matched) / sizeof(matched[0])) {
+        targets = (EventSubscription*)malloc(bus_slot_count * sizeof(EventSubscription));
+        if (!targets) {
+            pthread_mutex_unlock(&bus_lock);
+            return;
+        }
+    }
+    for (size_t i = 0; i < bus_slot_count; i++) {
+        if (bus_slots[i].id != 0 && subscription_wants(&bus_slots[i].subscription, event->type)) {
+            targets[count++] = bus_slots[i].subscription;
+        }
+    }
+    pthread_mutex_unlock(&bus_lock);
+
+    for (size_t i = 0; i < count; i++) {
+        targets[i].handler(event, targets[i].user_data);
+    }
+
+    if (targets != matched) free(targets);
+}
+
+/* ---------------------------------------------------------------------------
+ * Sampling
+ * ------------------------------------------------------------------------- */
+
+static uint64_t bus_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/// Publish whatever `state` has coalesced so far as one aggregate.
+static void bus_publish_aggregate(EventType type, EventTypeState* state) {
+    // A concurrent publisher may land between the two exchanges; its
+    // event is then reported in this aggregate or the next, never lost
+    EventAggregate aggregate = {
+        .type = type,
+        .count = atomic_exchange(&state->pending, 0),
+        .data_size = atomic_exchange(&state->pending_bytes, 0)
+    };
+    if (aggregate.count == 0) return;
+
+    Event event = {
+        .type = EVENT_AGGREGATE,
+        .data = &aggregate,
+        .data_size = sizeof(aggregate)
+    };
+    bus_deliver(&event);
+}
+
+/// Apply the type's policy; true if the event should be delivered as is.
+static bool bus_sample(const Event* event) {
+    if ((unsigned)event->type >= EVENT_AGGREGATE) return true;
+
+    EventTypeState* state = &bus_types[event->type];
+    int mode = atomic_load_explicit(&state->mode, memory_order_acquire);
+
+    switch (mode) {
+        case EVENT_SAMPLE_EVERY_NTH: {
+            // Zero only while a concurrent set_policy is switching modes
+            uint64_t every = atomic_load_explicit(&state->every, memory_order_relaxed);
+            if (every == 0) return true;
+            if (atomic_fetch_add_explicit(&state->seen, 1, memory_order_relaxed) % every == 0) {
+                return true;
+            }
+            break;
+        }
+        case EVENT_SAMPLE_RATE_LIMIT: {
+            uint64_t interval = atomic_load_explicit(&state->interval_ns, memory_order_relaxed);
+            if (interval == 0) return true;
+            uint64_t window = bus_now_ns() / interval;
+            uint64_t current = atomic_load_explicit(&state->window, memory_order_relaxed);
+
+            // The thread that opens a new window resets its count
+            if (window != current &&
+                atomic_compare_exchange_strong(&state->window, &current, window)) {
+                atomic_store_explicit(&state->window_count, 0, memory_order_relaxed);
+            }
+            uint64_t limit = atomic_load_explicit(&state->limit, memory_order_relaxed);
+            if (atomic_fetch_add_explicit(&state->window_count, 1, memory_order_relaxed) < limit) {
+                return true;
+            }
+            break;
+        }
+        case EVENT_SAMPLE_COALESCE: {
+            atomic_fetch_add_explicit(&state->pending_bytes, event->data_size, memory_order_relaxed);
+            atomic_fetch_add_explicit(&state->pending, 1, memory_order_relaxed);
+
+            uint64_t now = bus_now_ns();
+            uint64_t due = atomic_load_explicit(&state->next_flush, memory_order_relaxed);
+            if (now >= due) {
+                uint64_t next = now + atomic_load_explicit(&state->interval_ns, memory_order_relaxed);
+                if (atomic_compare_exchange_strong(&state->next_flush, &due, next)) {
+                    bus_publish_aggregate(event->type, state);
+                }
+            }
+            return false;
+        }
+        default:
+            return true;
+    }
+
+    atomic_fetch_add_explicit(&state->suppressed, 1, memory_order_relaxed);
+    return false;
+}
+
+void event_bus_publish(const Event* event) {
+    if (!event || !bus_sample(event)) return;
+    bus_deliver(event);
+}
+
+bool event_bus_set_policy(EventType type, const EventPolicy* policy) {
+    if ((unsigned)type >= EVENT_AGGREGATE) return false;
+
+    EventPolicy all = { .mode = EVENT_SAMPLE_ALL };
+    if (!policy) policy = &all;
+
+    switch (policy->mode) {
+        case EVENT_SAMPLE_ALL:
+            break;
+        case EVENT_SAMPLE_EVERY_NTH:
+            if (policy->every == 0) return false;
+            break;
+        case EVENT_SAMPLE_RATE_LIMIT:
+        case EVENT_SAMPLE_COALESCE:
+            if (policy->interval_ms == 0) return false;
+            break;
+        default:
+            return false;
+    }
+
+    pthread_mutex_lock(&policy_lock);
+    EventTypeState* state = &bus_types[type];
+
+    // Switch to ALL first so publishers stop using the old parameters
+    int previous = atomic_exchange(&state->mode, EVENT_SAMPLE_ALL);
+    if (previous == EVENT_SAMPLE_COALESCE) {
+        bus_publish_aggregate(type, state);
+    }
+
+    atomic_store(&state->every, policy->every);
+    atomic_store(&state->limit, policy->limit);
+    atomic_store(&state->interval_ns, policy->interval_ms * 1000000ull);
+    atomic_store(&state->seen, 0);
+    atomic_store(&state->window, 0);
+    atomic_store(&state->window_count, 0);
+    atomic_store(&state->next_flush, bus_now_ns() + policy->interval_ms * 1000000ull);
+    atomic_store_explicit(&state->mode, (int)policy->mode, memory_order_release);
+
+    pthread_mutex_unlock(&policy_lock);
+    return true;
+}
+
+void event_bus_flush(void) {
+    for (int type = 0; type < EVENT_AGGREGATE; type++) {
+        bus_publish_aggregate((EventType)type, &bus_types[type]);
+    }
+}
+
+uint64_t event_bus_suppressed(EventType type) {
+    if ((unsigned)type >= EVENT_AGGREGATE) return 0;
+    return atomic_load_explicit(&bus_types[type].suppressed, memory_order_relaxed);
+}
+
+void event_bus_cleanup(void) {
+    // Subscribers still get what was coalesced before they go away
+    event_bus_flush();
+
+    pthread_mutex_lock(&bus_lock);
+    for (size_t i = 0; i < bus_slot_count; i++) {
+        free(bus_slots[i].subscription.event_types);
+    }
+    free(bus_slots);
+    bus_slots = NULL;
+    bus_slot_count = 0;
+    pthread_mutex_unlock(&bus_lock);
+}
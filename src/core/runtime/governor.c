@@ -0,0 +1,223 @@
+// src/core/runtime/governor.c
+#include <axl/core/runtime/governor.h>
+#include <axl/core/runtime/event_bus.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef struct {
+    void*           object;
+    size_t          bytes;
+    GovernorEvictFn evict;
+    uint64_t        last_used;
+} GovernedObject;
+
+struct MemoryGovernor {
+    pthread_mutex_t lock;
+    GovernedObject* objects;
+    size_t          count;
+    size_t          capacity;
+    size_t          usage;         // Sum of tracked bytes
+    size_t          budget;        // 0 = unlimited
+    bool            use_rss;
+    uint64_t        clock;
+};
+
+MemoryGovernor* governor_create(size_t budget_bytes, bool use_rss) {
+    MemoryGovernor* governor = (MemoryGovernor*)calloc(1, sizeof(MemoryGovernor));
+    if (!governor) return NULL;
+
+    pthread_mutex_init(&governor->lock, NULL);
+    governor->budget = budget_bytes;
+    governor->use_rss = use_rss;
+    return governor;
+}
+
+static MemoryGovernor* shared_governor;
+static pthread_once_t shared_once = PTHREAD_ONCE_INIT;
+
+static void shared_init(void) {
+    shared_governor = governor_create(0, false);
+}
+
+MemoryGovernor* governor_shared(void) {
+    pthread_once(&shared_once, shared_init);
+    return shared_governor;
+}
+
+size_t governor_rss_bytes(void) {
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+
+    unsigned long size_pages = 0, resident_pages = 0;
+    int fields = fscanf(file, "%lu %lu", &size_pages, &resident_pages);
+    fclose(file);
+    if (fields != 2) return 0;
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    return (size_t)resident_pages * (size_t)(page_size > 0 ? page_size : 4096);
+}
+
+static GovernedObject* governor_find(MemoryGovernor* governor, const void* object) {
+    for (size_t i = 0; i < governor->count; i++) {
+        if (governor->objects[i].object == object) return &governor->objects[i];
+    }
+    return NULL;
+}
+
+/// Bytes that must go to get back under budget (lock held).
+static size_t governor_excess(MemoryGovernor* governor) {
+    if (governor->budget == 0) return 0;
+
+    size_t used = governor->usage;
+    if (governor->use_rss) {
+        size_t rss = governor_rss_bytes();
+        if (rss > used) used = rss;
+    }
+    return used > governor->budget ? used - governor->budget : 0;
+}
+
+/// Unlink victims under the lock; free and announce them after.
+static size_t governor_evict(MemoryGovernor* governor, const void* keep) {
+    pthread_mutex_lock(&governor->lock);
+
+    size_t excess = governor_excess(governor);
+    GovernedObject* victims = NULL;
+    size_t victim_count = 0;
+
+    if (excess > 0 && governor->count > 0) {
+        victims = (GovernedObject*)malloc(governor->count * sizeof(GovernedObject));
+    }
+
+    // RSS does not shrink as soon as memory is freed, so evict by the
+    // tracked estimate of what each victim gives back
+    size_t reclaimed = 0;
+    while (victims && reclaimed < excess) {
+        size_t oldest = governor->count;
+        for (size_t i = 0; i < governor->count; i++) {
+            if (governor->objects[i].object == keep) continue;
+            if (oldest == governor->count ||
+                governor->objects[i].last_used < governor->objects[oldest].last_used) {
+                oldest = i;
+            }
+        }
+        if (oldest == governor->count) break;
+
+        victims[victim_count++] = governor->objects[oldest];
+        reclaimed += governor->objects[oldest].bytes;
+        governor->usage -= governor->objects[oldest].bytes;
+        governor->objects[oldest] = governor->objects[--governor->count];
+    }
+
+    pthread_mutex_unlock(&governor->lock);
+
+    for (size_t i = 0; i < victim_count; i++) {
+        Event event = {
+            .type = EVENT_DAG_NODE_BUSTED,
+            .source = governor,
+            .data = victims[i].object,
+            .data_size = victims[i].bytes
+        };
+        event_bus_publish(&event);
+        victims[i].evict(victims[i].object);
+    }
+
+    free(victims);
+    return victim_count;
+}
+
+void governor_set_budget(MemoryGovernor* governor, size_t budget_bytes, bool use_rss) {
+    if (!governor) return;
+
+    pthread_mutex_lock(&governor->lock);
+    governor->budget = budget_bytes;
+    governor->use_rss = use_rss;
+    pthread_mutex_unlock(&governor->lock);
+
+    governor_evict(governor, NULL);
+}
+
+bool governor_track(MemoryGovernor* governor, void* object, size_t bytes,
+                    GovernorEvictFn evict) {
+    if (!governor || !object || !evict) return false;
+
+    pthread_mutex_lock(&governor->lock);
+
+    GovernedObject* entry = governor_find(governor, object);
+    if (!entry) {
+        if (governor->count == governor->capacity) {
+            size_t capacity = governor->capacity ? governor->capacity * 2 : 16;
+            GovernedObject* grown = (GovernedObject*)realloc(governor->objects,
+                                                             capacity * sizeof(GovernedObject));
+            if (!grown) {
+                pthread_mutex_unlock(&governor->lock);
+                return false;
+            }
+            governor->objects = grown;
+            governor->capacity = capacity;
+        }
+        entry = &governor->objects[governor->count++];
+    } else {
+        governor->usage -= entry->bytes;
+    }
+
+    entry->object = object;
+    entry->bytes = bytes;
+    entry->evict = evict;
+    entry->last_used = ++governor->clock;
+    governor->usage += bytes;
+
+    pthread_mutex_unlock(&governor->lock);
+
+    governor_evict(governor, object);
+    return true;
+}
+
+bool governor_touch(MemoryGovernor* governor, const void* object) {
+    if (!governor) return false;
+
+    pthread_mutex_lock(&governor->lock);
+    GovernedObject* entry = governor_find(governor, object);
+    if (entry) entry->last_used = ++governor->clock;
+    pthread_mutex_unlock(&governor->lock);
+    return entry != NULL;
+}
+
+bool governor_release(MemoryGovernor* governor, const void* object) {
+    if (!governor) return false;
+
+    pthread_mutex_lock(&governor->lock);
+    GovernedObject* entry = governor_find(governor, object);
+    if (entry) {
+        governor->usage -= entry->bytes;
+        *entry = governor->objects[--governor->count];
+    }
+    pthread_mutex_unlock(&governor->lock);
+    return entry != NULL;
+}
+
+size_t governor_enforce(MemoryGovernor* governor) {
+    return governor ? governor_evict(governor, NULL) : 0;
+}
+
+size_t governor_usage(MemoryGovernor* governor) {
+    if (!governor) return 0;
+
+    pthread_mutex_lock(&governor->lock);
+    size_t usage = governor->usage;
+    pthread_mutex_unlock(&governor->lock);
+    return usage;
+}
+
+void governor_destroy(MemoryGovernor* governor) {
+    if (!governor) return;
+
+    for (size_t i = 0; i < governor->count; i++) {
+        governor->objects[i].evict(governor->objects[i].object);
+    }
+    free(governor->objects);
+    pthread_mutex_destroy(&governor->lock);
+    free(governor);
+}
@@ -0,0 +1,156 @@
+// src/core/runtime/reclaimer.c
+#include <axl/core/runtime/reclaimer.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Slots for the process-wide reclaimer's readers
+#define RECLAIMER_SHARED_READERS 64
+
+// How long to wait before retrying when readers still pin old objects
+#define RECLAIMER_RETRY_NS 1000000L
+
+struct Reclaimer {
+    EpochDomain    *domain;
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;          // New work or shutdown
+    pthread_cond_t  drained;       // Pending count reached zero
+    size_t          deferred;      // Objects handed over so far
+    size_t          freed;         // Objects freed so far
+    bool            stopping;
+};
+
+static void* reclaimer_main(void* arg) {
+    Reclaimer* reclaimer = (Reclaimer*)arg;
+
+    pthread_mutex_lock(&reclaimer->lock);
+    for (;;) {
+        while (!reclaimer->stopping && reclaimer->freed == reclaimer->deferred) {
+            pthread_cond_wait(&reclaimer->wake, &reclaimer->lock);
+        }
+        if (reclaimer->stopping) break;
+
+        // Frees run without the lock so producers never wait on them
+        pthread_mutex_unlock(&reclaimer->lock);
+        size_t freed = epoch_reclaim(reclaimer->domain);
+        pthread_mutex_lock(&reclaimer->lock);
+
+        reclaimer->freed += freed;
+        if (reclaimer->freed == reclaimer->deferred) {
+            pthread_cond_broadcast(&reclaimer->drained);
+        } else if (freed == 0) {
+            // A reader still pins an old epoch; back off briefly
+            struct timespec until;
+            clock_gettime(CLOCK_REALTIME, &until);
+            until.tv_nsec += RECLAIMER_RETRY_NS;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&reclaimer->wake, &reclaimer->lock, &until);
+        }
+    }
+    pthread_mutex_unlock(&reclaimer->lock);
+    return NULL;
+}
+
+Reclaimer* reclaimer_create(size_t max_readers) {
+    Reclaimer* reclaimer = (Reclaimer*)calloc(1, sizeof(Reclaimer));
+    if (!reclaimer) return NULL;
+
+    reclaimer->domain = epoch_domain_create(max_readers);
+    if (!reclaimer->domain) {
+        free(reclaimer);
+        return NULL;
+    }
+
+    pthread_mutex_init(&reclaimer->lock, NULL);
+    pthread_cond_init(&reclaimer->wake, NULL);
+    pthread_cond_init(&reclaimer->drained, NULL);
+
+    if (pthread_create(&reclaimer->thread, NULL, reclaimer_main, reclaimer) != 0) {
+        pthread_cond_destroy(&reclaimer->drained);
+        pthread_cond_destroy(&reclaimer->wake);
+        pthread_mutex_destroy(&reclaimer->lock);
+        epoch_domain_destroy(reclaimer->domain);
+        free(reclaimer);
+        return NULL;
+    }
+
+    return reclaimer;
+}
+
+static Reclaimer* shared_reclaimer;
+static pthread_once_t shared_once = PTHREAD_ONCE_INIT;
+
+static void shared_init(void) {
+    shared_reclaimer = reclaimer_create(RECLAIMER_SHARED_READERS);
+}
+
+Reclaimer* reclaimer_shared(void) {
+    pthread_once(&shared_once, shared_init);
+    return shared_reclaimer;
+}
+
+EpochDomain* reclaimer_domain(Reclaimer* reclaimer) {
+    return reclaimer ? reclaimer->domain : NULL;
+}
+
+bool reclaimer_defer(Reclaimer* reclaimer, void* ptr, EpochFreeFn free_fn) {
+    if (!reclaimer || !free_fn) return false;
+
+    // Count first so `freed` can never overtake `deferred`
+    pthread_mutex_lock(&reclaimer->lock);
+    reclaimer->deferred++;
+    pthread_mutex_unlock(&reclaimer->lock);
+
+    bool queued = epoch_retire(reclaimer->domain, ptr, free_fn);
+
+    pthread_mutex_lock(&reclaimer->lock);
+    if (!queued) {
+        reclaimer->deferred--;
+        if (reclaimer->freed == reclaimer->deferred) {
+            pthread_cond_broadcast(&reclaimer->drained);
+        }
+    }
+    pthread_cond_signal(&reclaimer->wake);
+    pthread_mutex_unlock(&reclaimer->lock);
+    return queued;
+}
+
+void reclaimer_flush(Reclaimer* reclaimer) {
+    if (!reclaimer) return;
+
+    pthread_mutex_lock(&reclaimer->lock);
+    while (reclaimer->freed != reclaimer->deferred) {
+        pthread_cond_wait(&reclaimer->drained, &reclaimer->lock);
+    }
+    pthread_mutex_unlock(&reclaimer->lock);
+}
+
+size_t reclaimer_pending(Reclaimer* reclaimer) {
+    if (!reclaimer) return 0;
+
+    pthread_mutex_lock(&reclaimer->lock);
+    size_t pending = reclaimer->deferred - reclaimer->freed;
+    pthread_mutex_unlock(&reclaimer->lock);
+    return pending;
+}
+
+void reclaimer_destroy(Reclaimer* reclaimer) {
+    if (!reclaimer) return;
+
+    pthread_mutex_lock(&reclaimer->lock);
+    reclaimer->stopping = true;
+    pthread_cond_signal(&reclaimer->wake);
+    pthread_mutex_unlock(&reclaimer->lock);
+    pthread_join(reclaimer->thread, NULL);
+
+    // Anything left is freed here; no reader may still be active
+    epoch_domain_destroy(reclaimer->domain);
+    pthread_cond_destroy(&reclaimer->drained);
+    pthread_cond_destroy(&reclaimer->wake);
+    pthread_mutex_destroy(&reclaimer->lock);
+    free(reclaimer);
+}
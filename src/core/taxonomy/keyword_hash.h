@@ -0,0 +1,25 @@
+// src/core/taxonomy/keyword_hash.h
+#ifndef AXL_TAXONOMY_KEYWORD_HASH_H
+#define AXL_TAXONOMY_KEYWORD_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Seeded FNV-1a with a final avalanche step.
+/// Shared by the build-time generator (tools/kwgen.c) and the runtime
+/// lookup in taxonomy.c; both sides must agree bit for bit.
+static inline uint32_t taxonomy_keyword_hash(uint32_t seed,
+                                             const char *text,
+                                             size_t len) {
+    uint32_t h = 2166136261u ^ seed;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    return h;
+}
+
+#endif // AXL_TAXONOMY_KEYWORD_HASH_H
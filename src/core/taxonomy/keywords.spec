@@ -0,0 +1,17 @@
+# AXL keyword and taxonomy classification table.
+#
+# Consumed at build time by tools/kwgen.c, which emits a collision-free
+# perfect hash over the keywords below.
+#
+# keyword   token             category         weight
+let         TOKEN_LET         VERB_IDENTITY    1.0
+const       TOKEN_CONST       VERB_IDENTITY    1.0
+var         TOKEN_VAR         VERB_IDENTITY    1.0
+is          TOKEN_IDENT       VERB_STATE       0.75
+has         TOKEN_IDENT       VERB_STATE       0.75
+=           TOKEN_ASSIGN      VERB_ACTION      0.9
++           TOKEN_PLUS        VERB_ACTION      0.5
+-           TOKEN_MINUS       VERB_ACTION      0.5
+;           TOKEN_SEMICOLON   TAXONOMY_NONE    0.0
+(           TOKEN_LPAREN      TAXONOMY_NONE    0.0
+)           TOKEN_RPAREN      TAXONOMY_NONE    0.0
@@ -0,0 +1,32 @@
+// src/core/taxonomy/taxonomy.c
+#include <axl/core/taxonomy.h>
+#include <string.h>
+#include "keyword_hash.h"
+
+typedef struct {
+    const char   *text;
+    size_t        len;
+    TaxonomyEntry entry;
+} TaxonomyKeyword;
+
+// Perfect hash table generated by tools/kwgen.c from keywords.spec
+#include "taxonomy_keywords.h"
+
+bool taxonomy_classify(const char *text, size_t len, TaxonomyEntry *out) {
+    if (!text || len == 0 || len > TAXONOMY_KEYWORD_MAX_LEN) {
+        return false;
+    }
+
+    uint32_t slot = taxonomy_keyword_hash(TAXONOMY_KEYWORD_SEED, text, len)
+                    & TAXONOMY_KEYWORD_MASK;
+    const TaxonomyKeyword *kw = &taxonomy_keywords[slot];
+
+    if (kw->len != len || memcmp(kw->text, text, len) != 0) {
+        return false;
+    }
+
+    if (out) {
+        *out = kw->entry;
+    }
+    return true;
+}
@@ -1,43 +1,137 @@
 #include <axl/core/trie.h>
+#include <axl/core/runtime/epoch.h>
 #include <axl/core/taxonomy.h>
+#include <axl/core/utils/memory.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+static atomic_size_t trie_patterns_total;
+static atomic_size_t trie_patterns_compiled;
+static atomic_size_t trie_patterns_used;
+static atomic_size_t trie_compile_failures;
+
+// Grace periods for nodes replaced under concurrent readers
+static EpochDomain   *trie_epoch;
+static pthread_once_t trie_epoch_once = PTHREAD_ONCE_INIT;
+
+static void trie_epoch_create(void) {
+    trie_epoch = epoch_domain_create(AXL_TRIE_MAX_READERS);
+}
+
+static EpochDomain* trie_epoch_domain(void) {
+    pthread_once(&trie_epoch_once, trie_epoch_create);
+    return trie_epoch;
+}
+
 /**
  * Initialize the trie subsystem
  * Returns 0 on success, non-zero on failure
  */
 int trie_init(void) {
-    // Placeholder implementation
-    return 0;
+    return trie_epoch_domain() ? 0 : -1;
+}
+
+TrieNode* trie_child(const TrieNode *node, unsigned char c) {
+    return atomic_load_explicit(&((TrieNode *)node)->children[c], memory_order_acquire);
+}
+
+int trie_reader_register(void) {
+    EpochDomain *domain = trie_epoch_domain();
+    return domain ? epoch_register(domain) : -1;
+}
+
+void trie_reader_unregister(int reader) {
+    if (reader >= 0) epoch_unregister(trie_epoch_domain(), reader);
+}
+
+void trie_reader_enter(int reader) {
+    if (reader >= 0) epoch_enter(trie_epoch_domain(), reader);
+}
+
+void trie_reader_exit(int reader) {
+    if (reader >= 0) epoch_exit(trie_epoch_domain(), reader);
+}
+
+size_t trie_reclaim(void) {
+    return epoch_reclaim(trie_epoch_domain());
 }
 
 TrieNode* trie_node_create(const char *pattern_str,
                            TaxonomyCategory cat,
                            float weight) {
-    TrieNode *node = (TrieNode*)calloc(1, sizeof(TrieNode));
+    if (!pattern_str) return NULL;
+
+    TrieNode *node = (TrieNode*)axl_calloc(1, sizeof(TrieNode), AXL_MEM_TRIE);
     if (!node) return NULL;
     
-    node->pattern_str = strdup(pattern_str);
+    node->pattern_str = axl_strdup(pattern_str, AXL_MEM_TRIE);
+    if (!node->pattern_str) {
+        axl_free(node);
+        return NULL;
+    }
     node->category = cat;
     node->weight = weight;
     node->terminal = false;
     
-    // Compile the regex pattern
-    if (regcomp(&node->pattern, pattern_str, REG_EXTENDED) != 0) {
-        free(node->pattern_str);
-        free(node);
-        return NULL;
-    }
+    // Compilation is deferred to the first match
+    atomic_init(&node->regex_state, TRIE_REGEX_PENDING);
+    atomic_init(&node->match_count, 0);
+    atomic_fetch_add_explicit(&trie_patterns_total, 1, memory_order_relaxed);
     
     return node;
 }
 
-bool trie_match_node(TrieNode *node, const char *text, size_t len) {
-    if (!node || !text || len == 0) {
-        return false;
+bool trie_node_compile(TrieNode *node) {
+    if (!node) return false;
+
+    int state = atomic_load_explicit(&node->regex_state, memory_order_acquire);
+    if (state == TRIE_REGEX_READY) return true;
+
+    // First thread to claim the node compiles it; the others wait
+    if (state == TRIE_REGEX_PENDING &&
+        atomic_compare_exchange_strong(&node->regex_state, &state, TRIE_REGEX_COMPILING)) {
+        // regcomp allocates internally; charge the heap growth it causes
+        // (approximate while other threads allocate concurrently)
+        size_t heap_before = axl_mem_heap_in_use();
+        int rc = regcomp(&node->pattern, node->pattern_str, REG_EXTENDED);
+        if (rc != 0) {
+            char message[128];
+            regerror(rc, &node->pattern, message, sizeof(message));
+            fprintf(stderr, "Invalid trie pattern '%s': %s\n", node->pattern_str, message);
+            atomic_fetch_add_explicit(&trie_compile_failures, 1, memory_order_relaxed);
+            atomic_store_explicit(&node->regex_state, TRIE_REGEX_FAILED, memory_order_release);
+            return false;
+        }
+
+        size_t heap_after = axl_mem_heap_in_use();
+        node->regex_bytes = heap_after > heap_before ? heap_after - heap_before : 0;
+        axl_mem_account(AXL_MEM_REGEX, (ptrdiff_t)node->regex_bytes);
+
+        atomic_fetch_add_explicit(&trie_patterns_compiled, 1, memory_order_relaxed);
+        atomic_store_explicit(&node->regex_state, TRIE_REGEX_READY, memory_order_release);
+        return true;
     }
-    
+
+    while ((state = atomic_load_explicit(&node->regex_state, memory_order_acquire)) ==
+           TRIE_REGEX_COMPILING) {
+        sched_yield();
+    }
+    return state == TRIE_REGEX_READY;
+}
+
+/// Count a use of `node` and make sure its regex is compiled.
+static bool trie_node_prepare(TrieNode *node) {
+    if (atomic_fetch_add_explicit(&node->match_count, 1, memory_order_relaxed) == 0) {
+        atomic_fetch_add_explicit(&trie_patterns_used, 1, memory_order_relaxed);
+    }
+    return trie_node_compile(node);
+}
+
+/// Leftmost-longest match of node->pattern in text[0..len).
+static bool trie_node_exec(TrieNode *node, const char *text, size_t len, regmatch_t *match) {
     // Create a null-terminated copy of the text segment for regex matching
     char *text_copy = (char *)malloc(len + 1);
     if (!text_copy) {
@@ -48,16 +142,57 @@ bool trie_match_node(TrieNode *node, const char *text, size_t len) {
     text_copy[len] = '\0';
     
     // Execute the compiled regex against the text
+    int result = regexec(&node->pattern, text_copy, 1, match, 0);
+    
+    free(text_copy);
+    return result == 0;
+}
+
+bool trie_match_node(TrieNode *node, const char *text, size_t len) {
+    if (!node || !text || len == 0) {
+        return false;
+    }
+    
+    if (!trie_node_prepare(node)) {
+        return false;
+    }
+    
     regmatch_t match;
-    int result = regexec(&node->pattern, text_copy, 1, &match, 0);
+    bool found = trie_node_exec(node, text, len, &match);
     
     // Check if we have a match at the start of the string that consumes the entire input
     // Fix sign comparison with explicit cast
-    bool matches = (result == 0 && match.rm_so == 0 && 
-                   (size_t)match.rm_eo == len);
+    return found && match.rm_so == 0 && (size_t)match.rm_eo == len;
+}
+
+bool trie_match_prefix(TrieNode *node, const char *text, size_t len, size_t *match_len) {
+    if (!node || !text || len == 0 || !match_len) {
+        return false;
+    }
     
-    free(text_copy);
-    return matches;
+    if (!trie_node_prepare(node)) {
+        return false;
+    }
+    
+    // POSIX picks the leftmost match, so one anchored at 0 is found if it exists
+    regmatch_t match;
+    if (!trie_node_exec(node, text, len, &match) || match.rm_so != 0 || match.rm_eo == 0) {
+        return false;
+    }
+    
+    *match_len = (size_t)match.rm_eo;
+    return true;
+}
+
+/// Free one node without its children (they moved to the replacement).
+static void trie_node_release(void *ptr) {
+    TrieNode *node = (TrieNode *)ptr;
+    if (atomic_load(&node->regex_state) == TRIE_REGEX_READY) {
+        regfree(&node->pattern);
+        axl_mem_account(AXL_MEM_REGEX, -(ptrdiff_t)node->regex_bytes);
+    }
+    axl_free(node->pattern_str);
+    axl_free(node);
 }
 
 void trie_insert(TrieNode *root,
@@ -70,15 +205,252 @@ void trie_insert(TrieNode *root,
     
     // Calculate first character for indexing
     unsigned char first_char = (unsigned char)pattern_str[0];
+    TrieNode *old = atomic_load_explicit(&root->children[first_char], memory_order_relaxed);
+    if (old && old->category == cat && old->weight == weight &&
+        strcmp(old->pattern_str, pattern_str) == 0) {
+        return;
+    }
     
-    // If child doesn't exist, create it
-    if (!root->children[first_char]) {
-        root->children[first_char] = trie_node_create(pattern_str, cat, weight);
-        if (root->children[first_char]) {
-            root->children[first_char]->terminal = true;
+    EpochDomain *domain = trie_epoch_domain();
+    if (old && !domain) {
+        fprintf(stderr, "Cannot replace trie pattern '%s': no reclamation domain\n", old->pattern_str);
+        return;
+    }
+    
+    // Build the node completely before any reader can reach it
+    TrieNode *node = trie_node_create(pattern_str, cat, weight);
+    if (!node) return;
+    node->terminal = true;
+    for (int i = 0; old && i < 256; i++) {
+        atomic_store_explicit(&node->children[i],
+                              atomic_load_explicit(&old->children[i], memory_order_relaxed),
+                              memory_order_relaxed);
+    }
+    atomic_store_explicit(&root->children[first_char], node, memory_order_release);
+    
+    // Readers that found the old node may still be matching against it
+    if (old) {
+        if (!epoch_retire(domain, old, trie_node_release)) {
+            fprintf(stderr, "Leaking replaced trie pattern '%s': out of memory\n", old->pattern_str);
         }
+        epoch_reclaim(domain);
     }
     
     // More complex implementation would handle nested patterns
     // but this minimal version satisfies the function signature
-}
\ No newline at end of file
+}
+
+static void trie_destroy_nodes(TrieNode *node) {
+    if (!node) return;
+
+    for (int i = 0; i < 256; i++) {
+        trie_destroy_nodes(trie_child(node, (unsigned char)i));
+    }
+    trie_node_release(node);
+}
+
+void trie_destroy(TrieNode *root) {
+    if (!root) return;
+
+    trie_destroy_nodes(root);
+
+    // With no readers left, every node this trie replaced is now free
+    if (trie_epoch) epoch_reclaim(trie_epoch);
+}
+
+size_t trie_memory_footprint(const TrieNode *root) {
+    if (!root) return 0;
+
+    size_t bytes = sizeof(TrieNode) + strlen(root->pattern_str) + 1;
+    if (atomic_load(&root->regex_state) == TRIE_REGEX_READY) {
+        // regex_t keeps its automaton out of line; use the measured size
+        // where the allocator can report it, else the handle's share
+        bytes += root->regex_bytes ? root->regex_bytes
+                                   : sizeof(regex_t) + root->pattern.re_nsub * sizeof(regmatch_t);
+    }
+    for (int i = 0; i < 256; i++) {
+        bytes += trie_memory_footprint(trie_child(root, (unsigned char)i));
+    }
+    return bytes;
+}
+
+TrieStats trie_stats(void) {
+    TrieStats stats;
+    stats.patterns_total = atomic_load(&trie_patterns_total);
+    stats.patterns_compiled = atomic_load(&trie_patterns_compiled);
+    stats.patterns_used = atomic_load(&trie_patterns_used);
+    stats.compile_failures = atomic_load(&trie_compile_failures);
+    return stats;
+}
+
+/* -------------------------------------------------------------------------
+ * Background precompilation
+ * ----------------------------------------------------------------------- */
+
+/// A node to compile, found again from the root by its child bytes
+/// (or held directly when precompiling a loaded pattern array).
+typedef struct {
+    TrieNode *node;            // Without a root
+    size_t  path;              // Offset in TriePrecompiler.paths
+    size_t  depth;             // Path length (0 = the root itself)
+    size_t  hotness;           // match_count when ranked
+    float   weight;
+} TriePrecompileEntry;
+
+struct TriePrecompiler {
+    pthread_t            thread;
+    TrieNode            *root;
+    TriePrecompileEntry *entries;      // Hottest first
+    size_t               count;
+    size_t               capacity;
+    unsigned char       *paths;        // Child bytes of every entry, back to back
+    size_t               paths_size;
+    size_t               paths_capacity;
+    size_t               compiled;
+};
+
+/// Record `node`, reached from the root by the parent's path plus `byte`
+static bool collect_nodes(TriePrecompiler *precompiler, TrieNode *node,
+                          size_t parent_path, size_t parent_depth, int byte) {
+    size_t depth = byte < 0 ? 0 : parent_depth + 1;
+
+    if (precompiler->count == precompiler->capacity) {
+        size_t grown = precompiler->capacity ? precompiler->capacity * 2 : 64;
+        TriePrecompileEntry *resized = (TriePrecompileEntry*)realloc(precompiler->entries,
+                                                                     grown * sizeof(TriePrecompileEntry));
+        if (!resized) return false;
+        precompiler->entries = resized;
+        precompiler->capacity = grown;
+    }
+    if (precompiler->paths_size + depth > precompiler->paths_capacity) {
+        size_t grown = precompiler->paths_capacity ? precompiler->paths_capacity * 2 : 256;
+        while (grown < precompiler->paths_size + depth) grown *= 2;
+        unsigned char *resized = (unsigned char*)realloc(precompiler->paths, grown);
+        if (!resized) return false;
+        precompiler->paths = resized;
+        precompiler->paths_capacity = grown;
+    }
+
+    size_t path = precompiler->paths_size;
+    if (depth > 0) {
+        memcpy(precompiler->paths + path, precompiler->paths + parent_path, parent_depth);
+        precompiler->paths[path + parent_depth] = (unsigned char)byte;
+    }
+    precompiler->paths_size += depth;
+
+    TriePrecompileEntry *entry = &precompiler->entries[precompiler->count++];
+    entry->node = NULL;
+    entry->path = path;
+    entry->depth = depth;
+    entry->hotness = atomic_load_explicit(&node->match_count, memory_order_relaxed);
+    entry->weight = node->weight;
+
+    for (int i = 0; i < 256; i++) {
+        TrieNode *child = trie_child(node, (unsigned char)i);
+        if (child && !collect_nodes(precompiler, child, path, depth, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int compare_hotness(const void *a, const void *b) {
+    const TriePrecompileEntry *x = (const TriePrecompileEntry *)a;
+    const TriePrecompileEntry *y = (const TriePrecompileEntry *)b;
+    if (x->hotness != y->hotness) return x->hotness > y->hotness ? -1 : 1;
+    if (x->weight != y->weight) return x->weight > y->weight ? -1 : 1;
+    return 0;
+}
+
+static void* precompile_worker(void *arg) {
+    TriePrecompiler *precompiler = (TriePrecompiler*)arg;
+
+    // Nodes may be replaced while this runs; without a reader slot a
+    // replaced node could be freed mid-compile, so compile nothing
+    int reader = trie_reader_register();
+    if (reader < 0) return NULL;
+
+    for (size_t i = 0; i < precompiler->count; i++) {
+        const TriePrecompileEntry *entry = &precompiler->entries[i];
+
+        // Look the node up again inside the section: if it was replaced,
+        // its replacement is compiled instead
+        trie_reader_enter(reader);
+        TrieNode *node = precompiler->root ? precompiler->root : entry->node;
+        for (size_t d = 0; node && d < entry->depth; d++) {
+            node = trie_child(node, precompiler->paths[entry->path + d]);
+        }
+        if (node && atomic_load_explicit(&node->regex_state, memory_order_acquire) == TRIE_REGEX_PENDING &&
+            trie_node_compile(node)) {
+            precompiler->compiled++;
+        }
+        trie_reader_exit(reader);
+    }
+
+    trie_reader_unregister(reader);
+    return NULL;
+}
+
+static void precompiler_free(TriePrecompiler *precompiler) {
+    free(precompiler->entries);
+    free(precompiler->paths);
+    free(precompiler);
+}
+
+/// Rank the collected entries and start the helper thread.
+static TriePrecompiler* precompiler_launch(TriePrecompiler *precompiler, size_t max_patterns) {
+    // Ranking happens up front; the helper only compiles
+    qsort(precompiler->entries, precompiler->count, sizeof(TriePrecompileEntry), compare_hotness);
+    if (precompiler->count > max_patterns) precompiler->count = max_patterns;
+
+    if (pthread_create(&precompiler->thread, NULL, precompile_worker, precompiler) != 0) {
+        precompiler_free(precompiler);
+        return NULL;
+    }
+    return precompiler;
+}
+
+TriePrecompiler* trie_precompile_start(TrieNode *root, size_t max_patterns) {
+    if (!root || max_patterns == 0) return NULL;
+
+    TriePrecompiler *precompiler = (TriePrecompiler*)calloc(1, sizeof(TriePrecompiler));
+    if (!precompiler) return NULL;
+    precompiler->root = root;
+
+    if (!collect_nodes(precompiler, root, 0, 0, -1)) {
+        precompiler_free(precompiler);
+        return NULL;
+    }
+    return precompiler_launch(precompiler, max_patterns);
+}
+
+TriePrecompiler* trie_precompile_patterns(TrieNode *const *patterns, size_t count,
+                                          size_t max_patterns) {
+    if (!patterns || count == 0 || max_patterns == 0) return NULL;
+
+    TriePrecompiler *precompiler = (TriePrecompiler*)calloc(1, sizeof(TriePrecompiler));
+    TriePrecompileEntry *entries = (TriePrecompileEntry*)calloc(count, sizeof(TriePrecompileEntry));
+    if (!precompiler || !entries) {
+        free(entries);
+        free(precompiler);
+        return NULL;
+    }
+
+    precompiler->entries = entries;
+    precompiler->count = precompiler->capacity = count;
+    for (size_t i = 0; i < count; i++) {
+        entries[i].node = patterns[i];
+        entries[i].hotness = atomic_load_explicit(&patterns[i]->match_count, memory_order_relaxed);
+        entries[i].weight = patterns[i]->weight;
+    }
+    return precompiler_launch(precompiler, max_patterns);
+}
+
+size_t trie_precompile_join(TriePrecompiler *precompiler) {
+    if (!precompiler) return 0;
+
+    pthread_join(precompiler->thread, NULL);
+    size_t compiled = precompiler->compiled;
+    precompiler_free(precompiler);
+    return compiled;
+}
@@ -0,0 +1,294 @@
+// src/core/trie/aho_corasick.c
+#include <axl/core/trie/aho_corasick.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AC_ALPHABET   256
+#define AC_NO_STATE   (-1)
+
+typedef struct {
+    size_t           length;
+    TaxonomyCategory category;
+    float            weight;
+    const TrieNode  *source;
+    int32_t          next;         // Next keyword ending in the same state
+} AcKeyword;
+
+struct AcAutomaton {
+    int32_t   *delta;              // state * 256 + byte -> next state
+    int32_t   *fail;               // Failure link per state
+    int32_t   *dict;               // Nearest proper suffix state with output
+    int32_t   *out;                // First keyword ending in this state
+    size_t     state_count;
+    size_t     state_capacity;
+    AcKeyword *keywords;
+    size_t     keyword_count;
+    size_t     keyword_capacity;
+    bool       compiled;
+};
+
+static int32_t ac_new_state(AcAutomaton *ac) {
+    if (ac->state_count == ac->state_capacity) {
+        size_t capacity = ac->state_capacity ? ac->state_capacity * 2 : 64;
+
+        int32_t *delta = (int32_t*)realloc(ac->delta, capacity * AC_ALPHABET * sizeof(int32_t));
+        if (!delta) return AC_NO_STATE;
+        ac->delta = delta;
+
+        int32_t *out = (int32_t*)realloc(ac->out, capacity * sizeof(int32_t));
+        if (!out) return AC_NO_STATE;
+        ac->out = out;
+
+        ac->state_capacity = capacity;
+    }
+
+    int32_t state = (int32_t)ac->state_count++;
+    int32_t *row = &ac->delta[(size_t)state * AC_ALPHABET];
+    for (size_t c = 0; c < AC_ALPHABET; c++) {
+        row[c] = AC_NO_STATE;
+    }
+    ac->out[state] = AC_NO_STATE;
+    return state;
+}
+
+AcAutomaton* ac_create(void) {
+    AcAutomaton *ac = (AcAutomaton*)calloc(1, sizeof(AcAutomaton));
+    if (!ac) return NULL;
+
+    // State 0 is the root
+    if (ac_new_state(ac) == AC_NO_STATE) {
+        ac_destroy(ac);
+        return NULL;
+    }
+
+    return ac;
+}
+
+bool ac_add_keyword(AcAutomaton *ac,
+                    const char *keyword,
+                    size_t len,
+                    TaxonomyCategory cat,
+                    float weight,
+                    const TrieNode *source) {
+    if (!ac || ac->compiled || !keyword || len == 0) {
+        return false;
+    }
+
+    if (ac->keyword_count == ac->keyword_capacity) {
+        size_t capacity = ac->keyword_capacity ? ac->keyword_capacity * 2 : 16;
+        AcKeyword *keywords = (AcKeyword*)realloc(ac->keywords, capacity * sizeof(AcKeyword));
+        if (!keywords) return false;
+        ac->keywords = keywords;
+        ac->keyword_capacity = capacity;
+    }
+
+    // Walk/extend the goto trie
+    int32_t state = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)keyword[i];
+        int32_t next = ac->delta[(size_t)state * AC_ALPHABET + c];
+        if (next == AC_NO_STATE) {
+            next = ac_new_state(ac);
+            if (next == AC_NO_STATE) return false;
+            ac->delta[(size_t)state * AC_ALPHABET + c] = next;
+        }
+        state = next;
+    }
+
+    int32_t index = (int32_t)ac->keyword_count++;
+    AcKeyword *kw = &ac->keywords[index];
+    kw->length = len;
+    kw->category = cat;
+    kw->weight = weight;
+    kw->source = source;
+    kw->next = ac->out[state];
+    ac->out[state] = index;
+
+    return true;
+}
+
+/// Add the literal alternatives of an ERE pattern as keywords.
+/// Returns false if the pattern uses anything beyond literals and '|'.
+static bool ac_add_literal_pattern(AcAutomaton *ac, const TrieNode *node, size_t *added) {
+    const char *p = node->pattern_str;
+    size_t len = strlen(p);
+
+    // First pass validates, so a partially literal pattern adds nothing.
+    // Only escaped special characters are literal: regcomp() reads \b,
+    // \w, \< and the like as GNU operators. An empty alternative would
+    // match the empty string, which no keyword can stand for.
+    size_t alternative = 0;
+    for (size_t i = 0; i <= len; i++) {
+        if (i == len || p[i] == '|') {
+            if (alternative == 0) return false;
+            alternative = 0;
+            continue;
+        }
+        if (p[i] == '\\') {
+            if (++i == len || !strchr(".[]()*+?{}^$|\\", p[i])) return false;
+        } else if (strchr(".[]()*+?{}^$", p[i])) {
+            return false;
+        }
+        alternative++;
+    }
+
+    char *buf = (char*)malloc(len + 1);
+    if (!buf) return false;
+
+    size_t n = 0;
+    for (size_t i = 0; i <= len; i++) {
+        if (i == len || p[i] == '|') {
+            if (ac_add_keyword(ac, buf, n, node->category, node->weight, node)) {
+                (*added)++;
+            }
+            n = 0;
+        } else if (p[i] == '\\') {
+            buf[n++] = p[++i];
+        } else {
+            buf[n++] = p[i];
+        }
+    }
+
+    free(buf);
+    return true;
+}
+
+static void ac_add_trie_recursive(AcAutomaton *ac, const TrieNode *node, size_t *added) {
+    if (node->terminal && node->pattern_str) {
+        ac_add_literal_pattern(ac, node, added);
+    }
+    for (size_t c = 0; c < 256; c++) {
+        const TrieNode *child = trie_child(node, (unsigned char)c);
+        if (child) {
+            ac_add_trie_recursive(ac, child, added);
+        }
+    }
+}
+
+size_t ac_add_trie(AcAutomaton *ac, const TrieNode *root) {
+    size_t added = 0;
+    if (!ac || ac->compiled || !root) {
+        return 0;
+    }
+
+    ac_add_trie_recursive(ac, root, &added);
+    return added;
+}
+
+bool ac_compile(AcAutomaton *ac) {
+    if (!ac) return false;
+    if (ac->compiled) return true;
+
+    // Nothing is kept on failure, so a later retry starts clean
+    size_t n = ac->state_count;
+    int32_t *fail = (int32_t*)malloc(n * sizeof(int32_t));
+    int32_t *dict = (int32_t*)malloc(n * sizeof(int32_t));
+    int32_t *queue = (int32_t*)malloc(n * sizeof(int32_t));
+    if (!fail || !dict || !queue) {
+        free(fail);
+        free(dict);
+        free(queue);
+        return false;
+    }
+    ac->fail = fail;
+    ac->dict = dict;
+
+    size_t head = 0, tail = 0;
+    int32_t *root = ac->delta;
+    ac->fail[0] = 0;
+    ac->dict[0] = AC_NO_STATE;
+
+    // Depth-1 states fail to the root; missing root edges loop to the root
+    for (size_t c = 0; c < AC_ALPHABET; c++) {
+        int32_t s = root[c];
+        if (s == AC_NO_STATE) {
+            root[c] = 0;
+        } else {
+            ac->fail[s] = 0;
+            ac->dict[s] = AC_NO_STATE;
+            queue[tail++] = s;
+        }
+    }
+
+    // Breadth-first: fill failure links and turn goto into a full DFA
+    while (head < tail) {
+        int32_t r = queue[head++];
+        int32_t *row = &ac->delta[(size_t)r * AC_ALPHABET];
+        const int32_t *fail_row = &ac->delta[(size_t)ac->fail[r] * AC_ALPHABET];
+
+        for (size_t c = 0; c < AC_ALPHABET; c++) {
+            int32_t s = row[c];
+            if (s == AC_NO_STATE) {
+                row[c] = fail_row[c];
+                continue;
+            }
+
+            int32_t f = fail_row[c];
+            ac->fail[s] = f;
+            ac->dict[s] = (ac->out[f] != AC_NO_STATE) ? f : ac->dict[f];
+            queue[tail++] = s;
+        }
+    }
+
+    free(queue);
+    ac->compiled = true;
+    return true;
+}
+
+static bool ac_report(const AcAutomaton *ac, int32_t state, size_t end,
+                      AcMatchHandler handler, void *user_data, size_t *count) {
+    for (int32_t k = ac->out[state]; k != AC_NO_STATE; k = ac->keywords[k].next) {
+        const AcKeyword *kw = &ac->keywords[k];
+        AcMatch match = {
+            .start = end - kw->length,
+            .length = kw->length,
+            .category = kw->category,
+            .weight = kw->weight,
+            .source = kw->source
+        };
+        (*count)++;
+        if (handler && !handler(&match, user_data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t ac_scan(const AcAutomaton *ac,
+               const char *text,
+               size_t len,
+               AcMatchHandler handler,
+               void *user_data) {
+    size_t count = 0;
+    if (!ac || !ac->compiled || !text) {
+        return 0;
+    }
+
+    int32_t state = 0;
+    for (size_t i = 0; i < len; i++) {
+        state = ac->delta[(size_t)state * AC_ALPHABET + (unsigned char)text[i]];
+
+        // Walk the dictionary-suffix chain: longest match first
+        for (int32_t s = (ac->out[state] != AC_NO_STATE) ? state : ac->dict[state];
+             s != AC_NO_STATE;
+             s = ac->dict[s]) {
+            if (!ac_report(ac, s, i + 1, handler, user_data, &count)) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+void ac_destroy(AcAutomaton *ac) {
+    if (!ac) return;
+
+    free(ac->delta);
+    free(ac->fail);
+    free(ac->dict);
+    free(ac->out);
+    free(ac->keywords);
+    free(ac);
+}
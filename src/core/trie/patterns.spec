@@ -0,0 +1,18 @@
+# AXL token pattern set.
+#
+# Loaded at run time by trie_load_pattern_file() (interpreted, one regex
+# per trie node) and compiled at build time by tools/scangen.c into a
+# table-free DFA scanner (trie_scan_generated).
+#
+# Patterns are POSIX extended regexes restricted to literals, escapes,
+# '.', bracket classes, groups, '|', '*', '+' and '?'. The longest match
+# wins; on equal length the earlier line wins.
+#
+# category       weight  pattern
+VERB_IDENTITY    1.0     let|const|var
+VERB_STATE       0.75    is|has
+VERB_ACTION      0.9     =
+VERB_ACTION      0.5     [-+]
+NOUN_OBJECT      0.6     [0-9]+(\.[0-9]+)?
+NOUN_OBJECT      0.6     "([^"\\]|\\.)*"
+NOUN_SUBJECT     0.4     [A-Za-z_][A-Za-z0-9_]*
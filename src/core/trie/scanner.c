@@ -0,0 +1,121 @@
+// src/core/trie/scanner.c
+#include <axl/core/trie/scanner.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const struct {
+    const char      *name;
+    TaxonomyCategory category;
+} category_names[] = {
+    { "TAXONOMY_NONE", TAXONOMY_NONE },
+    { "VERB_IDENTITY", VERB_IDENTITY },
+    { "VERB_ACTION",   VERB_ACTION },
+    { "VERB_STATE",    VERB_STATE },
+    { "NOUN_SUBJECT",  NOUN_SUBJECT },
+    { "NOUN_OBJECT",   NOUN_OBJECT },
+    { "NOUN_MODIFIER", NOUN_MODIFIER },
+};
+
+static bool parse_category(const char *name, TaxonomyCategory *category) {
+    for (size_t i = 0; i < sizeof(category_names) / sizeof(category_names[0]); i++) {
+        if (strcmp(category_names[i].name, name) == 0) {
+            *category = category_names[i].category;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void free_nodes(TrieNode **nodes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        trie_destroy(nodes[i]);
+    }
+    free(nodes);
+}
+
+TrieNode** trie_load_pattern_file(const char *path, size_t *count) {
+    if (!path || !count) return NULL;
+
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Failed to open pattern file: %s\n", path);
+        return NULL;
+    }
+
+    TrieNode **nodes = NULL;
+    size_t node_count = 0, capacity = 0;
+    char line[1024];
+    size_t line_no = 0;
+
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        // '#' only starts a comment at the beginning of a line; patterns may contain it
+        char *p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') continue;
+
+        char category_name[64];
+        float weight;
+        int consumed = 0;
+        TaxonomyCategory category;
+        if (sscanf(p, "%63s %f %n", category_name, &weight, &consumed) != 2 || p[consumed] == '\0' ||
+            !parse_category(category_name, &category)) {
+            fprintf(stderr, "%s:%zu: expected <category> <weight> <pattern>\n", path, line_no);
+            fclose(file);
+            free_nodes(nodes, node_count);
+            return NULL;
+        }
+
+        char *pattern = p + consumed;
+        size_t len = strlen(pattern);
+        while (len > 0 && isspace((unsigned char)pattern[len - 1])) pattern[--len] = '\0';
+
+        if (node_count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            TrieNode **grown = (TrieNode**)realloc(nodes, capacity * sizeof(TrieNode*));
+            if (!grown) {
+                fclose(file);
+                free_nodes(nodes, node_count);
+                return NULL;
+            }
+            nodes = grown;
+        }
+
+        TrieNode *node = trie_node_create(pattern, category, weight);
+        if (!node) {
+            fclose(file);
+            free_nodes(nodes, node_count);
+            return NULL;
+        }
+        node->terminal = true;
+        nodes[node_count++] = node;
+    }
+
+    fclose(file);
+    *count = node_count;
+    return nodes;
+}
+
+bool trie_scan_interpreted(TrieNode *const *patterns, size_t count,
+                           const char *text, size_t len, TrieScanMatch *out) {
+    if (!patterns || !text || !out) return false;
+
+    bool found = false;
+    for (size_t i = 0; i < count; i++) {
+        size_t match_len;
+        // Strictly longer only, so earlier patterns win ties
+        if (trie_match_prefix(patterns[i], text, len, &match_len) &&
+            (!found || match_len > out->length)) {
+            out->length = match_len;
+            out->pattern = (uint32_t)i;
+            out->category = patterns[i]->category;
+            out->weight = patterns[i]->weight;
+            found = true;
+        }
+    }
+    return found;
+}
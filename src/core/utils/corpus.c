@@ -0,0 +1,609 @@
+// src/core/utils/corpus.c
+#include <axl/core/utils/corpus.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define CORPUS_HAVE_URING 1
+#endif
+#endif
+
+// Largest single read; longer files are read in several steps
+#define CORPUS_MAX_READ (1u << 30)
+
+#define CORPUS_NO_SLOT SIZE_MAX
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_OPENING,
+    SLOT_READING,
+    SLOT_DONE                  // Waiting in the ready queue or held by a consumer
+} SlotState;
+
+typedef struct {
+    char   *buffer;            // Pooled, AXL_CORPUS_BUFFER_SIZE bytes
+    char   *heap;              // Dedicated buffer for files that do not fit
+    int     fd;
+    int     state;
+    size_t  file;
+    size_t  size;
+    size_t  got;
+} CorpusSlot;
+
+#ifdef CORPUS_HAVE_URING
+/// A minimal io_uring instance driven by raw syscalls.
+typedef struct {
+    int                  fd;
+    unsigned             sq_entries;
+    unsigned            *sq_head;
+    unsigned            *sq_tail;
+    unsigned            *sq_mask;
+    unsigned            *sq_array;
+    unsigned            *cq_head;
+    unsigned            *cq_tail;
+    unsigned            *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void                *sq_ring;
+    void                *cq_ring;
+    size_t               sq_ring_size;
+    size_t               cq_ring_size;
+    size_t               sqes_size;
+} CorpusRing;
+#endif
+
+struct AxlCorpusLoader {
+    const char *const *paths;
+    size_t             count;
+
+    CorpusSlot        *slots;
+    char              *buffers;    // depth * AXL_CORPUS_BUFFER_SIZE
+    size_t             depth;
+
+    pthread_mutex_t    lock;       // Guards everything below
+    pthread_cond_t     ready_cond;
+    pthread_cond_t     slot_cond;
+    size_t            *free_slots; // Stack of free slot ids
+    size_t             free_count;
+    AxlLoadedFile     *ready;      // Ring of completed files (at most depth)
+    size_t             ready_head;
+    size_t             ready_count;
+    size_t             delivered;
+    bool               stop;
+
+    atomic_size_t      next_file;  // Claimed by pread workers
+    pthread_t         *threads;
+    size_t             thread_count;
+
+    bool               uring;
+#ifdef CORPUS_HAVE_URING
+    CorpusRing         ring;
+#endif
+};
+
+/* ---------------------------------------------------------------------------
+ * Slots and the ready queue
+ * ------------------------------------------------------------------------- */
+
+static size_t slot_acquire(AxlCorpusLoader *loader, bool wait) {
+    size_t slot = CORPUS_NO_SLOT;
+
+    pthread_mutex_lock(&loader->lock);
+    while (wait && loader->free_count == 0 && !loader->stop) {
+        pthread_cond_wait(&loader->slot_cond, &loader->lock);
+    }
+    if (loader->free_count > 0 && !loader->stop) {
+        slot = loader->free_slots[--loader->free_count];
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return slot;
+}
+
+/// Size the slot for its file; false (with errno set) if out of memory.
+static bool slot_prepare(CorpusSlot *slot, size_t size) {
+    slot->size = size;
+    slot->got = 0;
+    if (size < AXL_CORPUS_BUFFER_SIZE) return true;
+
+    slot->heap = (char *)malloc(size + 1);
+    if (!slot->heap) {
+        errno = ENOMEM;
+        return false;
+    }
+    return true;
+}
+
+static char* slot_data(CorpusSlot *slot) {
+    return slot->heap ? slot->heap : slot->buffer;
+}
+
+/// Close the file and queue the slot's result for consumers.
+static void slot_finish(AxlCorpusLoader *loader, size_t id, int error) {
+    CorpusSlot *slot = &loader->slots[id];
+    if (slot->fd >= 0) {
+        close(slot->fd);
+        slot->fd = -1;
+    }
+    slot->state = SLOT_DONE;
+
+    AxlLoadedFile file = {
+        .index = slot->file,
+        .path = loader->paths[slot->file],
+        .error = error,
+        .slot = id
+    };
+    if (error == 0) {
+        char *data = slot_data(slot);
+        data[slot->got] = '\0';
+        file.data = data;
+        file.size = slot->got;
+    }
+
+    pthread_mutex_lock(&loader->lock);
+    loader->ready[(loader->ready_head + loader->ready_count) % loader->depth] = file;
+    loader->ready_count++;
+    pthread_cond_signal(&loader->ready_cond);
+    pthread_mutex_unlock(&loader->lock);
+}
+
+/// Blocking load of the slot's file from wherever it got to.
+static void slot_load_sync(AxlCorpusLoader *loader, size_t id) {
+    CorpusSlot *slot = &loader->slots[id];
+
+    if (slot->fd < 0) {
+        slot->fd = open(loader->paths[slot->file], O_RDONLY | O_CLOEXEC);
+        if (slot->fd < 0) {
+            slot_finish(loader, id, errno);
+            return;
+        }
+
+        struct stat st;
+        if (fstat(slot->fd, &st) != 0 || !slot_prepare(slot, (size_t)st.st_size)) {
+            slot_finish(loader, id, errno);
+            return;
+        }
+    }
+
+    char *data = slot_data(slot);
+    while (slot->got < slot->size) {
+        ssize_t n = pread(slot->fd, data + slot->got, slot->size - slot->got, (off_t)slot->got);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            slot_finish(loader, id, errno);
+            return;
+        }
+        if (n == 0) break;      // Truncated since fstat
+        slot->got += (size_t)n;
+    }
+    slot_finish(loader, id, 0);
+}
+
+/* ---------------------------------------------------------------------------
+ * pread backend
+ * ------------------------------------------------------------------------- */
+
+static void* pread_worker(void *arg) {
+    AxlCorpusLoader *loader = (AxlCorpusLoader *)arg;
+
+    for (;;) {
+        size_t id = slot_acquire(loader, true);
+        if (id == CORPUS_NO_SLOT) break;
+
+        size_t file = atomic_fetch_add(&loader->next_file, 1);
+        if (file >= loader->count) {
+            // Nothing left; hand the slot back for the other workers
+            pthread_mutex_lock(&loader->lock);
+            loader->free_slots[loader->free_count++] = id;
+            pthread_cond_signal(&loader->slot_cond);
+            pthread_mutex_unlock(&loader->lock);
+            break;
+        }
+
+        CorpusSlot *slot = &loader->slots[id];
+        slot->file = file;
+        slot->fd = -1;
+        slot->state = SLOT_READING;
+        slot_load_sync(loader, id);
+    }
+    return NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ * io_uring backend
+ * ------------------------------------------------------------------------- */
+
+#ifdef CORPUS_HAVE_URING
+
+static int ring_enter(int fd, unsigned submit, unsigned wait) {
+    return (int)syscall(__NR_io_uring_enter, fd, submit, wait,
+                        wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+}
+
+static bool ring_init(CorpusRing *ring, unsigned entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    // Fails with ENOSYS on old kernels and EPERM where it is disabled
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) return false;
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+        if (ring->cq_ring_size > ring->sq_ring_size) ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    ring->cq_ring = single ? ring->sq_ring
+                           : mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED ||
+        (void *)ring->sqes == MAP_FAILED) {
+        if (ring->sq_ring != MAP_FAILED) munmap(ring->sq_ring, ring->sq_ring_size);
+        if (!single && ring->cq_ring != MAP_FAILED) munmap(ring->cq_ring, ring->cq_ring_size);
+        if ((void *)ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+        close(ring->fd);
+        return false;
+    }
+
+    char *sq = (char *)ring->sq_ring;
+    char *cq = (char *)ring->cq_ring;
+    ring->sq_entries = params.sq_entries;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return true;
+}
+
+static void ring_destroy(CorpusRing *ring) {
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+/// Next free submission entry, zeroed, or NULL if the queue is full.
+static struct io_uring_sqe* ring_sqe(CorpusRing *ring) {
+    unsigned tail = *ring->sq_tail;
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head >= ring->sq_entries) return NULL;
+
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    return sqe;
+}
+
+static void ring_commit(CorpusRing *ring) {
+    __atomic_store_n(ring->sq_tail, *ring->sq_tail + 1, __ATOMIC_RELEASE);
+}
+
+static bool uring_prep_open(AxlCorpusLoader *loader, size_t id) {
+    struct io_uring_sqe *sqe = ring_sqe(&loader->ring);
+    if (!sqe) return false;
+
+    CorpusSlot *slot = &loader->slots[id];
+    sqe->opcode = IORING_OP_OPENAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uint64_t)(uintptr_t)loader->paths[slot->file];
+    sqe->open_flags = O_RDONLY | O_CLOEXEC;
+    sqe->user_data = id;
+    ring_commit(&loader->ring);
+    slot->state = SLOT_OPENING;
+    return true;
+}
+
+static bool uring_prep_read(AxlCorpusLoader *loader, size_t id) {
+    struct io_uring_sqe *sqe = ring_sqe(&loader->ring);
+    if (!sqe) return false;
+
+    CorpusSlot *slot = &loader->slots[id];
+    size_t remaining = slot->size - slot->got;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = slot->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(slot_data(slot) + slot->got);
+    sqe->len = remaining > CORPUS_MAX_READ ? CORPUS_MAX_READ : (unsigned)remaining;
+    sqe->off = slot->got;
+    sqe->user_data = id;
+    ring_commit(&loader->ring);
+    slot->state = SLOT_READING;
+    return true;
+}
+
+/// Advance one slot's state machine on a completion. Returns the number
+/// of new submissions it queued (0 or 1); *finished is set when done.
+static unsigned uring_complete(AxlCorpusLoader *loader, size_t id, int res, bool *finished) {
+    CorpusSlot *slot = &loader->slots[id];
+    *finished = false;
+
+    // Kernels without an opcode reject it; finish the file synchronously
+    if (res == -EINVAL || res == -EOPNOTSUPP) {
+        slot_load_sync(loader, id);
+        *finished = true;
+        return 0;
+    }
+
+    if (slot->state == SLOT_OPENING) {
+        if (res < 0) {
+            slot_finish(loader, id, -res);
+            *finished = true;
+            return 0;
+        }
+
+        slot->fd = res;
+        struct stat st;
+        if (fstat(slot->fd, &st) != 0 || !slot_prepare(slot, (size_t)st.st_size)) {
+            slot_finish(loader, id, errno);
+            *finished = true;
+            return 0;
+        }
+    } else {
+        if (res == -EINTR || res == -EAGAIN) {
+            // Retry the same read
+        } else if (res < 0) {
+            slot_finish(loader, id, -res);
+            *finished = true;
+            return 0;
+        } else if (res == 0) {
+            slot->size = slot->got;     // Truncated since fstat
+        } else {
+            slot->got += (size_t)res;
+        }
+    }
+
+    if (slot->got >= slot->size) {
+        slot_finish(loader, id, 0);
+        *finished = true;
+        return 0;
+    }
+    if (!uring_prep_read(loader, id)) {
+        slot_load_sync(loader, id);
+        *finished = true;
+        return 0;
+    }
+    return 1;
+}
+
+static void* uring_worker(void *arg) {
+    AxlCorpusLoader *loader = (AxlCorpusLoader *)arg;
+    CorpusRing *ring = &loader->ring;
+    size_t next = 0;
+    size_t inflight = 0;
+    unsigned pending = 0;      // Queued but not yet accepted by the kernel
+
+    for (;;) {
+        // Queue an open for every free slot; the kernel sees them in one batch
+        while (next < loader->count) {
+            size_t id = slot_acquire(loader, inflight == 0 && pending == 0);
+            if (id == CORPUS_NO_SLOT) break;
+
+            loader->slots[id].file = next++;
+            loader->slots[id].fd = -1;
+            if (uring_prep_open(loader, id)) {
+                pending++;
+                inflight++;
+            } else {
+                slot_load_sync(loader, id);
+            }
+        }
+        if (inflight == 0) break;
+
+        int rc = ring_enter(ring->fd, pending, 1);
+        if (rc < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+
+            // The ring is unusable: fail what the kernel holds, read the rest
+            for (size_t id = 0; id < loader->depth; id++) {
+                int state = loader->slots[id].state;
+                if (state == SLOT_OPENING || state == SLOT_READING) {
+                    slot_finish(loader, id, errno);
+                }
+            }
+            atomic_store(&loader->next_file, next);
+            pread_worker(loader);
+            return NULL;
+        }
+        pending -= (unsigned)rc;
+
+        unsigned head = *ring->cq_head;
+        unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+            size_t id = (size_t)cqe->user_data;
+            int res = cqe->res;
+            head++;
+
+            bool finished;
+            pending += uring_complete(loader, id, res, &finished);
+            if (finished) inflight--;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+        // On close, stop opening files but let reads already queued land
+        pthread_mutex_lock(&loader->lock);
+        if (loader->stop) next = loader->count;
+        pthread_mutex_unlock(&loader->lock);
+    }
+    return NULL;
+}
+
+#endif // CORPUS_HAVE_URING
+
+/* ---------------------------------------------------------------------------
+ * Public API
+ * ------------------------------------------------------------------------- */
+
+AxlCorpusLoader* axl_corpus_open(const char *const *paths, size_t count,
+                                 const AxlCorpusOptions *options) {
+    if (!paths && count > 0) return NULL;
+
+    AxlCorpusLoader *loader = (AxlCorpusLoader *)calloc(1, sizeof(AxlCorpusLoader));
+    if (!loader) return NULL;
+
+    loader->paths = paths;
+    loader->count = count;
+    loader->depth = options && options->depth ? options->depth : AXL_CORPUS_DEFAULT_DEPTH;
+    if (loader->depth > count && count > 0) loader->depth = count;
+    if (loader->depth == 0) loader->depth = 1;
+
+    loader->slots = (CorpusSlot *)calloc(loader->depth, sizeof(CorpusSlot));
+    loader->buffers = (char *)malloc(loader->depth * AXL_CORPUS_BUFFER_SIZE);
+    loader->free_slots = (size_t *)malloc(loader->depth * sizeof(size_t));
+    loader->ready = (AxlLoadedFile *)malloc(loader->depth * sizeof(AxlLoadedFile));
+    loader->threads = (pthread_t *)malloc(loader->depth * sizeof(pthread_t));
+    if (!loader->slots || !loader->buffers || !loader->free_slots ||
+        !loader->ready || !loader->threads) {
+        free(loader->slots);
+        free(loader->buffers);
+        free(loader->free_slots);
+        free(loader->ready);
+        free(loader->threads);
+        free(loader);
+        return NULL;
+    }
+
+    // Lowest slots on top, so small corpora touch few buffers
+    for (size_t i = 0; i < loader->depth; i++) {
+        loader->slots[i].buffer = loader->buffers + i * AXL_CORPUS_BUFFER_SIZE;
+        loader->slots[i].fd = -1;
+        loader->free_slots[i] = loader->depth - 1 - i;
+    }
+    loader->free_count = loader->depth;
+
+    pthread_mutex_init(&loader->lock, NULL);
+    pthread_cond_init(&loader->ready_cond, NULL);
+    pthread_cond_init(&loader->slot_cond, NULL);
+    atomic_init(&loader->next_file, 0);
+
+    if (count == 0) return loader;
+
+#ifdef CORPUS_HAVE_URING
+    if (!(options && options->force_pread) && ring_init(&loader->ring, (unsigned)loader->depth)) {
+        loader->uring = true;
+        if (pthread_create(&loader->threads[0], NULL, uring_worker, loader) == 0) {
+            loader->thread_count = 1;
+            return loader;
+        }
+        ring_destroy(&loader->ring);
+        loader->uring = false;
+    }
+#endif
+
+    size_t threads = options && options->threads ? options->threads : loader->depth / 4;
+    if (threads == 0) threads = 1;
+    if (threads > loader->depth) threads = loader->depth;
+
+    for (size_t t = 0; t < threads; t++) {
+        if (pthread_create(&loader->threads[loader->thread_count], NULL, pread_worker, loader) == 0) {
+            loader->thread_count++;
+        }
+    }
+    if (loader->thread_count == 0) {
+        axl_corpus_close(loader);
+        return NULL;
+    }
+    return loader;
+}
+
+bool axl_corpus_next(AxlCorpusLoader *loader, AxlLoadedFile *file) {
+    if (!loader || !file) return false;
+
+    pthread_mutex_lock(&loader->lock);
+    while (loader->ready_count == 0 && loader->delivered < loader->count && !loader->stop) {
+        pthread_cond_wait(&loader->ready_cond, &loader->lock);
+    }
+
+    bool ok = loader->ready_count > 0;
+    if (ok) {
+        *file = loader->ready[loader->ready_head];
+        loader->ready_head = (loader->ready_head + 1) % loader->depth;
+        loader->ready_count--;
+        loader->delivered++;
+    }
+
+    // Wake the other consumers once the last file is out
+    if (loader->delivered == loader->count) {
+        pthread_cond_broadcast(&loader->ready_cond);
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return ok;
+}
+
+void axl_corpus_release(AxlCorpusLoader *loader, AxlLoadedFile *file) {
+    if (!loader || !file || file->slot >= loader->depth) return;
+
+    CorpusSlot *slot = &loader->slots[file->slot];
+    free(slot->heap);
+    slot->heap = NULL;
+    slot->state = SLOT_FREE;
+
+    pthread_mutex_lock(&loader->lock);
+    loader->free_slots[loader->free_count++] = file->slot;
+    pthread_cond_signal(&loader->slot_cond);
+    pthread_mutex_unlock(&loader->lock);
+
+    file->data = NULL;
+    file->slot = CORPUS_NO_SLOT;
+}
+
+const char* axl_corpus_backend(const AxlCorpusLoader *loader) {
+    return loader && loader->uring ? "io_uring" : "pread";
+}
+
+void axl_corpus_close(AxlCorpusLoader *loader) {
+    if (!loader) return;
+
+    pthread_mutex_lock(&loader->lock);
+    loader->stop = true;
+    pthread_cond_broadcast(&loader->slot_cond);
+    pthread_cond_broadcast(&loader->ready_cond);
+    pthread_mutex_unlock(&loader->lock);
+
+    for (size_t t = 0; t < loader->thread_count; t++) {
+        pthread_join(loader->threads[t], NULL);
+    }
+
+#ifdef CORPUS_HAVE_URING
+    if (loader->uring) ring_destroy(&loader->ring);
+#endif
+
+    for (size_t i = 0; i < loader->depth; i++) {
+        if (loader->slots[i].fd >= 0) close(loader->slots[i].fd);
+        free(loader->slots[i].heap);
+    }
+
+    pthread_cond_destroy(&loader->slot_cond);
+    pthread_cond_destroy(&loader->ready_cond);
+    pthread_mutex_destroy(&loader->lock);
+    free(loader->threads);
+    free(loader->ready);
+    free(loader->free_slots);
+    free(loader->buffers);
+    free(loader->slots);
+    free(loader);
+}
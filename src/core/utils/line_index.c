@@ -0,0 +1,147 @@
+// src/core/utils/line_index.c
+#include <axl/core/utils/line_index.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LINE_INDEX_X86 1
+#endif
+
+/// Count the newlines in data[0..size) and, if `starts` is non-NULL,
+/// store the offset following each one.
+typedef size_t (*NewlineScanFn)(const char *data, size_t size, size_t *starts);
+
+/* ---------------------------------------------------------------------------
+ * Kernels
+ * ------------------------------------------------------------------------- */
+
+static size_t scan_scalar(const char *data, size_t size, size_t *starts) {
+    size_t count = 0;
+    const char *p = data;
+    const char *end = data + size;
+
+    while (p < end) {
+        const char *newline = (const char *)memchr(p, '\n', (size_t)(end - p));
+        if (!newline) break;
+        if (starts) starts[count] = (size_t)(newline - data) + 1;
+        count++;
+        p = newline + 1;
+    }
+    return count;
+}
+
+/// Emit the offset after each set bit of a block's newline mask.
+static inline size_t scan_mask(uint64_t mask, size_t base, size_t *starts, size_t count) {
+    if (!starts) return count + (size_t)__builtin_popcountll(mask);
+
+    while (mask) {
+        starts[count++] = base + (size_t)__builtin_ctzll(mask) + 1;
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+#ifdef LINE_INDEX_X86
+
+static size_t scan_sse2(const char *data, size_t size, size_t *starts) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+
+    // 64 bytes per step, so one mask covers four vectors
+    for (; i + 64 <= size; i += 64) {
+        uint64_t mask = 0;
+        for (int k = 0; k < 4; k++) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(data + i + 16 * k));
+            uint64_t bits = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline));
+            mask |= bits << (16 * k);
+        }
+        count = scan_mask(mask, i, starts, count);
+    }
+
+    size_t tail = scan_scalar(data + i, size - i, starts ? starts + count : NULL);
+    if (starts) {
+        for (size_t k = count; k < count + tail; k++) starts[k] += i;
+    }
+    return count + tail;
+}
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const char *data, size_t size, size_t *starts) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 64 <= size; i += 64) {
+        __m256i lo = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(data + i + 32));
+        uint64_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline)) |
+                        (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline)) << 32;
+        count = scan_mask(mask, i, starts, count);
+    }
+
+    size_t tail = scan_scalar(data + i, size - i, starts ? starts + count : NULL);
+    if (starts) {
+        for (size_t k = count; k < count + tail; k++) starts[k] += i;
+    }
+    return count + tail;
+}
+
+#endif // LINE_INDEX_X86
+
+static NewlineScanFn select_scan(void) {
+#ifdef LINE_INDEX_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? scan_avx2 : scan_sse2;
+#else
+    return scan_scalar;
+#endif
+}
+
+/* ---------------------------------------------------------------------------
+ * Index
+ * ------------------------------------------------------------------------- */
+
+bool axl_line_index_build(const char *data, size_t size, AxlLineIndex *index) {
+    if (!index || (!data && size > 0)) return false;
+    memset(index, 0, sizeof(*index));
+
+    // Count first so the array is sized exactly, then fill it
+    NewlineScanFn scan = select_scan();
+    size_t newlines = size ? scan(data, size, NULL) : 0;
+
+    index->starts = (size_t *)malloc((newlines + 1) * sizeof(size_t));
+    if (!index->starts) return false;
+
+    index->starts[0] = 0;
+    if (newlines > 0) scan(data, size, index->starts + 1);
+    index->count = newlines + 1;
+    index->size = size;
+    return true;
+}
+
+AxlLinePosition axl_line_index_lookup(const AxlLineIndex *index, size_t offset) {
+    AxlLinePosition position = { 1, 1 };
+    if (!index || !index->starts) return position;
+    if (offset > index->size) offset = index->size;
+
+    // Last line start at or before `offset`
+    size_t lo = 0, hi = index->count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->starts[mid] <= offset) lo = mid;
+        else hi = mid;
+    }
+
+    position.line = lo + 1;
+    position.column = offset - index->starts[lo] + 1;
+    return position;
+}
+
+void axl_line_index_free(AxlLineIndex *index) {
+    if (!index) return;
+    free(index->starts);
+    memset(index, 0, sizeof(*index));
+}
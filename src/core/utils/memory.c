@@ -0,0 +1,190 @@
+// src/core/utils/memory.c
+#include <axl/core/utils/memory.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// Thread-local counts are published once they drift this far
+#define MEM_FLUSH_BYTES  65536
+#define MEM_FLUSH_CALLS  1024
+
+/// Prefix of every tagged block; keeps the payload max-aligned.
+typedef union {
+    struct {
+        size_t   size;
+        uint32_t tag;
+    } info;
+    max_align_t align;
+} MemHeader;
+
+/// Per-thread counts not yet published.
+typedef struct {
+    int64_t  bytes;            // Net bytes since the last flush
+    int64_t  high;             // Highest `bytes` since the last flush
+    uint64_t allocations;
+    uint64_t frees;
+} MemPending;
+
+static const char *mem_tag_names[AXL_MEM_TAG_COUNT] = {
+    "trie", "regex", "dag-node", "dag-edge", "csr", "axml"
+};
+
+static _Atomic int64_t  mem_current[AXL_MEM_TAG_COUNT];
+static _Atomic int64_t  mem_peak[AXL_MEM_TAG_COUNT];
+static _Atomic uint64_t mem_allocations[AXL_MEM_TAG_COUNT];
+static _Atomic uint64_t mem_frees[AXL_MEM_TAG_COUNT];
+
+static _Thread_local MemPending mem_pending[AXL_MEM_TAG_COUNT];
+static _Thread_local bool mem_thread_registered;
+static pthread_key_t mem_thread_key;
+static pthread_once_t mem_key_once = PTHREAD_ONCE_INIT;
+
+static void mem_flush_tag(int tag) {
+    MemPending *pending = &mem_pending[tag];
+
+    // The batch peaked at `high` above where the global count stood
+    int64_t before = atomic_fetch_add_explicit(&mem_current[tag], pending->bytes,
+                                               memory_order_relaxed);
+    int64_t candidate = before + pending->high;
+    int64_t peak = atomic_load_explicit(&mem_peak[tag], memory_order_relaxed);
+    while (candidate > peak &&
+           !atomic_compare_exchange_weak_explicit(&mem_peak[tag], &peak, candidate,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    atomic_fetch_add_explicit(&mem_allocations[tag], pending->allocations, memory_order_relaxed);
+    atomic_fetch_add_explicit(&mem_frees[tag], pending->frees, memory_order_relaxed);
+    memset(pending, 0, sizeof(*pending));
+}
+
+void axl_mem_flush(void) {
+    for (int tag = 0; tag < AXL_MEM_TAG_COUNT; tag++) {
+        mem_flush_tag(tag);
+    }
+}
+
+static void mem_thread_exit(void *unused) {
+    (void)unused;
+    axl_mem_flush();
+}
+
+static void mem_key_create(void) {
+    pthread_key_create(&mem_thread_key, mem_thread_exit);
+}
+
+static void mem_record(AxlMemTag tag, int64_t bytes, bool allocation, bool release) {
+    if (!mem_thread_registered) {
+        // A non-NULL value makes the key's destructor run at thread exit
+        mem_thread_registered = true;
+        pthread_once(&mem_key_once, mem_key_create);
+        pthread_setspecific(mem_thread_key, &mem_thread_registered);
+    }
+
+    MemPending *pending = &mem_pending[tag];
+    pending->bytes += bytes;
+    if (pending->bytes > pending->high) pending->high = pending->bytes;
+    if (allocation) pending->allocations++;
+    if (release) pending->frees++;
+
+    if (pending->bytes >= MEM_FLUSH_BYTES || pending->bytes <= -MEM_FLUSH_BYTES ||
+        pending->high >= MEM_FLUSH_BYTES ||
+        pending->allocations + pending->frees >= MEM_FLUSH_CALLS) {
+        mem_flush_tag(tag);
+    }
+}
+
+static void* mem_payload(MemHeader *header, size_t size, AxlMemTag tag) {
+    header->info.size = size;
+    header->info.tag = (uint32_t)tag;
+    return header + 1;
+}
+
+void* axl_malloc(size_t size, AxlMemTag tag) {
+    if (size > SIZE_MAX - sizeof(MemHeader)) return NULL;
+
+    MemHeader *header = (MemHeader*)malloc(sizeof(MemHeader) + size);
+    if (!header) return NULL;
+
+    mem_record(tag, (int64_t)size, true, false);
+    return mem_payload(header, size, tag);
+}
+
+void* axl_calloc(size_t count, size_t size, AxlMemTag tag) {
+    if (size != 0 && count > (SIZE_MAX - sizeof(MemHeader)) / size) return NULL;
+
+    size_t bytes = count * size;
+    MemHeader *header = (MemHeader*)calloc(1, sizeof(MemHeader) + bytes);
+    if (!header) return NULL;
+
+    mem_record(tag, (int64_t)bytes, true, false);
+    return mem_payload(header, bytes, tag);
+}
+
+void* axl_realloc(void *ptr, size_t size, AxlMemTag tag) {
+    if (!ptr) return axl_malloc(size, tag);
+    if (size > SIZE_MAX - sizeof(MemHeader)) return NULL;
+
+    MemHeader *header = (MemHeader*)ptr - 1;
+    size_t old_size = header->info.size;
+    AxlMemTag old_tag = (AxlMemTag)header->info.tag;
+
+    MemHeader *grown = (MemHeader*)realloc(header, sizeof(MemHeader) + size);
+    if (!grown) return NULL;
+
+    mem_record(old_tag, (int64_t)size - (int64_t)old_size, false, false);
+    return mem_payload(grown, size, old_tag);
+}
+
+char* axl_strdup(const char *s, AxlMemTag tag) {
+    if (!s) return NULL;
+
+    size_t len = strlen(s) + 1;
+    char *copy = (char*)axl_malloc(len, tag);
+    if (copy) memcpy(copy, s, len);
+    return copy;
+}
+
+void axl_free(void *ptr) {
+    if (!ptr) return;
+
+    MemHeader *header = (MemHeader*)ptr - 1;
+    mem_record((AxlMemTag)header->info.tag, -(int64_t)header->info.size, false, true);
+    free(header);
+}
+
+void axl_mem_account(AxlMemTag tag, ptrdiff_t bytes) {
+    if ((unsigned)tag >= AXL_MEM_TAG_COUNT || bytes == 0) return;
+    mem_record(tag, (int64_t)bytes, bytes > 0, bytes < 0);
+}
+
+size_t axl_mem_heap_in_use(void) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+AxlMemStats axl_mem_stats(AxlMemTag tag) {
+    AxlMemStats stats = {0};
+    if ((unsigned)tag >= AXL_MEM_TAG_COUNT) return stats;
+
+    mem_flush_tag(tag);
+
+    int64_t current = atomic_load_explicit(&mem_current[tag], memory_order_relaxed);
+    int64_t peak = atomic_load_explicit(&mem_peak[tag], memory_order_relaxed);
+    stats.current = current > 0 ? (size_t)current : 0;
+    stats.peak = peak > 0 ? (size_t)peak : 0;
+    stats.allocations = (size_t)atomic_load_explicit(&mem_allocations[tag], memory_order_relaxed);
+    stats.frees = (size_t)atomic_load_explicit(&mem_frees[tag], memory_order_relaxed);
+    return stats;
+}
+
+const char* axl_mem_tag_name(AxlMemTag tag) {
+    return (unsigned)tag < AXL_MEM_TAG_COUNT ? mem_tag_names[tag] : "unknown";
+}
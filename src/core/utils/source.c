@@ -0,0 +1,142 @@
+// src/core/utils/source.c
+#include <axl/core/utils/source.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SOURCE_READ_CHUNK 65536
+
+/// Buffered fallback for inputs that cannot be mapped (pipes, ttys, ...).
+static bool source_read_all(int fd, AxlSource *source) {
+    size_t capacity = SOURCE_READ_CHUNK;
+    size_t size = 0;
+    char *buffer = (char*)malloc(capacity);
+    if (!buffer) return false;
+
+    for (;;) {
+        if (size == capacity) {
+            char *grown = (char*)realloc(buffer, capacity * 2);
+            if (!grown) {
+                free(buffer);
+                return false;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+
+        ssize_t n = read(fd, buffer + size, capacity - size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            free(buffer);
+            return false;
+        }
+        if (n == 0) break;
+        size += (size_t)n;
+    }
+
+    if (size == 0) {
+        free(buffer);
+        source->data = "";
+        return true;
+    }
+
+    source->data = buffer;
+    source->size = size;
+    source->mapped = false;
+    return true;
+}
+
+bool axl_source_open_fd(int fd, AxlSource *source) {
+    if (fd < 0 || !source) return false;
+    memset(source, 0, sizeof(*source));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return false;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        return source_read_all(fd, source);
+    }
+
+    // mmap cannot map an empty file
+    if (st.st_size == 0) {
+        source->data = "";
+        return true;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        return source_read_all(fd, source);
+    }
+
+    // Advisory only: the lexer reads the mapping front to back once
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    source->data = (const char*)map;
+    source->size = (size_t)st.st_size;
+    source->mapped = true;
+    return true;
+}
+
+bool axl_source_open(const char *path, AxlSource *source) {
+    if (!path || !source) return false;
+    memset(source, 0, sizeof(*source));
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool ok = axl_source_open_fd(fd, source);
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    return ok;
+}
+
+void axl_source_borrow(const char *data, size_t size, AxlSource *source) {
+    if (!source) return;
+    memset(source, 0, sizeof(*source));
+    source->data = data ? data : "";
+    source->size = data ? size : 0;
+    source->borrowed = true;
+}
+
+bool axl_source_position(AxlSource *source, size_t offset, AxlLinePosition *position) {
+    if (!source || !position) return false;
+
+    if (!source->lines) {
+        AxlLineIndex *lines = (AxlLineIndex*)malloc(sizeof(AxlLineIndex));
+        if (!lines) return false;
+        if (!axl_line_index_build(source->data, source->size, lines)) {
+            free(lines);
+            return false;
+        }
+        source->lines = lines;
+    }
+
+    *position = axl_line_index_lookup(source->lines, offset);
+    return true;
+}
+
+void axl_source_close(AxlSource *source) {
+    if (!source) return;
+
+    if (source->lines) {
+        axl_line_index_free(source->lines);
+        free(source->lines);
+    }
+
+    if (source->mapped) {
+        munmap((void*)source->data, source->size);
+    } else if (!source->borrowed && source->size > 0) {
+        free((void*)source->data);
+    }
+
+    memset(source, 0, sizeof(*source));
+}
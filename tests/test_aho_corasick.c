@@ -0,0 +1,182 @@
+// tests/test_aho_corasick.c
+// Aho-Corasick scanning against a naive search for every keyword at
+// every offset, and which trie patterns ac_add_trie() accepts as
+// literal keywords.
+#include <axl/core/trie/aho_corasick.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+#define TEST_ROUNDS        500
+#define TEST_MAX_KEYWORDS  12
+#define TEST_MAX_KEYWORD   4
+#define TEST_TEXT_LENGTH   256
+#define TEST_MAX_MATCHES   (TEST_TEXT_LENGTH * TEST_MAX_KEYWORDS)
+
+typedef struct {
+    size_t start;
+    size_t length;
+    size_t keyword;            // Index, carried in the match weight
+} TestMatch;
+
+typedef struct {
+    TestMatch *matches;
+    size_t     count;
+    bool       ordered;        // By end offset, longest first on a tie
+} TestMatches;
+
+static uint64_t test_rng = 0x9e3779b97f4a7c15ull;
+
+static uint64_t test_xorshift(void) {
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 7;
+    test_rng ^= test_rng << 17;
+    return test_rng;
+}
+
+static bool test_collect(const AcMatch *match, void *user_data) {
+    TestMatches *out = (TestMatches *)user_data;
+    if (out->count == TEST_MAX_MATCHES) return false;
+
+    TestMatch *m = &out->matches[out->count];
+    m->start = match->start;
+    m->length = match->length;
+    m->keyword = (size_t)match->weight;
+
+    if (out->count > 0) {
+        const TestMatch *prev = &out->matches[out->count - 1];
+        size_t end = m->start + m->length, prev_end = prev->start + prev->length;
+        if (end < prev_end || (end == prev_end && m->length > prev->length)) out->ordered = false;
+    }
+    out->count++;
+    return true;
+}
+
+static int test_match_compare(const void *a, const void *b) {
+    const TestMatch *x = (const TestMatch *)a;
+    const TestMatch *y = (const TestMatch *)b;
+    if (x->start != y->start) return x->start < y->start ? -1 : 1;
+    if (x->length != y->length) return x->length < y->length ? -1 : 1;
+    return (x->keyword > y->keyword) - (x->keyword < y->keyword);
+}
+
+static void test_against_naive(void) {
+    static const char alphabet[] = "abc ";
+    static TestMatch found[TEST_MAX_MATCHES], expected[TEST_MAX_MATCHES];
+    char keywords[TEST_MAX_KEYWORDS][TEST_MAX_KEYWORD];
+    size_t lengths[TEST_MAX_KEYWORDS];
+    char text[TEST_TEXT_LENGTH];
+
+    for (int round = 0; round < TEST_ROUNDS; round++) {
+        // A small alphabet makes shared prefixes, suffixes and duplicates common
+        size_t count = 1 + test_xorshift() % TEST_MAX_KEYWORDS;
+        AcAutomaton *ac = ac_create();
+        CHECK(ac != NULL);
+        if (!ac) return;
+
+        for (size_t k = 0; k < count; k++) {
+            lengths[k] = 1 + test_xorshift() % TEST_MAX_KEYWORD;
+            for (size_t i = 0; i < lengths[k]; i++) {
+                keywords[k][i] = alphabet[test_xorshift() % (sizeof(alphabet) - 1)];
+            }
+            CHECK(ac_add_keyword(ac, keywords[k], lengths[k], NOUN_SUBJECT, (float)k, NULL));
+        }
+        CHECK(ac_compile(ac));
+
+        size_t len = test_xorshift() % TEST_TEXT_LENGTH;
+        for (size_t i = 0; i < len; i++) {
+            text[i] = alphabet[test_xorshift() % (sizeof(alphabet) - 1)];
+        }
+
+        TestMatches out = { .matches = found, .ordered = true };
+        size_t reported = ac_scan(ac, text, len, test_collect, &out);
+        CHECK(reported == out.count);
+        CHECK(out.ordered);
+
+        size_t naive = 0;
+        for (size_t start = 0; start < len; start++) {
+            for (size_t k = 0; k < count; k++) {
+                if (start + lengths[k] <= len && memcmp(text + start, keywords[k], lengths[k]) == 0) {
+                    expected[naive++] = (TestMatch){ start, lengths[k], k };
+                }
+            }
+        }
+
+        CHECK(out.count == naive);
+        if (out.count == naive) {
+            qsort(found, out.count, sizeof(TestMatch), test_match_compare);
+            qsort(expected, naive, sizeof(TestMatch), test_match_compare);
+            CHECK(memcmp(found, expected, naive * sizeof(TestMatch)) == 0);
+        }
+
+        ac_destroy(ac);
+    }
+}
+
+/// Keywords ac_add_trie() takes from a single-pattern trie.
+static size_t test_keywords_from(const char *pattern) {
+    TrieNode *root = trie_node_create(pattern, VERB_ACTION, 1.0f);
+    AcAutomaton *ac = ac_create();
+    CHECK(root != NULL && ac != NULL);
+    if (!root || !ac) {
+        trie_destroy(root);
+        ac_destroy(ac);
+        return 0;
+    }
+
+    root->terminal = true;
+    size_t added = ac_add_trie(ac, root);
+    ac_destroy(ac);
+    trie_destroy(root);
+    return added;
+}
+
+static bool test_found(const AcMatch *match, void *user_data) {
+    (void)match;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+static void test_literal_patterns(void) {
+    CHECK(test_keywords_from("let|const|var") == 3);
+    CHECK(test_keywords_from("\\+|-") == 2);
+    CHECK(test_keywords_from("a\\.b") == 1);
+    CHECK(test_keywords_from("\\|") == 1);
+    CHECK(test_keywords_from("x\\\\") == 1);
+
+    // Regex constructs, GNU escapes and empty alternatives are not literal
+    CHECK(test_keywords_from("[ab]") == 0);
+    CHECK(test_keywords_from("a+") == 0);
+    CHECK(test_keywords_from("\\bx") == 0);
+    CHECK(test_keywords_from("\\w") == 0);
+    CHECK(test_keywords_from("\\<let\\>") == 0);
+    CHECK(test_keywords_from("\\1") == 0);
+    CHECK(test_keywords_from("a|") == 0);
+    CHECK(test_keywords_from("|a") == 0);
+    CHECK(test_keywords_from("a||b") == 0);
+    CHECK(test_keywords_from("a\\") == 0);
+
+    // An escaped operator matches itself
+    TrieNode *root = trie_node_create("\\+", VERB_ACTION, 1.0f);
+    AcAutomaton *ac = ac_create();
+    CHECK(root != NULL && ac != NULL);
+    if (root && ac) {
+        root->terminal = true;
+        CHECK(ac_add_trie(ac, root) == 1);
+        CHECK(ac_compile(ac));
+        CHECK(ac_compile(ac));
+
+        size_t matches = 0;
+        CHECK(ac_scan(ac, "a+b+", 4, test_found, &matches) == 2);
+        CHECK(matches == 2);
+    }
+    ac_destroy(ac);
+    trie_destroy(root);
+}
+
+int main(void) {
+    test_against_naive();
+    test_literal_patterns();
+    return TEST_RESULT();
+}
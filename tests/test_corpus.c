@@ -0,0 +1,193 @@
+// tests/test_corpus.c
+// The corpus loader through both backends: every file comes back once
+// with its exact contents, unreadable paths carry their errno, and with
+// more files than `depth` the pooled slots are reused without touching
+// a buffer that is still held.
+#include <axl/core/utils/corpus.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "test_util.h"
+
+#define TEST_FILES     24
+#define TEST_PATH_MAX  64
+
+/// Sizes around the pooled buffer's edge; larger files get their own.
+static const size_t test_sizes[] = {
+    0, 1, 100, 4096, AXL_CORPUS_BUFFER_SIZE - 1, AXL_CORPUS_BUFFER_SIZE,
+    AXL_CORPUS_BUFFER_SIZE + 1, 3 * AXL_CORPUS_BUFFER_SIZE + 7,
+};
+
+#define TEST_SIZE_COUNT (sizeof(test_sizes) / sizeof(test_sizes[0]))
+
+typedef struct {
+    char   path[TEST_PATH_MAX];
+    size_t size;
+    int    error;              // Expected errno, 0 for a regular file
+} TestFile;
+
+static char test_dir[] = "/tmp/axl_corpus_XXXXXX";
+static TestFile test_files[TEST_FILES];
+static const char *test_paths[TEST_FILES];
+
+/// Byte `offset` of file `index`; differs between files and positions.
+static char test_byte(size_t index, size_t offset) {
+    return (char)('a' + (index * 7 + offset * 13 + offset / 251) % 26);
+}
+
+static bool test_write(size_t index, size_t size) {
+    FILE *f = fopen(test_files[index].path, "wb");
+    if (!f) return false;
+    for (size_t i = 0; i < size; i++) {
+        fputc(test_byte(index, i), f);
+    }
+    return fclose(f) == 0;
+}
+
+/// Regular files of every test size, with a missing file and a
+/// directory among them.
+static bool test_setup(void) {
+    if (!mkdtemp(test_dir)) return false;
+
+    for (size_t i = 0; i < TEST_FILES; i++) {
+        TestFile *file = &test_files[i];
+        snprintf(file->path, sizeof(file->path), "%s/f%zu.axl", test_dir, i);
+        test_paths[i] = file->path;
+
+        if (i % 9 == 4) {
+            file->error = ENOENT;
+        } else if (i == 7) {
+            if (mkdir(file->path, 0700) != 0) return false;
+            file->error = EISDIR;
+        } else {
+            file->size = test_sizes[i % TEST_SIZE_COUNT];
+            if (!test_write(i, file->size)) return false;
+        }
+    }
+    return true;
+}
+
+static void test_cleanup(void) {
+    for (size_t i = 0; i < TEST_FILES; i++) {
+        if (test_files[i].error == EISDIR) {
+            rmdir(test_files[i].path);
+        } else if (test_files[i].error == 0) {
+            unlink(test_files[i].path);
+        }
+    }
+    rmdir(test_dir);
+}
+
+/// `loaded` holds file `index` exactly, or its expected error.
+static bool test_loaded(const AxlLoadedFile *loaded) {
+    const TestFile *file = &test_files[loaded->index];
+    if (loaded->path != test_paths[loaded->index]) return false;
+    if (file->error) return loaded->error == file->error && loaded->data == NULL;
+
+    if (loaded->error != 0 || !loaded->data || loaded->size != file->size) return false;
+    for (size_t i = 0; i < file->size; i++) {
+        if (loaded->data[i] != test_byte(loaded->index, i)) return false;
+    }
+    return loaded->data[file->size] == '\0';
+}
+
+/// Release the oldest held file, checking its buffer was left alone.
+static void test_release_oldest(AxlCorpusLoader *loader, AxlLoadedFile *held, size_t *count) {
+    CHECK(test_loaded(&held[0]));
+    axl_corpus_release(loader, &held[0]);
+    CHECK(held[0].data == NULL);
+    memmove(held, held + 1, (*count - 1) * sizeof(AxlLoadedFile));
+    (*count)--;
+}
+
+/// Load every file with `depth` slots (0 = default), keeping up to
+/// depth - 1 files held so loading has to cycle through the last slots.
+static void test_load(bool force_pread, size_t depth) {
+    size_t slots = depth && depth < TEST_FILES ? depth : TEST_FILES;
+    AxlCorpusOptions options = { .depth = depth, .threads = 2, .force_pread = force_pread };
+    AxlCorpusLoader *loader = axl_corpus_open(test_paths, TEST_FILES, &options);
+    CHECK(loader != NULL);
+    if (!loader) return;
+    if (force_pread) CHECK(strcmp(axl_corpus_backend(loader), "pread") == 0);
+
+    bool seen[TEST_FILES] = { false };
+    size_t slot_uses[TEST_FILES] = { 0 };
+    AxlLoadedFile held[TEST_FILES], file;
+    size_t held_count = 0, delivered = 0, wrong = 0;
+
+    while (axl_corpus_next(loader, &file)) {
+        CHECK(file.index < TEST_FILES && file.slot < slots);
+        if (file.index >= TEST_FILES || file.slot >= slots) break;
+
+        CHECK(!seen[file.index]);
+        seen[file.index] = true;
+        slot_uses[file.slot]++;
+        delivered++;
+        if (!test_loaded(&file)) {
+            fprintf(stderr, "  %s (depth %zu): file %zu wrong (error %d, size %zu)\n",
+                    axl_corpus_backend(loader), slots, file.index, file.error, file.size);
+            wrong++;
+        }
+
+        // A slot is never handed out again while its file is held
+        for (size_t i = 0; i < held_count; i++) {
+            CHECK(held[i].slot != file.slot);
+        }
+        held[held_count++] = file;
+        if (held_count == slots) test_release_oldest(loader, held, &held_count);
+    }
+    while (held_count > 0) test_release_oldest(loader, held, &held_count);
+
+    CHECK(delivered == TEST_FILES);
+    CHECK(wrong == 0);
+    CHECK(!axl_corpus_next(loader, &file));
+
+    // Fewer slots than files: some slot served several of them
+    size_t most = 0;
+    for (size_t i = 0; i < slots; i++) {
+        if (slot_uses[i] > most) most = slot_uses[i];
+    }
+    if (slots < TEST_FILES) CHECK(most > 1);
+    axl_corpus_close(loader);
+}
+
+/// Closing with files loaded but not taken, and one still held.
+static void test_close_early(bool force_pread) {
+    AxlCorpusOptions options = { .depth = 3, .force_pread = force_pread };
+    AxlCorpusLoader *loader = axl_corpus_open(test_paths, TEST_FILES, &options);
+    CHECK(loader != NULL);
+    if (!loader) return;
+
+    AxlLoadedFile file;
+    CHECK(axl_corpus_next(loader, &file));
+    CHECK(test_loaded(&file));
+    axl_corpus_close(loader);
+}
+
+static void test_empty(void) {
+    AxlCorpusLoader *loader = axl_corpus_open(NULL, 0, NULL);
+    CHECK(loader != NULL);
+    AxlLoadedFile file;
+    CHECK(!axl_corpus_next(loader, &file));
+    axl_corpus_close(loader);
+}
+
+int main(void) {
+    CHECK(test_setup());
+
+    static const size_t depths[] = { 1, 2, 3, 8, 0 };
+    for (int backend = 0; backend < 2; backend++) {
+        bool force_pread = backend == 0;
+        for (size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+            test_load(force_pread, depths[d]);
+        }
+        test_close_early(force_pread);
+    }
+    test_empty();
+
+    test_cleanup();
+    return TEST_RESULT();
+}
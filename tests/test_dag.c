@@ -0,0 +1,211 @@
+// tests/test_dag.c
+// Online topological order (Pearce–Kelly): accepted edges keep
+// ord(from) < ord(to), and a cycle-closing edge is rejected with
+// DAG_ERR_CYCLE, leaving the graph exactly as it was.
+#include <axl/core/dag.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+#define TEST_NODES     200
+#define TEST_ATTEMPTS  3000
+#define TEST_INTERNED  1000
+
+/// Per-node state dag_add_edge may touch.
+typedef struct {
+    size_t ord;
+    size_t in_count;
+    size_t out_count;
+    bool   mark;
+} TestNodeState;
+
+static void test_save(DAGNode **nodes, size_t count, TestNodeState *saved) {
+    for (size_t i = 0; i < count; i++) {
+        saved[i] = (TestNodeState){ nodes[i]->ord, nodes[i]->in_count,
+                                    nodes[i]->out_count, nodes[i]->mark };
+    }
+}
+
+static bool test_unchanged(DAGNode **nodes, size_t count, const TestNodeState *saved) {
+    for (size_t i = 0; i < count; i++) {
+        if (nodes[i]->ord != saved[i].ord || nodes[i]->in_count != saved[i].in_count ||
+            nodes[i]->out_count != saved[i].out_count || nodes[i]->mark != saved[i].mark) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Every edge runs forward in the order, seen from either end.
+static bool test_order_valid(DAGNode **nodes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const DAGNode *node = nodes[i];
+        for (size_t k = 0; k < node->out_count; k++) {
+            if (node->ord >= node->out_edges[k].target->ord) return false;
+        }
+        for (size_t k = 0; k < node->in_count; k++) {
+            if (node->in_edges[k].target->ord >= node->ord) return false;
+        }
+    }
+    return true;
+}
+
+/// Does `from` reach `to` along out-edges? (Oracle, ignores the order.)
+static bool test_reaches(DAGNode **nodes, size_t count, DAGNode *from, DAGNode *to) {
+    DAGNode **stack = (DAGNode **)malloc(count * sizeof(DAGNode *));
+    bool *seen = (bool *)calloc(count, sizeof(bool));
+    bool found = false;
+    if (!stack || !seen) {
+        free(stack);
+        free(seen);
+        return false;
+    }
+
+    size_t depth = 0;
+    seen[from->id - nodes[0]->id] = true;
+    stack[depth++] = from;
+    while (depth > 0 && !found) {
+        DAGNode *node = stack[--depth];
+        if (node == to) {
+            found = true;
+            break;
+        }
+        for (size_t k = 0; k < node->out_count; k++) {
+            DAGNode *next = node->out_edges[k].target;
+            size_t index = next->id - nodes[0]->id;
+            if (!seen[index]) {
+                seen[index] = true;
+                stack[depth++] = next;
+            }
+        }
+    }
+
+    free(stack);
+    free(seen);
+    return found;
+}
+
+static int compare_size(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void test_small_cycles(void) {
+    DAGNode *nodes[3];
+    for (int i = 0; i < 3; i++) nodes[i] = dag_node_create(TOKEN_IDENT, NOUN_SUBJECT);
+    CHECK(nodes[0] && nodes[1] && nodes[2]);
+    if (!nodes[0] || !nodes[1] || !nodes[2]) return;
+
+    // Against the creation order but acyclic: c -> b -> a
+    CHECK(dag_add_edge(nodes[2], nodes[1], 1.0f) == DAG_OK);
+    CHECK(dag_add_edge(nodes[1], nodes[0], 1.0f) == DAG_OK);
+    CHECK(nodes[2]->ord < nodes[1]->ord && nodes[1]->ord < nodes[0]->ord);
+
+    TestNodeState saved[3];
+    test_save(nodes, 3, saved);
+    CHECK(dag_add_edge(nodes[0], nodes[2], 1.0f) == DAG_ERR_CYCLE);
+    CHECK(dag_add_edge(nodes[0], nodes[1], 1.0f) == DAG_ERR_CYCLE);
+    CHECK(dag_add_edge(nodes[1], nodes[1], 1.0f) == DAG_ERR_CYCLE);
+    CHECK(test_unchanged(nodes, 3, saved));
+
+    CHECK(dag_add_edge(NULL, nodes[0], 1.0f) == DAG_ERR_INVALID);
+    CHECK(dag_add_edge(nodes[0], NULL, 1.0f) == DAG_ERR_INVALID);
+
+    // Still resolvable: the root is true and so is the chain
+    dag_resolve(nodes, 3);
+    CHECK(nodes[0]->state == STATE_TRUE && nodes[2]->state == STATE_TRUE);
+
+    for (int i = 0; i < 3; i++) dag_node_destroy(nodes[i]);
+}
+
+static void test_random_edges(void) {
+    DAGNode *nodes[TEST_NODES];
+    size_t initial_ords[TEST_NODES];
+    size_t created = 0;
+    for (; created < TEST_NODES; created++) {
+        nodes[created] = dag_node_create(TOKEN_IDENT, NOUN_SUBJECT);
+        if (!nodes[created]) break;
+        initial_ords[created] = nodes[created]->ord;
+    }
+    CHECK(created == TEST_NODES);
+    if (created != TEST_NODES) goto done;
+
+    TestNodeState saved[TEST_NODES];
+    uint64_t seed = 0x2545f4914f6cdd1dull;
+    size_t accepted = 0, rejected = 0;
+
+    for (int attempt = 0; attempt < TEST_ATTEMPTS; attempt++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        DAGNode *from = nodes[seed % TEST_NODES];
+        DAGNode *to = nodes[(seed >> 32) % TEST_NODES];
+
+        bool closes_cycle = from == to || test_reaches(nodes, TEST_NODES, to, from);
+        test_save(nodes, TEST_NODES, saved);
+        int status = dag_add_edge(from, to, 1.0f);
+
+        if (closes_cycle) {
+            CHECK(status == DAG_ERR_CYCLE);
+            CHECK(test_unchanged(nodes, TEST_NODES, saved));
+            rejected++;
+        } else {
+            CHECK(status == DAG_OK);
+            accepted++;
+        }
+        CHECK(test_order_valid(nodes, TEST_NODES));
+    }
+    CHECK(accepted > 0 && rejected > 0);
+
+    // Reordering only permutes the ord values the nodes started with
+    size_t final_ords[TEST_NODES];
+    for (size_t i = 0; i < TEST_NODES; i++) final_ords[i] = nodes[i]->ord;
+    qsort(final_ords, TEST_NODES, sizeof(size_t), compare_size);
+    CHECK(memcmp(final_ords, initial_ords, sizeof(final_ords)) == 0);
+
+done:
+    for (size_t i = 0; i < created; i++) dag_node_destroy(nodes[i]);
+}
+
+static void test_interning(void) {
+    DAGConsTable *table = dag_cons_create();
+    DAGNode *sources[2] = { dag_node_create(TOKEN_IDENT, NOUN_SUBJECT),
+                            dag_node_create(TOKEN_IDENT, NOUN_SUBJECT) };
+    CHECK(table && sources[0] && sources[1]);
+    if (!table || !sources[0] || !sources[1]) goto done;
+
+    // Enough distinct nodes to grow the table several times, each asked
+    // for twice with its edges in either order
+    DAGNode *interned[TEST_INTERNED];
+    for (int i = 0; i < TEST_INTERNED; i++) {
+        DAGEdge edges[2] = { { sources[0], (float)i }, { sources[1], 1.0f } };
+        DAGEdge swapped[2] = { edges[1], edges[0] };
+        interned[i] = dag_node_intern(table, TOKEN_PLUS, NOUN_SUBJECT, edges, 2);
+        CHECK(interned[i] != NULL);
+        CHECK(dag_node_intern(table, TOKEN_PLUS, NOUN_SUBJECT, swapped, 2) == interned[i]);
+    }
+
+    DAGConsStats stats = dag_cons_stats(table);
+    CHECK(stats.created == TEST_INTERNED);
+    CHECK(stats.shared == TEST_INTERNED);
+    for (int i = 0; i < TEST_INTERNED; i++) {
+        DAGEdge edges[2] = { { sources[0], (float)i }, { sources[1], 1.0f } };
+        CHECK(dag_node_intern(table, TOKEN_PLUS, NOUN_SUBJECT, edges, 2) == interned[i]);
+    }
+
+    for (int i = 0; i < TEST_INTERNED; i++) dag_node_destroy(interned[i]);
+
+done:
+    dag_cons_destroy(table);
+    dag_node_destroy(sources[0]);
+    dag_node_destroy(sources[1]);
+}
+
+int main(void) {
+    dag_init();
+    test_small_cycles();
+    test_random_edges();
+    test_interning();
+    return TEST_RESULT();
+}
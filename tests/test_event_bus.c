@@ -0,0 +1,193 @@
+// tests/test_event_bus.c
+// Per-type sampling policies: every-nth, rate limiting and coalescing,
+// single-threaded for exact counts and under concurrent publishers.
+#include <axl/core/runtime/event_bus.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "test_util.h"
+
+#define TEST_LONG_INTERVAL_MS  60000   // No window or flush boundary during a test
+#define TEST_PUBLISHERS        4
+#define TEST_PER_THREAD        5000
+
+/// What subscribers received.
+typedef struct {
+    atomic_uint_fast64_t events;
+    atomic_uint_fast64_t aggregates;
+    atomic_uint_fast64_t aggregated;       // Sum of aggregate counts
+    atomic_uint_fast64_t aggregated_bytes;
+} TestCounts;
+
+static void test_count_event(const Event *event, void *user_data) {
+    TestCounts *counts = (TestCounts *)user_data;
+    (void)event;
+    atomic_fetch_add(&counts->events, 1);
+}
+
+static void test_count_aggregate(const Event *event, void *user_data) {
+    TestCounts *counts = (TestCounts *)user_data;
+    const EventAggregate *aggregate = (const EventAggregate *)event->data;
+    if (event->data_size != sizeof(EventAggregate) || aggregate->type != EVENT_TRIE_MATCH) return;
+
+    atomic_fetch_add(&counts->aggregates, 1);
+    atomic_fetch_add(&counts->aggregated, aggregate->count);
+    atomic_fetch_add(&counts->aggregated_bytes, aggregate->data_size);
+}
+
+static void test_reset(TestCounts *counts) {
+    atomic_store(&counts->events, 0);
+    atomic_store(&counts->aggregates, 0);
+    atomic_store(&counts->aggregated, 0);
+    atomic_store(&counts->aggregated_bytes, 0);
+}
+
+static void test_publish(size_t count, size_t data_size) {
+    for (size_t i = 0; i < count; i++) {
+        Event event = { .type = EVENT_TRIE_MATCH, .data_size = data_size };
+        event_bus_publish(&event);
+    }
+}
+
+static void test_policies(TestCounts *counts) {
+    // Every event by default
+    test_reset(counts);
+    test_publish(10, 0);
+    CHECK(atomic_load(&counts->events) == 10);
+
+    // One in four: the 1st, 5th and 9th
+    EventPolicy every = { .mode = EVENT_SAMPLE_EVERY_NTH, .every = 4 };
+    uint64_t suppressed = event_bus_suppressed(EVENT_TRIE_MATCH);
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, &every));
+    test_reset(counts);
+    test_publish(10, 0);
+    CHECK(atomic_load(&counts->events) == 3);
+    CHECK(event_bus_suppressed(EVENT_TRIE_MATCH) - suppressed == 7);
+
+    // At most five in one window
+    EventPolicy rate = { .mode = EVENT_SAMPLE_RATE_LIMIT, .limit = 5,
+                         .interval_ms = TEST_LONG_INTERVAL_MS };
+    suppressed = event_bus_suppressed(EVENT_TRIE_MATCH);
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, &rate));
+    test_reset(counts);
+    test_publish(20, 0);
+    CHECK(atomic_load(&counts->events) == 5);
+    CHECK(event_bus_suppressed(EVENT_TRIE_MATCH) - suppressed == 15);
+
+    // Coalesced into one aggregate on flush, none delivered as is
+    EventPolicy coalesce = { .mode = EVENT_SAMPLE_COALESCE, .interval_ms = TEST_LONG_INTERVAL_MS };
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, &coalesce));
+    test_reset(counts);
+    test_publish(7, 3);
+    CHECK(atomic_load(&counts->events) == 0);
+    CHECK(atomic_load(&counts->aggregates) == 0);
+    event_bus_flush();
+    CHECK(atomic_load(&counts->aggregates) == 1);
+    CHECK(atomic_load(&counts->aggregated) == 7);
+    CHECK(atomic_load(&counts->aggregated_bytes) == 21);
+
+    // Nothing pending: no empty aggregate
+    event_bus_flush();
+    CHECK(atomic_load(&counts->aggregates) == 1);
+
+    // Leaving COALESCE delivers what it held
+    test_reset(counts);
+    test_publish(2, 1);
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, NULL));
+    CHECK(atomic_load(&counts->aggregates) == 1);
+    CHECK(atomic_load(&counts->aggregated) == 2);
+    test_publish(1, 0);
+    CHECK(atomic_load(&counts->events) == 1);
+
+    // Other types are unaffected by a type's policy
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, &every));
+    test_reset(counts);
+    Event other = { .type = EVENT_CACHE_HIT };
+    for (int i = 0; i < 5; i++) event_bus_publish(&other);
+    CHECK(atomic_load(&counts->events) == 5);
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, NULL));
+}
+
+static void test_invalid_policies(void) {
+    EventPolicy zero_every = { .mode = EVENT_SAMPLE_EVERY_NTH, .every = 0 };
+    EventPolicy zero_interval = { .mode = EVENT_SAMPLE_COALESCE, .interval_ms = 0 };
+    EventPolicy every = { .mode = EVENT_SAMPLE_EVERY_NTH, .every = 2 };
+
+    CHECK(!event_bus_set_policy(EVENT_TRIE_MATCH, &zero_every));
+    CHECK(!event_bus_set_policy(EVENT_TRIE_MATCH, &zero_interval));
+    CHECK(!event_bus_set_policy(EVENT_AGGREGATE, &every));
+    CHECK(!event_bus_set_policy(EVENT_TYPE_COUNT, NULL));
+}
+
+/* ---------------------------------------------------------------------------
+ * Concurrent publishers
+ * ------------------------------------------------------------------------- */
+
+static void* test_publisher(void *arg) {
+    (void)arg;
+    test_publish(TEST_PER_THREAD, 2);
+    return NULL;
+}
+
+static size_t test_run_publishers(void) {
+    pthread_t threads[TEST_PUBLISHERS];
+    size_t started = 0;
+    for (; started < TEST_PUBLISHERS; started++) {
+        if (pthread_create(&threads[started], NULL, test_publisher, NULL) != 0) break;
+    }
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return started * TEST_PER_THREAD;
+}
+
+static void test_concurrent(TestCounts *counts) {
+    // Short intervals, so publishers race to emit aggregates; none may
+    // lose or double-count an event
+    EventPolicy coalesce = { .mode = EVENT_SAMPLE_COALESCE, .interval_ms = 1 };
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, &coalesce));
+    test_reset(counts);
+    size_t published = test_run_publishers();
+    event_bus_flush();
+    CHECK(published > 0);
+    CHECK(atomic_load(&counts->events) == 0);
+    CHECK(atomic_load(&counts->aggregated) == published);
+    CHECK(atomic_load(&counts->aggregated_bytes) == published * 2);
+
+    // Every-nth keeps one shared counter: exactly ceil(n / every) pass
+    EventPolicy every = { .mode = EVENT_SAMPLE_EVERY_NTH, .every = 3 };
+    uint64_t suppressed = event_bus_suppressed(EVENT_TRIE_MATCH);
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, &every));
+    test_reset(counts);
+    published = test_run_publishers();
+    CHECK(atomic_load(&counts->events) == (published + 2) / 3);
+    CHECK(atomic_load(&counts->events) + (event_bus_suppressed(EVENT_TRIE_MATCH) - suppressed) == published);
+
+    CHECK(event_bus_set_policy(EVENT_TRIE_MATCH, NULL));
+}
+
+int main(void) {
+    CHECK(event_bus_init());
+
+    TestCounts counts;
+    test_reset(&counts);
+    EventType plain[] = { EVENT_TRIE_MATCH, EVENT_CACHE_HIT };
+    EventType aggregated[] = { EVENT_AGGREGATE };
+    int plain_id = event_bus_subscribe(test_count_event, &counts, plain, 2);
+    int aggregate_id = event_bus_subscribe(test_count_aggregate, &counts, aggregated, 1);
+    CHECK(plain_id > 0 && aggregate_id > 0);
+
+    test_policies(&counts);
+    test_invalid_policies();
+    test_concurrent(&counts);
+
+    // Unsubscribed handlers see nothing more
+    event_bus_unsubscribe(plain_id);
+    test_reset(&counts);
+    test_publish(3, 0);
+    CHECK(atomic_load(&counts.events) == 0);
+
+    event_bus_unsubscribe(aggregate_id);
+    event_bus_cleanup();
+    return TEST_RESULT();
+}
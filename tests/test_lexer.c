@@ -0,0 +1,171 @@
+// tests/test_lexer.c
+// Parallel lexing against serial lexing: chunk boundaries fall inside
+// strings, block comments and escaped newlines, and both must give the
+// same tokens and the same first error. A large parse lexed ahead on
+// several threads must build the same DAG as a serial one.
+#include <axl/core/integration/semantic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+#define TEST_ROUNDS        300
+#define TEST_PIECES        400
+#define TEST_MAX_THREADS   16
+#define TEST_PARSE_THREADS 4
+
+typedef struct {
+    const char *text;
+    size_t      length;        // Pieces may hold NUL
+} TestPiece;
+
+#define PIECE(s) { s, sizeof(s) - 1 }
+
+/// Source fragments; most span lines inside a string or comment.
+static const TestPiece test_pieces[] = {
+    PIECE("let a = 1;\n"), PIECE("b is c + 2.5;\n"), PIECE("x has y - z;\n"),
+    PIECE("const k = (a + b);\n"), PIECE("\n"), PIECE("\n\n"), PIECE("  "),
+    PIECE("s = \"one line\";\n"),
+    PIECE("s = \"two\nlines\";\n"),
+    PIECE("s = \"escaped \\\nnewline\";\n"),
+    PIECE("s = \"quote \\\" and\nmore\";\n"),
+    PIECE("s = \"/* not\n a comment */\";\n"),
+    PIECE("s = \"// not\n a comment\";\n"),
+    PIECE("/* block\n comment */\n"), PIECE("/*\n\n\n*/"),
+    PIECE("/* \"not\n a string */\n"), PIECE("/**/"), PIECE("/*/ still\n open */\n"),
+    PIECE("// line \"comment /*\n"),
+    PIECE("t = \"\\\\\";\n"), PIECE("t = \"\\\\\n\";\n"),
+};
+
+/// Rarely added; each makes lexing stop somewhere.
+static const TestPiece test_errors[] = {
+    PIECE("@\n"), PIECE("\"never closed\n"), PIECE("/* never closed\n"),
+    PIECE("s = \"nul \\\0 escape\";\n"), PIECE("'\n"),
+};
+
+#define TEST_COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+static uint64_t test_rng = 0x853c49e6748fea9bull;
+
+static uint64_t test_xorshift(void) {
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 7;
+    test_rng ^= test_rng << 17;
+    return test_rng;
+}
+
+static size_t test_append(char *buf, size_t size, const TestPiece *piece) {
+    memcpy(buf + size, piece->text, piece->length);
+    return size + piece->length;
+}
+
+static void test_same_tokens(const AxlSemanticTokens *serial, const AxlSemanticTokens *parallel) {
+    CHECK(serial->count == parallel->count);
+    CHECK(serial->failed == parallel->failed);
+    for (size_t i = 0; i < serial->count && i < parallel->count; i++) {
+        const AxlSemanticToken *a = &serial->tokens[i], *b = &parallel->tokens[i];
+        if (a->offset != b->offset || a->length != b->length || a->type != b->type ||
+            a->category != b->category || a->weight != b->weight) {
+            CHECK(!"token differs");
+            fprintf(stderr, "  token %zu: serial %zu+%zu, parallel %zu+%zu\n",
+                    i, a->offset, a->length, b->offset, b->length);
+            break;
+        }
+    }
+    if (serial->failed && parallel->failed) {
+        CHECK(serial->error.offset == parallel->error.offset);
+        CHECK(strcmp(serial->error.message, parallel->error.message) == 0);
+    }
+}
+
+static void test_boundaries(void) {
+    size_t longest = 0;
+    for (size_t i = 0; i < TEST_COUNT(test_pieces); i++) {
+        if (test_pieces[i].length > longest) longest = test_pieces[i].length;
+    }
+    for (size_t i = 0; i < TEST_COUNT(test_errors); i++) {
+        if (test_errors[i].length > longest) longest = test_errors[i].length;
+    }
+
+    char *buf = (char *)malloc(TEST_PIECES * longest);
+    CHECK(buf != NULL);
+    if (!buf) return;
+
+    for (int round = 0; round < TEST_ROUNDS; round++) {
+        size_t size = 0;
+        size_t pieces = 1 + test_xorshift() % TEST_PIECES;
+        for (size_t p = 0; p < pieces; p++) {
+            // About one source in four has an error somewhere
+            if (test_xorshift() % (4 * pieces) == 0) {
+                size = test_append(buf, size, &test_errors[test_xorshift() % TEST_COUNT(test_errors)]);
+            } else {
+                size = test_append(buf, size, &test_pieces[test_xorshift() % TEST_COUNT(test_pieces)]);
+            }
+        }
+
+        AxlSemanticTokens serial;
+        CHECK(axl_semantic_lex(buf, size, 1, &serial));
+
+        for (size_t threads = 2; threads <= TEST_MAX_THREADS; threads++) {
+            AxlSemanticTokens parallel;
+            CHECK(axl_semantic_lex(buf, size, threads, &parallel));
+            test_same_tokens(&serial, &parallel);
+            axl_semantic_tokens_free(&parallel);
+        }
+        axl_semantic_tokens_free(&serial);
+    }
+
+    free(buf);
+}
+
+/// Build `data` with lexing on `threads` threads.
+static bool test_build(const char *data, size_t size, size_t threads,
+                       AxlSemanticDag *dag, AxlSemanticError *error) {
+    axl_semantic_set_lex_threads(threads);
+    CHECK(axl_semantic_lex_threads(size) == threads);
+    return axl_semantic_build(data, size, NULL, dag, error);
+}
+
+static void test_parse(void) {
+    // Enough statements for TEST_PARSE_THREADS chunks of the minimum size
+    static const char statement[] =
+        "let v = w + \"multi\nline \\\n string\" - 1; // note\n/* block\n comment */\n";
+    size_t count = TEST_PARSE_THREADS * AXL_SEMANTIC_LEX_CHUNK / (sizeof(statement) - 1) + 1;
+    size_t size = count * (sizeof(statement) - 1);
+
+    char *buf = (char *)malloc(size + 2);
+    CHECK(buf != NULL);
+    if (!buf) return;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(buf + i * (sizeof(statement) - 1), statement, sizeof(statement) - 1);
+    }
+
+    AxlSemanticDag serial, parallel;
+    AxlSemanticError error;
+    CHECK(test_build(buf, size, 1, &serial, &error));
+    CHECK(test_build(buf, size, TEST_PARSE_THREADS, &parallel, &error));
+    CHECK(serial.node_count == parallel.node_count);
+    CHECK(serial.edge_count == parallel.edge_count);
+    CHECK(serial.statements == parallel.statements && serial.statements == count);
+    axl_semantic_destroy(&serial);
+    axl_semantic_destroy(&parallel);
+
+    // A lexical error at the very end is reported at the same place
+    buf[size] = '@';
+    buf[size + 1] = '\n';
+    AxlSemanticError serial_error, parallel_error;
+    CHECK(!test_build(buf, size + 2, 1, &serial, &serial_error));
+    CHECK(!test_build(buf, size + 2, TEST_PARSE_THREADS, &parallel, &parallel_error));
+    CHECK(serial_error.offset == parallel_error.offset && serial_error.offset == size);
+    CHECK(strcmp(serial_error.message, parallel_error.message) == 0);
+
+    axl_semantic_set_lex_threads(0);
+    free(buf);
+}
+
+int main(void) {
+    test_boundaries();
+    test_parse();
+    return TEST_RESULT();
+}
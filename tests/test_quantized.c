@@ -0,0 +1,151 @@
+// tests/test_quantized.c
+// The quantized resolve kernels must agree exactly with each other, and
+// with dag_csr_resolve wherever quantization cannot change a sum.
+#include <axl/core/dag.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/dag/quantized.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+// In-degrees around the packed-word (16) and SIMD block boundaries
+static const size_t test_degrees[] = { 0, 1, 2, 7, 15, 16, 17, 31, 32, 33, 48, 64, 65, 100 };
+
+#define TEST_DEGREE_COUNT (sizeof(test_degrees) / sizeof(test_degrees[0]))
+
+static uint64_t test_random(uint64_t *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+/// Freeze a DAG of `n` nodes; node i takes in-edges from a run of
+/// earlier nodes. Unit weights are +-1, which quantize exactly; other
+/// weights are arbitrary. With `shuffle`, ids are not topological.
+static DAGCsr* test_csr(size_t n, bool unit_weights, bool shuffle, uint64_t seed) {
+    DAGNode **nodes = (DAGNode **)calloc(n, sizeof(DAGNode *));
+    if (!nodes) return NULL;
+
+    DAGCsr *csr = NULL;
+    size_t created = 0;
+    for (; created < n; created++) {
+        nodes[created] = dag_node_create(TOKEN_IDENT, NOUN_SUBJECT);
+        if (!nodes[created]) goto done;
+
+        size_t i = created;
+        size_t degree = test_degrees[test_random(&seed) % TEST_DEGREE_COUNT];
+        if (degree > i) degree = i;
+
+        size_t start = i ? test_random(&seed) % i : 0;
+        for (size_t k = 0; k < degree; k++) {
+            float weight;
+            if (unit_weights) {
+                weight = test_random(&seed) % 2 ? 1.0f : -1.0f;
+            } else {
+                weight = (float)((int)(test_random(&seed) % 4001) - 2000) / 1000.0f;
+            }
+            if (dag_add_edge(nodes[(start + k) % i], nodes[i], weight) != DAG_OK) goto done;
+        }
+    }
+
+    if (shuffle) {
+        for (size_t i = n - 1; i > 0; i--) {
+            size_t j = test_random(&seed) % (i + 1);
+            DAGNode *t = nodes[i];
+            nodes[i] = nodes[j];
+            nodes[j] = t;
+        }
+    }
+    csr = dag_freeze(nodes, n);
+
+done:
+    for (size_t i = 0; i < created; i++) {
+        dag_node_destroy(nodes[i]);
+    }
+    free(nodes);
+    return csr;
+}
+
+static const struct {
+    DAGQuantKernel kernel;
+    const char    *name;
+} test_kernels[] = {
+    { DAG_QUANT_KERNEL_SCALAR, "scalar" },
+    { DAG_QUANT_KERNEL_SSE2,   "sse2" },
+    { DAG_QUANT_KERNEL_AVX2,   "avx2" },
+};
+
+#define TEST_KERNEL_COUNT (sizeof(test_kernels) / sizeof(test_kernels[0]))
+
+/// Resolve `csr` with every supported kernel; the scalar kernel is the
+/// reference, and with unit weights so is dag_csr_resolve.
+static void test_kernels_agree(size_t n, bool unit_weights, bool shuffle, uint64_t seed) {
+    DAGCsr *csr = test_csr(n, unit_weights, shuffle, seed);
+    CHECK(csr != NULL);
+    if (!csr) return;
+
+    DAGQuantized *quantized = dag_quantize(csr);
+    uint8_t *reference = (uint8_t *)malloc(n);
+    CHECK(quantized != NULL && reference != NULL);
+    if (!quantized || !reference) {
+        free(reference);
+        dag_quantized_destroy(quantized);
+        dag_csr_destroy(csr);
+        return;
+    }
+
+    for (size_t k = 0; k < TEST_KERNEL_COUNT; k++) {
+        if (!dag_quantized_use_kernel(test_kernels[k].kernel)) continue;
+        CHECK(strcmp(dag_quantized_kernel_name(), test_kernels[k].name) == 0);
+        CHECK(dag_quantized_resolve(quantized) == 0);
+
+        if (test_kernels[k].kernel == DAG_QUANT_KERNEL_SCALAR) {
+            memcpy(reference, quantized->states, n);
+        } else if (memcmp(reference, quantized->states, n) != 0) {
+            fprintf(stderr, "  %s kernel disagrees with scalar (n=%zu, seed=%llu)\n",
+                    test_kernels[k].name, n, (unsigned long long)seed);
+            CHECK(!"kernel states match scalar");
+        }
+    }
+
+    if (unit_weights) {
+        CHECK(dag_csr_resolve(csr) == 0);
+        CHECK(memcmp(reference, csr->states, n) == 0);
+    }
+
+    // Every state is one of the three truth values, and roots are true
+    for (uint32_t v = 0; v < csr->node_count; v++) {
+        CHECK(reference[v] <= STATE_FALSE);
+        if (csr->in_offsets[v] == csr->in_offsets[v + 1]) CHECK(reference[v] == STATE_TRUE);
+    }
+
+    free(reference);
+    dag_quantized_destroy(quantized);
+    dag_csr_destroy(csr);
+}
+
+int main(void) {
+    dag_init();
+
+    for (size_t k = 0; k < TEST_KERNEL_COUNT; k++) {
+        if (!dag_quantized_use_kernel(test_kernels[k].kernel)) {
+            printf("%s kernel not supported here, skipped\n", test_kernels[k].name);
+        }
+    }
+
+    for (uint64_t seed = 1; seed <= 8; seed++) {
+        size_t n = 64 + (size_t)seed * 97;
+        test_kernels_agree(n, true, false, seed);
+        test_kernels_agree(n, true, true, seed);
+        test_kernels_agree(n, false, false, seed);
+        test_kernels_agree(n, false, true, seed);
+    }
+
+    // One node, and a DAG large enough for many full SIMD blocks
+    test_kernels_agree(1, true, false, 99);
+    test_kernels_agree(20000, false, true, 100);
+
+    dag_quantized_use_kernel(DAG_QUANT_KERNEL_AUTO);
+    return TEST_RESULT();
+}
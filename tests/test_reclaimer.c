@@ -0,0 +1,203 @@
+// tests/test_reclaimer.c
+// The background reclaimer frees deferred objects only after their
+// grace period, flush waits for all of them, and destroy drains the rest.
+#include <axl/core/runtime/epoch.h>
+#include <axl/core/runtime/reclaimer.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "test_util.h"
+
+#define TEST_MAGIC      0x5eedf00du
+#define TEST_PRODUCERS  4
+#define TEST_PER_THREAD 2000
+
+static atomic_size_t test_freed;
+
+static uint32_t* test_object(void) {
+    uint32_t *object = (uint32_t *)malloc(sizeof(uint32_t));
+    if (object) *object = TEST_MAGIC;
+    return object;
+}
+
+static void test_free(void *ptr) {
+    free(ptr);
+    atomic_fetch_add(&test_freed, 1);
+}
+
+static void test_sleep_ms(long ms) {
+    struct timespec delay = { 0, ms * 1000000L };
+    nanosleep(&delay, NULL);
+}
+
+static void test_flush(void) {
+    Reclaimer *reclaimer = reclaimer_create(4);
+    CHECK(reclaimer != NULL);
+    if (!reclaimer) return;
+
+    atomic_store(&test_freed, 0);
+    for (int i = 0; i < 100; i++) {
+        uint32_t *object = test_object();
+        CHECK(object != NULL);
+        if (object) CHECK(reclaimer_defer(reclaimer, object, test_free));
+    }
+
+    reclaimer_flush(reclaimer);
+    CHECK(atomic_load(&test_freed) == 100);
+    CHECK(reclaimer_pending(reclaimer) == 0);
+
+    // Flushing with nothing pending returns at once
+    reclaimer_flush(reclaimer);
+    CHECK(reclaimer_defer(reclaimer, NULL, NULL) == false);
+    CHECK(reclaimer_pending(reclaimer) == 0);
+
+    reclaimer_destroy(reclaimer);
+}
+
+static void test_grace_period(void) {
+    Reclaimer *reclaimer = reclaimer_create(4);
+    CHECK(reclaimer != NULL);
+    if (!reclaimer) return;
+
+    EpochDomain *domain = reclaimer_domain(reclaimer);
+    int slot = epoch_register(domain);
+    CHECK(slot >= 0);
+
+    // A reader that could have seen the object keeps it alive
+    atomic_store(&test_freed, 0);
+    uint32_t *object = test_object();
+    CHECK(object != NULL);
+    if (!object) return;
+
+    epoch_enter(domain, slot);
+    CHECK(reclaimer_defer(reclaimer, object, test_free));
+    test_sleep_ms(20);
+    CHECK(atomic_load(&test_freed) == 0);
+    CHECK(reclaimer_pending(reclaimer) == 1);
+    CHECK(*object == TEST_MAGIC);
+    epoch_exit(domain, slot);
+
+    reclaimer_flush(reclaimer);
+    CHECK(atomic_load(&test_freed) == 1);
+
+    epoch_unregister(domain, slot);
+    reclaimer_destroy(reclaimer);
+}
+
+static void test_destroy_drains(void) {
+    Reclaimer *reclaimer = reclaimer_create(4);
+    CHECK(reclaimer != NULL);
+    if (!reclaimer) return;
+
+    EpochDomain *domain = reclaimer_domain(reclaimer);
+    int slot = epoch_register(domain);
+    CHECK(slot >= 0);
+
+    // Held back by the reader until it leaves, then left for destroy
+    atomic_store(&test_freed, 0);
+    epoch_enter(domain, slot);
+    for (int i = 0; i < 50; i++) {
+        uint32_t *object = test_object();
+        if (object) CHECK(reclaimer_defer(reclaimer, object, test_free));
+    }
+    epoch_exit(domain, slot);
+    epoch_unregister(domain, slot);
+
+    reclaimer_destroy(reclaimer);
+    CHECK(atomic_load(&test_freed) == 50);
+}
+
+/* ---------------------------------------------------------------------------
+ * Concurrent producers and readers
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    Reclaimer   *reclaimer;
+    _Atomic(uint32_t *) *shared;   // Object readers may currently see
+    atomic_bool *stop;
+    size_t       bad;              // Objects read after being freed
+} TestWorker;
+
+/// Publish fresh objects and defer the ones they replace.
+static void* test_producer(void *arg) {
+    TestWorker *worker = (TestWorker *)arg;
+    for (int i = 0; i < TEST_PER_THREAD; i++) {
+        uint32_t *object = test_object();
+        if (!object) continue;
+
+        uint32_t *old = atomic_exchange(worker->shared, object);
+        if (old && !reclaimer_defer(worker->reclaimer, old, test_free)) {
+            worker->bad++;
+        }
+    }
+    return NULL;
+}
+
+static void* test_consumer(void *arg) {
+    TestWorker *worker = (TestWorker *)arg;
+    EpochDomain *domain = reclaimer_domain(worker->reclaimer);
+    int slot = epoch_register(domain);
+    if (slot < 0) return NULL;
+
+    while (!atomic_load(worker->stop)) {
+        epoch_enter(domain, slot);
+        uint32_t *object = atomic_load(worker->shared);
+        if (object && *object != TEST_MAGIC) worker->bad++;
+        epoch_exit(domain, slot);
+    }
+
+    epoch_unregister(domain, slot);
+    return NULL;
+}
+
+static void test_concurrent(void) {
+    Reclaimer *reclaimer = reclaimer_create(8);
+    CHECK(reclaimer != NULL);
+    if (!reclaimer) return;
+
+    atomic_store(&test_freed, 0);
+    _Atomic(uint32_t *) shared = test_object();
+    atomic_bool stop = false;
+
+    TestWorker consumer = { reclaimer, &shared, &stop, 0 };
+    TestWorker producers[TEST_PRODUCERS];
+    pthread_t consumer_thread;
+    pthread_t producer_threads[TEST_PRODUCERS];
+
+    bool consuming = pthread_create(&consumer_thread, NULL, test_consumer, &consumer) == 0;
+    size_t started = 0;
+    for (; started < TEST_PRODUCERS; started++) {
+        producers[started] = (TestWorker){ reclaimer, &shared, &stop, 0 };
+        if (pthread_create(&producer_threads[started], NULL, test_producer, &producers[started]) != 0) {
+            break;
+        }
+    }
+    CHECK(started > 0);
+
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(producer_threads[i], NULL);
+        CHECK(producers[i].bad == 0);
+    }
+
+    // Flush while the consumer is still reading
+    reclaimer_flush(reclaimer);
+    CHECK(atomic_load(&test_freed) == started * TEST_PER_THREAD);
+    CHECK(reclaimer_pending(reclaimer) == 0);
+
+    atomic_store(&stop, true);
+    if (consuming) pthread_join(consumer_thread, NULL);
+    CHECK(consumer.bad == 0);
+
+    free(atomic_load(&shared));
+    reclaimer_destroy(reclaimer);
+}
+
+int main(void) {
+    test_flush();
+    test_grace_period();
+    test_destroy_drains();
+    test_concurrent();
+    return TEST_RESULT();
+}
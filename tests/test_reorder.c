@@ -0,0 +1,223 @@
+// tests/test_reorder.c
+// Relabeling a frozen DAG must not change what it resolves to: under
+// RCM and topological order every node keeps its state under the id
+// permutation, cycles included, and a semantic DAG frozen in either
+// order resolves every identifier as the build order does.
+#include <axl/core/dag.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/integration/semantic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+#define TEST_ROUNDS      40
+#define TEST_MAX_NODES   400
+#define TEST_MAX_DEGREE  6
+#define TEST_CYCLES      3
+#define TEST_IDENTS      300
+#define TEST_STATEMENTS  600
+
+static uint64_t test_rng = 0xda942042e4dd58b5ull;
+
+static uint64_t test_xorshift(void) {
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 7;
+    test_rng ^= test_rng << 17;
+    return test_rng;
+}
+
+/// Freeze a random DAG of `n` nodes with weights that do not sum
+/// exactly in floats. With `cyclic`, a few in-edges are turned back on
+/// to a successor of their node, closing cycles dag_add_edge() would
+/// refuse; dag_freeze() reads in-edges only.
+static DAGCsr* test_csr(size_t n, bool cyclic) {
+    DAGNode **nodes = (DAGNode **)calloc(n, sizeof(DAGNode *));
+    if (!nodes) return NULL;
+
+    DAGCsr *csr = NULL;
+    size_t created = 0;
+    for (; created < n; created++) {
+        TaxonomyCategory category = test_xorshift() % 2 ? NOUN_SUBJECT : VERB_ACTION;
+        nodes[created] = dag_node_create(TOKEN_IDENT, category);
+        if (!nodes[created]) goto done;
+
+        size_t i = created;
+        size_t degree = i ? test_xorshift() % (TEST_MAX_DEGREE + 1) : 0;
+        for (size_t k = 0; k < degree; k++) {
+            float weight = (float)((int)(test_xorshift() % 2001) - 1000) / 300.0f;
+            if (dag_add_edge(nodes[test_xorshift() % i], nodes[i], weight) != DAG_OK) goto done;
+        }
+    }
+
+    for (size_t c = 0; cyclic && c < TEST_CYCLES; c++) {
+        for (size_t tries = 0; tries < n; tries++) {
+            DAGNode *node = nodes[test_xorshift() % n];
+            if (node->in_count > 0 && node->out_count > 0) {
+                node->in_edges[0].target = node->out_edges[0].target;
+                break;
+            }
+        }
+    }
+
+    // Ids off the topological order, so the resolve must not rely on it
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = test_xorshift() % (i + 1);
+        DAGNode *t = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = t;
+    }
+    csr = dag_freeze(nodes, n);
+
+done:
+    for (size_t i = 0; i < created; i++) {
+        dag_node_destroy(nodes[i]);
+    }
+    free(nodes);
+    return csr;
+}
+
+/// Node u of `reordered` is node order[u] of `csr`, with the same state.
+static void test_relabeled(const DAGCsr *csr, const DAGCsr *reordered, const uint32_t *order) {
+    CHECK(reordered->node_count == csr->node_count);
+    CHECK(reordered->edge_count == csr->edge_count);
+
+    uint32_t mismatches = 0;
+    for (uint32_t u = 0; u < csr->node_count; u++) {
+        uint32_t v = order[u];
+        if (reordered->states[u] != csr->states[v] || reordered->types[u] != csr->types[v] ||
+            reordered->categories[u] != csr->categories[v] ||
+            reordered->in_offsets[u + 1] - reordered->in_offsets[u] !=
+                csr->in_offsets[v + 1] - csr->in_offsets[v]) {
+            mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+static void test_order(const DAGCsr *csr, int resolved, DAGOrderKind kind, bool cyclic) {
+    uint32_t *order = dag_csr_locality_order(csr, kind);
+    if (kind == DAG_ORDER_TOPOLOGICAL && cyclic) {
+        CHECK(order == NULL);
+        free(order);
+        return;
+    }
+    CHECK(order != NULL);
+    if (!order) return;
+
+    DAGCsr *reordered = dag_csr_reorder(csr, order);
+    CHECK(reordered != NULL);
+    if (reordered) {
+        if (kind == DAG_ORDER_TOPOLOGICAL) CHECK(reordered->sorted);
+        CHECK(dag_csr_resolve(reordered) == resolved);
+        test_relabeled(csr, reordered, order);
+        dag_csr_destroy(reordered);
+    }
+
+    // Anything but a permutation is refused
+    if (csr->node_count > 1) {
+        order[0] = order[1];
+        CHECK(dag_csr_reorder(csr, order) == NULL);
+    }
+    free(order);
+}
+
+static void test_csr_orders(void) {
+    for (int round = 0; round < TEST_ROUNDS; round++) {
+        bool cyclic = round % 2 == 1;
+        size_t n = 2 + test_xorshift() % (TEST_MAX_NODES - 1);
+        DAGCsr *csr = test_csr(n, cyclic);
+        CHECK(csr != NULL);
+        if (!csr) continue;
+
+        int resolved = dag_csr_resolve(csr);
+        CHECK(resolved == (cyclic ? 1 : 0));
+
+        test_order(csr, resolved, DAG_ORDER_RCM, cyclic);
+        test_order(csr, resolved, DAG_ORDER_TOPOLOGICAL, cyclic);
+        dag_csr_destroy(csr);
+    }
+}
+
+/// Same state and degrees; most identifiers resolve true, so the
+/// degrees are what catch an id that was not remapped.
+static bool test_same_node(const DAGCsr *x, uint32_t a, const DAGCsr *y, uint32_t b) {
+    return x->states[a] == y->states[b] &&
+           x->in_offsets[a + 1] - x->in_offsets[a] == y->in_offsets[b + 1] - y->in_offsets[b] &&
+           x->out_offsets[a + 1] - x->out_offsets[a] == y->out_offsets[b + 1] - y->out_offsets[b];
+}
+
+/// Build and freeze `source` in `order`, resolved.
+static AxlFrozenDag* test_freeze(const char *source, size_t size, AxlFreezeOrder order) {
+    AxlSemanticDag dag;
+    AxlSemanticError error;
+    CHECK(axl_semantic_build(source, size, NULL, &dag, &error));
+
+    axl_semantic_set_freeze_order(order);
+    CHECK(axl_semantic_freeze_order() == order);
+    AxlFrozenDag *frozen = axl_semantic_freeze(&dag);
+    axl_semantic_destroy(&dag);
+    axl_semantic_set_freeze_order(AXL_FREEZE_ORDER_NONE);
+
+    CHECK(frozen != NULL);
+    if (frozen) {
+        CHECK(frozen->order == order);
+        CHECK(dag_csr_resolve(frozen->csr) == 0);
+    }
+    return frozen;
+}
+
+static void test_freeze_orders(void) {
+    static const char *verbs[] = { "=", "is", "has" };
+    char *source = (char *)malloc(TEST_STATEMENTS * 64);
+    CHECK(source != NULL);
+    if (!source) return;
+
+    // Each identifier defined from lower-numbered ones, so none is cyclic
+    size_t size = 0;
+    for (size_t s = 0; s < TEST_STATEMENTS; s++) {
+        size_t target = 1 + test_xorshift() % (TEST_IDENTS - 1);
+        size_t a = test_xorshift() % target, b = test_xorshift() % target;
+        size += (size_t)sprintf(source + size, "let v%zu %s v%zu %c v%zu - %d.5;\n",
+                                target, verbs[test_xorshift() % 3], a,
+                                test_xorshift() % 2 ? '+' : '-', b, (int)(test_xorshift() % 5));
+    }
+
+    AxlFrozenDag *built = test_freeze(source, size, AXL_FREEZE_ORDER_NONE);
+    AxlFrozenDag *topological = test_freeze(source, size, AXL_FREEZE_ORDER_TOPOLOGICAL);
+    AxlFrozenDag *rcm = test_freeze(source, size, AXL_FREEZE_ORDER_RCM);
+
+    if (built && topological && rcm) {
+        CHECK(topological->csr->sorted);
+        size_t found = 0, mismatches = 0;
+        for (size_t i = 0; i < TEST_IDENTS; i++) {
+            char name[16];
+            snprintf(name, sizeof(name), "v%zu", i);
+            uint32_t a, b, c;
+            bool in_built = axl_frozen_lookup(built, name, &a);
+            CHECK(axl_frozen_lookup(topological, name, &b) == in_built);
+            CHECK(axl_frozen_lookup(rcm, name, &c) == in_built);
+            if (!in_built) continue;
+
+            found++;
+            if (!test_same_node(built->csr, a, topological->csr, b) ||
+                !test_same_node(built->csr, a, rcm->csr, c)) {
+                mismatches++;
+            }
+        }
+        CHECK(found > 0);
+        CHECK(mismatches == 0);
+    }
+
+    axl_frozen_destroy(built);
+    axl_frozen_destroy(topological);
+    axl_frozen_destroy(rcm);
+    free(source);
+}
+
+int main(void) {
+    test_csr_orders();
+    test_freeze_orders();
+    return TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+// tests/test_scanner.c
+// The generated scanner against the interpreted one over the same
+// patterns.spec: both must pick the same longest match, and on equal
+// length the same (earlier) pattern, for any input.
+#include <axl/core/trie/scanner.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+#define TEST_RANDOM_INPUTS 20000
+#define TEST_RANDOM_LENGTH 12
+
+/// Inputs around the tie-break and longest-match edges of patterns.spec.
+static const char *test_inputs[] = {
+    "let", "letter", "let x", "const", "constant", "var", "var_1",
+    "is", "island", "has", "hasty", "ha",
+    "=", "==", "+", "-", "-1", "+=",
+    "1", "12", "1.5", "1.", "1.x", "12.34.56", "007a",
+    "\"\"", "\"abc\"", "\"a\\\"b\"", "\"a\\\\\"b", "\"open", "\"\\",
+    "\"a\\\nb\"", "\"line\none\"",
+    "_", "_a1", "a_b c", "n", "\\n", "\t", " let", "", ";", "(x)",
+};
+
+#define TEST_INPUT_COUNT (sizeof(test_inputs) / sizeof(test_inputs[0]))
+
+static uint64_t test_rng = 0x2545f4914f6cdd1dull;
+
+static uint64_t test_xorshift(void) {
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 7;
+    test_rng ^= test_rng << 17;
+    return test_rng;
+}
+
+/// Compare both scanners on text[0..len).
+static void test_compare(TrieNode *const *patterns, size_t count, const char *text, size_t len) {
+    TrieScanMatch generated = {0}, interpreted = {0};
+    bool found_generated = trie_scan_generated(text, len, &generated);
+    bool found_interpreted = trie_scan_interpreted(patterns, count, text, len, &interpreted);
+
+    CHECK(found_generated == found_interpreted);
+    if (!found_generated || !found_interpreted) return;
+
+    CHECK(generated.length == interpreted.length);
+    CHECK(generated.pattern == interpreted.pattern);
+    CHECK(generated.category == interpreted.category);
+    CHECK(generated.weight == interpreted.weight);
+    if (generated.length != interpreted.length || generated.pattern != interpreted.pattern) {
+        fprintf(stderr, "  '%.*s': generated %zu/%u, interpreted %zu/%u\n", (int)len, text,
+                generated.length, generated.pattern, interpreted.length, interpreted.pattern);
+    }
+}
+
+/// Expect the generated scanner to match `length` bytes of `text` with
+/// the pattern whose source is `pattern`.
+static void test_expect(const char *text, size_t length, const char *pattern) {
+    TrieScanMatch match = {0};
+    CHECK(trie_scan_generated(text, strlen(text), &match));
+    CHECK(match.length == length);
+    CHECK(match.pattern < trie_scan_pattern_count &&
+          strcmp(trie_scan_patterns[match.pattern].pattern, pattern) == 0);
+}
+
+static void test_fixed_inputs(TrieNode *const *patterns, size_t count) {
+    for (size_t i = 0; i < TEST_INPUT_COUNT; i++) {
+        const char *text = test_inputs[i];
+        size_t len = strlen(text);
+        // Every prefix, so each input also covers its cut-off forms
+        for (size_t n = 0; n <= len; n++) {
+            test_compare(patterns, count, text, n);
+        }
+    }
+
+    // Keywords tie with the identifier pattern and win by coming first;
+    // a longer identifier beats them
+    test_expect("let", 3, "let|const|var");
+    test_expect("is", 2, "is|has");
+    test_expect("letter", 6, "[A-Za-z_][A-Za-z0-9_]*");
+    test_expect("hasty", 5, "[A-Za-z_][A-Za-z0-9_]*");
+    test_expect("1.5", 3, "[0-9]+(\\.[0-9]+)?");
+    test_expect("1.x", 1, "[0-9]+(\\.[0-9]+)?");
+    test_expect("\"a\\\"b\"", 6, "\"([^\"\\\\]|\\\\.)*\"");
+    test_expect("\"a\\\nb\" x", 6, "\"([^\"\\\\]|\\\\.)*\"");
+}
+
+static void test_random_inputs(TrieNode *const *patterns, size_t count) {
+    static const char alphabet[] = "lethasicovr_x019.\"\\=+- \n";
+    char text[TEST_RANDOM_LENGTH];
+
+    for (size_t i = 0; i < TEST_RANDOM_INPUTS; i++) {
+        size_t len = 1 + test_xorshift() % TEST_RANDOM_LENGTH;
+        for (size_t j = 0; j < len; j++) {
+            text[j] = alphabet[test_xorshift() % (sizeof(alphabet) - 1)];
+        }
+        test_compare(patterns, count, text, len);
+    }
+}
+
+int main(void) {
+    size_t count = 0;
+    TrieNode **patterns = trie_load_pattern_file(AXL_PATTERN_SPEC, &count);
+    CHECK(patterns != NULL);
+    if (!patterns) return TEST_RESULT();
+
+    CHECK(count == trie_scan_pattern_count);
+    for (size_t i = 0; i < count && i < trie_scan_pattern_count; i++) {
+        CHECK(strcmp(patterns[i]->pattern_str, trie_scan_patterns[i].pattern) == 0);
+    }
+
+    test_fixed_inputs(patterns, count);
+    test_random_inputs(patterns, count);
+
+    for (size_t i = 0; i < count; i++) {
+        trie_destroy(patterns[i]);
+    }
+    free(patterns);
+    return TEST_RESULT();
+}
@@ -0,0 +1,296 @@
+// tests/test_snapshot.c
+// Copy-on-write snapshots: a pinned version never changes, untouched
+// pages stay shared, and concurrent readers only see whole versions.
+#include <axl/core/dag.h>
+#include <axl/core/dag/csr.h>
+#include <axl/core/dag/snapshot.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_util.h"
+
+// Groups of one root feeding three nodes; enough of them for several pages
+#define TEST_GROUP_SIZE    4
+#define TEST_GROUPS        700
+#define TEST_NODES         (TEST_GROUP_SIZE * TEST_GROUPS)
+#define TEST_READERS       3
+#define TEST_PUBLISHES     2000
+
+/// Frozen DAG of TEST_GROUPS independent groups: node g*4 is a root,
+/// and g*4+1..3 each take one weight-1 edge from it.
+static DAGCsr* test_groups_csr(void) {
+    DAGNode *nodes[TEST_NODES];
+    DAGCsr *csr = NULL;
+    size_t created = 0;
+
+    for (; created < TEST_NODES; created++) {
+        nodes[created] = dag_node_create(TOKEN_IDENT, NOUN_SUBJECT);
+        if (!nodes[created]) goto done;
+        if (created % TEST_GROUP_SIZE != 0 &&
+            dag_add_edge(nodes[created - created % TEST_GROUP_SIZE], nodes[created], 1.0f) != DAG_OK) {
+            created++;
+            goto done;
+        }
+    }
+    csr = dag_freeze(nodes, TEST_NODES);
+    if (csr && dag_csr_resolve(csr) != 0) {
+        dag_csr_destroy(csr);
+        csr = NULL;
+    }
+
+done:
+    for (size_t i = 0; i < created; i++) {
+        dag_node_destroy(nodes[i]);
+    }
+    return csr;
+}
+
+/// Group `g`'s root id. Ids follow creation order, which is topological.
+static uint32_t group_root(uint32_t g) {
+    return g * TEST_GROUP_SIZE;
+}
+
+/// Set group `g`'s root and re-resolve: its members follow it.
+static bool test_flip_group(DAGVersioned *versioned, DAGSnapshot *draft, uint32_t g, TruthValue state) {
+    return dag_snapshot_set_state(versioned, draft, group_root(g), state) &&
+           dag_snapshot_resolve(versioned, draft);
+}
+
+static void test_isolation(const DAGCsr *csr) {
+    DAGVersioned *versioned = dag_versioned_create(csr, 4);
+    CHECK(versioned != NULL);
+    if (!versioned) return;
+
+    int old_reader = dag_versioned_register_reader(versioned);
+    int new_reader = dag_versioned_register_reader(versioned);
+    CHECK(old_reader >= 0 && new_reader >= 0);
+
+    const DAGSnapshot *before = dag_snapshot_pin(versioned, old_reader);
+    CHECK(before->version == 1);
+    CHECK(before->node_count == TEST_NODES);
+    for (uint32_t v = 0; v < TEST_NODES; v++) {
+        CHECK(dag_snapshot_state(before, v) == STATE_TRUE);
+        CHECK(dag_snapshot_binding(before, v) == NULL);
+    }
+
+    // Turn group 1 (on page 0) false, except for one bound member
+    static const int binding = 0;
+    DAGSnapshot *draft = dag_snapshot_begin(versioned);
+    CHECK(draft != NULL);
+    CHECK(dag_snapshot_set_binding(versioned, draft, group_root(1) + 1, &binding));
+    CHECK(dag_snapshot_set_state(versioned, draft, group_root(1) + 1, STATE_TRUE));
+    CHECK(test_flip_group(versioned, draft, 1, STATE_FALSE));
+    dag_snapshot_publish(versioned, draft);
+
+    const DAGSnapshot *after = dag_snapshot_pin(versioned, new_reader);
+    CHECK(after->version > before->version);
+
+    // The old pin still sees version 1 in full
+    for (uint32_t v = 0; v < TEST_NODES; v++) {
+        CHECK(dag_snapshot_state(before, v) == STATE_TRUE);
+        CHECK(dag_snapshot_binding(before, v) == NULL);
+    }
+
+    // The new version: group 1 false except its bound member
+    CHECK(dag_snapshot_state(after, group_root(1)) == STATE_FALSE);
+    CHECK(dag_snapshot_state(after, group_root(1) + 1) == STATE_TRUE);
+    CHECK(dag_snapshot_binding(after, group_root(1) + 1) == &binding);
+    CHECK(dag_snapshot_state(after, group_root(1) + 2) == STATE_FALSE);
+    CHECK(dag_snapshot_state(after, group_root(1) + 3) == STATE_FALSE);
+    CHECK(dag_snapshot_state(after, group_root(2)) == STATE_TRUE);
+
+    // Only the page that changed was copied
+    CHECK(after->page_count == before->page_count && after->page_count > 1);
+    CHECK(after->pages[0] != before->pages[0]);
+    for (uint32_t p = 1; p < after->page_count; p++) {
+        CHECK(after->pages[p] == before->pages[p]);
+    }
+
+    dag_snapshot_unpin(versioned, old_reader);
+    dag_snapshot_unpin(versioned, new_reader);
+
+    // An aborted draft is never seen
+    draft = dag_snapshot_begin(versioned);
+    CHECK(draft != NULL);
+    CHECK(test_flip_group(versioned, draft, TEST_GROUPS - 1, STATE_FALSE));
+    dag_snapshot_abort(versioned, draft);
+
+    const DAGSnapshot *latest = dag_snapshot_pin(versioned, new_reader);
+    CHECK(latest->version == after->version);
+    CHECK(dag_snapshot_state(latest, group_root(TEST_GROUPS - 1)) == STATE_TRUE);
+    dag_snapshot_unpin(versioned, new_reader);
+
+    dag_versioned_unregister_reader(versioned, old_reader);
+    dag_versioned_unregister_reader(versioned, new_reader);
+    dag_versioned_destroy(versioned);
+}
+
+static void test_resolve_from(const DAGCsr *csr) {
+    DAGVersioned *versioned = dag_versioned_create(csr, 2);
+    CHECK(versioned != NULL);
+    if (!versioned) return;
+
+    // Bind a few roots and members, re-resolving only downstream of them
+    static const int binding = 0;
+    uint32_t changed[] = { group_root(3), group_root(5) + 2, group_root(TEST_GROUPS - 1) };
+    DAGSnapshot *partial = dag_snapshot_begin(versioned);
+    CHECK(partial != NULL);
+    if (!partial) return;
+    CHECK(dag_snapshot_set_state(versioned, partial, changed[0], STATE_FALSE));
+    CHECK(dag_snapshot_set_state(versioned, partial, changed[1], STATE_FALSE));
+    CHECK(dag_snapshot_set_binding(versioned, partial, changed[1], &binding));
+    CHECK(dag_snapshot_set_state(versioned, partial, changed[2], STATE_FALSE));
+    CHECK(dag_snapshot_resolve_from(versioned, partial, changed, 3));
+
+    // Matches a full re-resolve of the same changes
+    for (uint32_t g = 0; g < TEST_GROUPS; g++) {
+        bool flipped = g == 3 || g == TEST_GROUPS - 1;
+        for (uint32_t m = 0; m < TEST_GROUP_SIZE; m++) {
+            TruthValue expected = flipped || (g == 5 && m == 2) ? STATE_FALSE : STATE_TRUE;
+            CHECK(dag_snapshot_state(partial, group_root(g) + m) == expected);
+        }
+    }
+    dag_snapshot_publish(versioned, partial);
+
+    // Unbinding a member hands it back to its root
+    DAGSnapshot *draft = dag_snapshot_begin(versioned);
+    CHECK(draft != NULL);
+    if (!draft) return;
+    CHECK(dag_snapshot_set_binding(versioned, draft, changed[1], NULL));
+    CHECK(dag_snapshot_resolve_from(versioned, draft, &changed[1], 1));
+    CHECK(dag_snapshot_state(draft, changed[1]) == STATE_TRUE);
+    CHECK(draft->pages[1] == partial->pages[1]);
+    dag_snapshot_publish(versioned, draft);
+
+    CHECK(dag_snapshot_resolve_from(versioned, draft, (const uint32_t[]){ TEST_NODES }, 1) == false);
+    dag_versioned_destroy(versioned);
+}
+
+static size_t test_retired;
+
+static void test_retire_free(void *ptr) {
+    free(ptr);
+    test_retired++;
+}
+
+static void test_retire(const DAGCsr *csr) {
+    DAGVersioned *versioned = dag_versioned_create(csr, 2);
+    CHECK(versioned != NULL);
+    if (!versioned) return;
+
+    int reader = dag_versioned_register_reader(versioned);
+    CHECK(reader >= 0);
+
+    // Data an older version points into outlives readers pinning it
+    test_retired = 0;
+    dag_snapshot_pin(versioned, reader);
+    CHECK(dag_versioned_retire(versioned, malloc(16), test_retire_free));
+    CHECK(test_retired == 0);
+    dag_snapshot_unpin(versioned, reader);
+
+    CHECK(dag_versioned_retire(versioned, malloc(16), test_retire_free));
+    CHECK(test_retired == 2);
+
+    // Anything still pending goes with the versions
+    dag_snapshot_pin(versioned, reader);
+    CHECK(dag_versioned_retire(versioned, malloc(16), test_retire_free));
+    dag_snapshot_unpin(versioned, reader);
+    dag_versioned_unregister_reader(versioned, reader);
+    dag_versioned_destroy(versioned);
+    CHECK(test_retired == 3);
+}
+
+/* ---------------------------------------------------------------------------
+ * Concurrent readers
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    DAGVersioned *versioned;
+    atomic_bool  *stop;
+    size_t        torn;        // Groups whose members disagreed with their root
+    size_t        regressed;   // Versions seen going backwards
+} TestReader;
+
+static void* test_reader(void *arg) {
+    TestReader *reader = (TestReader *)arg;
+    int slot = dag_versioned_register_reader(reader->versioned);
+    if (slot < 0) return NULL;
+
+    uint64_t last_version = 0;
+    while (!atomic_load(reader->stop)) {
+        const DAGSnapshot *snapshot = dag_snapshot_pin(reader->versioned, slot);
+        if (snapshot->version < last_version) reader->regressed++;
+        last_version = snapshot->version;
+
+        // Every version is resolved before it is published
+        for (uint32_t g = 0; g < TEST_GROUPS; g++) {
+            TruthValue root = dag_snapshot_state(snapshot, group_root(g));
+            for (uint32_t m = 1; m < TEST_GROUP_SIZE; m++) {
+                if (dag_snapshot_state(snapshot, group_root(g) + m) != root) {
+                    reader->torn++;
+                    break;
+                }
+            }
+        }
+        dag_snapshot_unpin(reader->versioned, slot);
+    }
+
+    dag_versioned_unregister_reader(reader->versioned, slot);
+    return NULL;
+}
+
+static void test_concurrent_readers(const DAGCsr *csr) {
+    DAGVersioned *versioned = dag_versioned_create(csr, TEST_READERS);
+    CHECK(versioned != NULL);
+    if (!versioned) return;
+
+    atomic_bool stop = false;
+    TestReader readers[TEST_READERS];
+    pthread_t threads[TEST_READERS];
+    size_t started = 0;
+    for (; started < TEST_READERS; started++) {
+        readers[started] = (TestReader){ versioned, &stop, 0, 0 };
+        if (pthread_create(&threads[started], NULL, test_reader, &readers[started]) != 0) break;
+    }
+    CHECK(started > 0);
+
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < TEST_PUBLISHES; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        DAGSnapshot *draft = dag_snapshot_begin(versioned);
+        CHECK(draft != NULL);
+        if (!draft) break;
+        CHECK(test_flip_group(versioned, draft, (uint32_t)(seed % TEST_GROUPS),
+                              seed & 1 ? STATE_FALSE : STATE_TRUE));
+        dag_snapshot_publish(versioned, draft);
+    }
+
+    atomic_store(&stop, true);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        CHECK(readers[i].torn == 0);
+        CHECK(readers[i].regressed == 0);
+    }
+
+    dag_versioned_destroy(versioned);
+}
+
+int main(void) {
+    dag_init();
+
+    DAGCsr *csr = test_groups_csr();
+    CHECK(csr != NULL);
+    if (!csr) return TEST_RESULT();
+
+    test_isolation(csr);
+    test_resolve_from(csr);
+    test_retire(csr);
+    test_concurrent_readers(csr);
+
+    dag_csr_destroy(csr);
+    return TEST_RESULT();
+}
@@ -0,0 +1,173 @@
+// tests/test_trie.c
+// Trie updates under lock-free readers: a replaced node stays usable
+// until every reader that could see it has left, concurrent matching
+// never touches freed nodes, and the precompiler survives replacements.
+#include <axl/core/trie.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "test_util.h"
+
+#define TEST_READERS   3
+#define TEST_REPLACES  2000
+
+/// Patterns that all match "k123", swapped in turn under the readers.
+static const char *test_patterns[] = { "k[0-9]+", "k[0-9]*", "k[1-3]+", "k(1|2|3)+" };
+
+#define TEST_PATTERN_COUNT (sizeof(test_patterns) / sizeof(test_patterns[0]))
+
+/// Reclaim until nothing more is freed; the total freed.
+static size_t test_reclaim_all(void) {
+    size_t total = 0, freed;
+    while ((freed = trie_reclaim()) > 0) total += freed;
+    return total;
+}
+
+static void test_grace_period(void) {
+    TrieNode *root = trie_node_create("", TAXONOMY_NONE, 0.0f);
+    CHECK(root != NULL);
+    if (!root) return;
+
+    trie_insert(root, "a+", NOUN_SUBJECT, 1.0f);
+    test_reclaim_all();
+
+    int reader = trie_reader_register();
+    CHECK(reader >= 0);
+
+    trie_reader_enter(reader);
+    TrieNode *seen = trie_child(root, 'a');
+    CHECK(seen != NULL && strcmp(seen->pattern_str, "a+") == 0);
+
+    // Replaced while the reader holds it: nothing may be freed yet
+    trie_insert(root, "a*b", NOUN_OBJECT, 2.0f);
+    CHECK(trie_child(root, 'a') != seen);
+    CHECK(test_reclaim_all() == 0);
+    CHECK(strcmp(seen->pattern_str, "a+") == 0);
+    CHECK(trie_match_node(seen, "aaa", 3));
+    trie_reader_exit(reader);
+
+    // Once the reader has left, the old node goes
+    CHECK(test_reclaim_all() == 1);
+
+    trie_reader_enter(reader);
+    TrieNode *current = trie_child(root, 'a');
+    CHECK(current != NULL && trie_match_node(current, "aab", 3));
+    CHECK(!trie_match_node(current, "aaa", 3));
+    trie_reader_exit(reader);
+
+    trie_reader_unregister(reader);
+    trie_destroy(root);
+}
+
+/* ---------------------------------------------------------------------------
+ * Concurrent readers and precompilation
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    TrieNode    *root;
+    atomic_bool *stop;
+    size_t       lookups;
+    size_t       failures;     // Lookups that did not match "k123"
+} TestReader;
+
+static void* test_reader(void *arg) {
+    TestReader *reader = (TestReader *)arg;
+    int slot = trie_reader_register();
+    if (slot < 0) {
+        reader->failures++;
+        return NULL;
+    }
+
+    while (!atomic_load(reader->stop)) {
+        trie_reader_enter(slot);
+        TrieNode *node = trie_child(reader->root, 'k');
+        if (!node || node->pattern_str[0] != 'k' || !trie_match_node(node, "k123", 4)) {
+            reader->failures++;
+        }
+        trie_reader_exit(slot);
+        reader->lookups++;
+    }
+
+    trie_reader_unregister(slot);
+    return NULL;
+}
+
+static void test_concurrent_readers(void) {
+    TrieNode *root = trie_node_create("", TAXONOMY_NONE, 0.0f);
+    CHECK(root != NULL);
+    if (!root) return;
+    trie_insert(root, test_patterns[0], NOUN_SUBJECT, 1.0f);
+
+    atomic_bool stop = false;
+    TestReader readers[TEST_READERS];
+    pthread_t threads[TEST_READERS];
+    size_t started = 0;
+    for (; started < TEST_READERS; started++) {
+        readers[started] = (TestReader){ root, &stop, 0, 0 };
+        if (pthread_create(&threads[started], NULL, test_reader, &readers[started]) != 0) break;
+    }
+    CHECK(started > 0);
+
+    // Weights differ each time, so every insert really replaces the node
+    for (size_t i = 1; i <= TEST_REPLACES; i++) {
+        trie_insert(root, test_patterns[i % TEST_PATTERN_COUNT], NOUN_SUBJECT, (float)i);
+    }
+
+    atomic_store(&stop, true);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        CHECK(readers[i].failures == 0);
+    }
+
+    test_reclaim_all();
+    trie_destroy(root);
+}
+
+static void test_precompile_during_inserts(void) {
+    TrieNode *root = trie_node_create("", TAXONOMY_NONE, 0.0f);
+    CHECK(root != NULL);
+    if (!root) return;
+
+    char pattern[16];
+    for (char c = 'a'; c <= 'z'; c++) {
+        snprintf(pattern, sizeof(pattern), "%c[0-9]*", c);
+        trie_insert(root, pattern, NOUN_SUBJECT, 1.0f);
+    }
+
+    // Replace nodes while the helper compiles them
+    TriePrecompiler *precompiler = trie_precompile_start(root, 64);
+    CHECK(precompiler != NULL);
+    for (int round = 0; round < 20; round++) {
+        for (char c = 'a'; c <= 'z'; c++) {
+            snprintf(pattern, sizeof(pattern), "%c[0-9]*%c?", c, c);
+            trie_insert(root, pattern, NOUN_SUBJECT, (float)(round + 2));
+        }
+    }
+    // At most one compile per node collected: the root and 26 children
+    size_t compiled = trie_precompile_join(precompiler);
+    CHECK(compiled <= 27);
+
+    // No node is left half-compiled, and every current one still matches
+    for (char c = 'a'; c <= 'z'; c++) {
+        TrieNode *node = trie_child(root, (unsigned char)c);
+        CHECK(node != NULL);
+        if (!node) continue;
+        CHECK(atomic_load(&node->regex_state) != TRIE_REGEX_COMPILING);
+
+        char text[3] = { c, '7', '\0' };
+        CHECK(trie_match_node(node, text, 2));
+    }
+
+    test_reclaim_all();
+    trie_destroy(root);
+}
+
+int main(void) {
+    CHECK(trie_init() == 0);
+
+    test_grace_period();
+    test_concurrent_readers();
+    test_precompile_during_inserts();
+    return TEST_RESULT();
+}
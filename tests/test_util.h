@@ -0,0 +1,23 @@
+// tests/test_util.h
+// Minimal checks shared by the tests. A failed CHECK reports where it
+// failed and lets the test keep going; main() returns TEST_RESULT().
+#ifndef AXL_TEST_UTIL_H
+#define AXL_TEST_UTIL_H
+
+#include <stdio.h>
+
+static int test_failures;
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n",                     \
+                    __FILE__, __LINE__, #cond);                              \
+            test_failures++;                                                 \
+        }                                                                    \
+    } while (0)
+
+/// Exit status for main(): 0 if every CHECK passed.
+#define TEST_RESULT() (test_failures ? 1 : 0)
+
+#endif // AXL_TEST_UTIL_H
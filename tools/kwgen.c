@@ -0,0 +1,205 @@
+// tools/kwgen.c
+// Build-time generator for the taxonomy keyword table.
+//
+// Reads a keyword spec (see src/core/taxonomy/keywords.spec) and emits a
+// header containing a collision-free perfect hash table, so that
+// taxonomy_classify() resolves a keyword with one hash and one compare.
+//
+// Usage: axl_kwgen <keywords.spec> <output.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include "keyword_hash.h"
+
+#define KWGEN_MAX_KEYWORDS  1024
+#define KWGEN_MAX_FIELD     64
+#define KWGEN_MAX_SEEDS     1000000u
+
+typedef struct {
+    char  keyword[KWGEN_MAX_FIELD];
+    char  token[KWGEN_MAX_FIELD];
+    char  category[KWGEN_MAX_FIELD];
+    char  weight[KWGEN_MAX_FIELD];
+    size_t len;
+} KeywordSpec;
+
+static bool is_c_identifier(const char *s) {
+    if (!isalpha((unsigned char)s[0]) && s[0] != '_') return false;
+    for (const char *p = s + 1; *p; p++) {
+        if (!isalnum((unsigned char)*p) && *p != '_') return false;
+    }
+    return true;
+}
+
+static bool is_float_literal(const char *s) {
+    char *end = NULL;
+    strtod(s, &end);
+    return end != s && *end == '\0';
+}
+
+static size_t parse_spec(FILE *in, const char *path, KeywordSpec *specs) {
+    char line[512];
+    size_t count = 0;
+    size_t line_no = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        line_no++;
+
+        char *hash = strchr(line, '#');
+        // Comments start a line or follow whitespace, so '#' alone is not a keyword
+        if (hash && (hash == line || isspace((unsigned char)hash[-1]))) {
+            *hash = '\0';
+        }
+
+        KeywordSpec spec = {0};
+        int fields = sscanf(line, "%63s %63s %63s %63s",
+                            spec.keyword, spec.token, spec.category, spec.weight);
+        if (fields <= 0) continue;
+        if (fields != 4) {
+            fprintf(stderr, "%s:%zu: expected <keyword> <token> <category> <weight>\n",
+                    path, line_no);
+            exit(1);
+        }
+        if (!is_c_identifier(spec.token) || !is_c_identifier(spec.category)) {
+            fprintf(stderr, "%s:%zu: token and category must be C identifiers\n",
+                    path, line_no);
+            exit(1);
+        }
+        if (!is_float_literal(spec.weight)) {
+            fprintf(stderr, "%s:%zu: invalid weight '%s'\n", path, line_no, spec.weight);
+            exit(1);
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (strcmp(specs[i].keyword, spec.keyword) == 0) {
+                fprintf(stderr, "%s:%zu: duplicate keyword '%s'\n",
+                        path, line_no, spec.keyword);
+                exit(1);
+            }
+        }
+        if (count == KWGEN_MAX_KEYWORDS) {
+            fprintf(stderr, "%s:%zu: too many keywords\n", path, line_no);
+            exit(1);
+        }
+
+        spec.len = strlen(spec.keyword);
+        specs[count++] = spec;
+    }
+
+    return count;
+}
+
+/// Search for a seed that maps every keyword to a distinct slot.
+/// Returns false if no seed works for this table size.
+static bool find_seed(const KeywordSpec *specs, size_t count,
+                      size_t table_size, uint32_t *seed_out) {
+    unsigned char *used = (unsigned char *)malloc(table_size);
+    if (!used) return false;
+
+    for (uint32_t seed = 0; seed < KWGEN_MAX_SEEDS; seed++) {
+        memset(used, 0, table_size);
+        bool ok = true;
+        for (size_t i = 0; i < count && ok; i++) {
+            uint32_t slot = taxonomy_keyword_hash(seed, specs[i].keyword, specs[i].len)
+                            & (uint32_t)(table_size - 1);
+            ok = !used[slot];
+            used[slot] = 1;
+        }
+        if (ok) {
+            free(used);
+            *seed_out = seed;
+            return true;
+        }
+    }
+
+    free(used);
+    return false;
+}
+
+static void emit_c_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (const char *p = s; *p; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', out);
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <keywords.spec> <output.h>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "r");
+    if (!in) {
+        fprintf(stderr, "Failed to open keyword spec: %s\n", argv[1]);
+        return 1;
+    }
+
+    static KeywordSpec specs[KWGEN_MAX_KEYWORDS];
+    size_t count = parse_spec(in, argv[1], specs);
+    fclose(in);
+
+    if (count == 0) {
+        fprintf(stderr, "%s: no keywords defined\n", argv[1]);
+        return 1;
+    }
+
+    size_t table_size = 1;
+    while (table_size < count) table_size <<= 1;
+
+    uint32_t seed = 0;
+    while (!find_seed(specs, count, table_size, &seed)) {
+        table_size <<= 1;
+    }
+
+    size_t max_len = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (specs[i].len > max_len) max_len = specs[i].len;
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out) {
+        fprintf(stderr, "Failed to write keyword table: %s\n", argv[2]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by axl_kwgen from %s. Do not edit.\n", argv[1]);
+    fprintf(out, "#define TAXONOMY_KEYWORD_SEED     %uu\n", seed);
+    fprintf(out, "#define TAXONOMY_KEYWORD_MASK     %zuu\n", table_size - 1);
+    fprintf(out, "#define TAXONOMY_KEYWORD_MAX_LEN  %zuu\n\n", max_len);
+    fprintf(out, "static const TaxonomyKeyword taxonomy_keywords[%zu] = {\n", table_size);
+
+    for (size_t slot = 0; slot < table_size; slot++) {
+        const KeywordSpec *spec = NULL;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t h = taxonomy_keyword_hash(seed, specs[i].keyword, specs[i].len);
+            if ((h & (uint32_t)(table_size - 1)) == slot) {
+                spec = &specs[i];
+                break;
+            }
+        }
+
+        if (!spec) {
+            fprintf(out, "    { NULL, 0, { TOKEN_UNKNOWN, TAXONOMY_NONE, 0.0f } },\n");
+            continue;
+        }
+
+        fprintf(out, "    { ");
+        emit_c_string(out, spec->keyword);
+        fprintf(out, ", %zu, { %s, %s, %#.9gf } },\n",
+                spec->len, spec->token, spec->category, strtod(spec->weight, NULL));
+    }
+
+    fprintf(out, "};\n");
+
+    if (fclose(out) != 0) {
+        fprintf(stderr, "Failed to write keyword table: %s\n", argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
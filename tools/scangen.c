@@ -0,0 +1,550 @@
+// tools/scangen.c
+// Build-time generator for the pattern scanner.
+//
+// Reads a pattern file (see src/core/trie/patterns.spec), compiles every
+// pattern to an NFA, merges them into one DFA by subset construction and
+// emits C code implementing it as a switch/goto state machine. The
+// result, trie_scan_generated(), finds the longest match of any pattern
+// without regex work at run time. Earlier patterns win ties.
+//
+// Supported syntax (POSIX ERE subset): literals, '\' escapes, '.',
+// bracket classes with ranges and negation, groups, '|', '*', '+', '?'.
+//
+// Usage: axl_scangen <patterns.spec> <output.c>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+
+#define SCANGEN_MAX_PATTERNS  256
+#define SCANGEN_MAX_FIELD     64
+#define SCANGEN_MAX_PATTERN   512
+#define SCANGEN_MAX_NFA       8192
+#define SCANGEN_MAX_DFA       4096
+#define SCANGEN_NO_STATE      (-1)
+
+typedef struct {
+    char category[SCANGEN_MAX_FIELD];
+    char weight[SCANGEN_MAX_FIELD];
+    char pattern[SCANGEN_MAX_PATTERN];
+} PatternSpec;
+
+/* ---------------------------------------------------------------------------
+ * Pattern file
+ * ------------------------------------------------------------------------- */
+
+static bool is_c_identifier(const char *s) {
+    if (!isalpha((unsigned char)s[0]) && s[0] != '_') return false;
+    for (const char *p = s + 1; *p; p++) {
+        if (!isalnum((unsigned char)*p) && *p != '_') return false;
+    }
+    return true;
+}
+
+static bool is_float_literal(const char *s) {
+    char *end = NULL;
+    strtod(s, &end);
+    return end != s && *end == '\0';
+}
+
+static size_t parse_spec(FILE *in, const char *path, PatternSpec *specs) {
+    char line[1024];
+    size_t count = 0;
+    size_t line_no = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        line_no++;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        // '#' only starts a comment at the beginning of a line
+        char *p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') continue;
+
+        PatternSpec spec = {0};
+        int consumed = 0;
+        if (sscanf(p, "%63s %63s %n", spec.category, spec.weight, &consumed) != 2 ||
+            p[consumed] == '\0') {
+            fprintf(stderr, "%s:%zu: expected <category> <weight> <pattern>\n", path, line_no);
+            exit(1);
+        }
+        if (!is_c_identifier(spec.category)) {
+            fprintf(stderr, "%s:%zu: category must be a C identifier\n", path, line_no);
+            exit(1);
+        }
+        if (!is_float_literal(spec.weight)) {
+            fprintf(stderr, "%s:%zu: invalid weight '%s'\n", path, line_no, spec.weight);
+            exit(1);
+        }
+
+        char *pattern = p + consumed;
+        size_t len = strlen(pattern);
+        while (len > 0 && isspace((unsigned char)pattern[len - 1])) pattern[--len] = '\0';
+        if (len >= SCANGEN_MAX_PATTERN) {
+            fprintf(stderr, "%s:%zu: pattern too long\n", path, line_no);
+            exit(1);
+        }
+        if (count == SCANGEN_MAX_PATTERNS) {
+            fprintf(stderr, "%s:%zu: too many patterns\n", path, line_no);
+            exit(1);
+        }
+
+        memcpy(spec.pattern, pattern, len + 1);
+        specs[count++] = spec;
+    }
+
+    return count;
+}
+
+/* ---------------------------------------------------------------------------
+ * Thompson NFA
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    uint8_t set[32];           // Byte set for a consuming state
+    bool    consumes;          // Otherwise an epsilon state
+    int     out[2];            // Successors (epsilon states may have two)
+    int     accept;            // Pattern index if accepting, else -1
+} NfaState;
+
+typedef struct {
+    int start;
+    int end;                   // Epsilon state with a free out[0]
+} Fragment;
+
+static NfaState nfa[SCANGEN_MAX_NFA];
+static int nfa_count;
+
+static const char *parse_path;
+static size_t parse_index;
+static const char *parse_text;
+static const char *parse_pos;
+
+static void parse_error(const char *message) {
+    fprintf(stderr, "%s: pattern %zu: %s at offset %ld in '%s'\n",
+            parse_path, parse_index + 1, message, (long)(parse_pos - parse_text), parse_text);
+    exit(1);
+}
+
+static int nfa_new(bool consumes) {
+    if (nfa_count == SCANGEN_MAX_NFA) parse_error("NFA state limit exceeded");
+    NfaState *s = &nfa[nfa_count];
+    memset(s, 0, sizeof(*s));
+    s->consumes = consumes;
+    s->out[0] = s->out[1] = SCANGEN_NO_STATE;
+    s->accept = -1;
+    return nfa_count++;
+}
+
+static void set_add(uint8_t *set, unsigned c) {
+    set[c >> 3] |= (uint8_t)(1u << (c & 7));
+}
+
+static bool set_has(const uint8_t *set, unsigned c) {
+    return (set[c >> 3] >> (c & 7)) & 1u;
+}
+
+/// A fragment consuming one byte from `set`.
+static Fragment fragment_set(const uint8_t *set) {
+    int s = nfa_new(true);
+    int e = nfa_new(false);
+    memcpy(nfa[s].set, set, 32);
+    nfa[s].out[0] = e;
+    return (Fragment){ s, e };
+}
+
+/// POSIX: a backslash makes the next character literal, so \n matches 'n'
+/// exactly as regcomp() reads it in the interpreted scanner.
+static unsigned parse_escape(void) {
+    unsigned char c = (unsigned char)*parse_pos++;
+    if (c == '\0') {
+        parse_pos--;
+        parse_error("dangling backslash");
+    }
+    return c;
+}
+
+static Fragment parse_class(void) {
+    // POSIX: backslash is literal inside brackets; ']' first is literal
+    uint8_t set[32] = {0};
+    bool negate = false;
+    if (*parse_pos == '^') {
+        negate = true;
+        parse_pos++;
+    }
+
+    bool first = true;
+    while (*parse_pos && (first || *parse_pos != ']')) {
+        unsigned lo = (unsigned char)*parse_pos++;
+        unsigned hi = lo;
+        if (*parse_pos == '-' && parse_pos[1] && parse_pos[1] != ']') {
+            hi = (unsigned char)parse_pos[1];
+            parse_pos += 2;
+            if (hi < lo) parse_error("invalid range");
+        }
+        for (unsigned c = lo; c <= hi; c++) set_add(set, c);
+        first = false;
+    }
+    if (*parse_pos != ']') parse_error("unterminated bracket expression");
+    parse_pos++;
+
+    if (negate) {
+        for (int i = 0; i < 32; i++) set[i] = (uint8_t)~set[i];
+    }
+    return fragment_set(set);
+}
+
+static Fragment parse_alternation(void);
+
+static Fragment parse_atom(void) {
+    uint8_t set[32] = {0};
+    char c = *parse_pos++;
+
+    switch (c) {
+        case '(': {
+            Fragment inner = parse_alternation();
+            if (*parse_pos != ')') parse_error("missing ')'");
+            parse_pos++;
+            return inner;
+        }
+        case '[':
+            return parse_class();
+        case '.':
+            // As regcomp() without REG_NEWLINE: newline too, but never NUL
+            for (unsigned b = 1; b < 256; b++) set_add(set, b);
+            return fragment_set(set);
+        case '\\':
+            set_add(set, parse_escape());
+            return fragment_set(set);
+        case '^': case '$': case '{':
+            parse_pos--;
+            parse_error("anchors and bounded repeats are not supported");
+            break;
+        case '*': case '+': case '?':
+            parse_pos--;
+            parse_error("repetition without operand");
+            break;
+        default:
+            break;
+    }
+
+    set_add(set, (unsigned char)c);
+    return fragment_set(set);
+}
+
+static Fragment parse_repeat(void) {
+    Fragment f = parse_atom();
+
+    while (*parse_pos == '*' || *parse_pos == '+' || *parse_pos == '?') {
+        char op = *parse_pos++;
+        int split = nfa_new(false);
+        int end = nfa_new(false);
+
+        nfa[split].out[0] = f.start;
+        nfa[f.end].out[0] = end;
+        if (op == '?' || op == '*') nfa[split].out[1] = end;
+        if (op == '*' || op == '+') nfa[f.end].out[1] = f.start;
+        f = (Fragment){ split, end };
+    }
+    return f;
+}
+
+static Fragment parse_concatenation(void) {
+    if (*parse_pos == '\0' || *parse_pos == '|' || *parse_pos == ')') {
+        parse_error("empty expression");
+    }
+
+    Fragment f = parse_repeat();
+    while (*parse_pos && *parse_pos != '|' && *parse_pos != ')') {
+        Fragment next = parse_repeat();
+        nfa[f.end].out[0] = next.start;
+        f.end = next.end;
+    }
+    return f;
+}
+
+static Fragment parse_alternation(void) {
+    Fragment f = parse_concatenation();
+    while (*parse_pos == '|') {
+        parse_pos++;
+        Fragment right = parse_concatenation();
+        int split = nfa_new(false);
+        int end = nfa_new(false);
+        nfa[split].out[0] = f.start;
+        nfa[split].out[1] = right.start;
+        nfa[f.end].out[0] = end;
+        nfa[right.end].out[0] = end;
+        f = (Fragment){ split, end };
+    }
+    return f;
+}
+
+/// Compile every pattern and join them under one epsilon start state.
+static int build_nfa(const PatternSpec *specs, size_t count) {
+    int start = nfa_new(false);
+    int tail = start;
+
+    for (size_t i = 0; i < count; i++) {
+        parse_index = i;
+        parse_text = parse_pos = specs[i].pattern;
+
+        Fragment f = parse_alternation();
+        if (*parse_pos != '\0') parse_error("unexpected ')'");
+        nfa[f.end].accept = (int)i;
+
+        // Chain of splits: start -> p0 | (split -> p1 | ...)
+        int split = nfa_new(false);
+        nfa[tail].out[tail == start ? 0 : 1] = split;
+        nfa[split].out[0] = f.start;
+        tail = split;
+    }
+    return start;
+}
+
+/* ---------------------------------------------------------------------------
+ * Subset construction
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    uint64_t *members;         // NFA state bitset
+    int       accept;          // Lowest accepting pattern index, or -1
+    int       next[256];       // Target DFA state, or SCANGEN_NO_STATE
+} DfaState;
+
+static DfaState dfa[SCANGEN_MAX_DFA];
+static int dfa_count;
+static size_t set_words;
+
+static void closure(uint64_t *members, int state) {
+    if (state == SCANGEN_NO_STATE) return;
+    if (members[state / 64] & (1ull << (state % 64))) return;
+    members[state / 64] |= 1ull << (state % 64);
+
+    if (!nfa[state].consumes) {
+        closure(members, nfa[state].out[0]);
+        closure(members, nfa[state].out[1]);
+    }
+}
+
+static bool set_empty(const uint64_t *members) {
+    for (size_t i = 0; i < set_words; i++) {
+        if (members[i]) return false;
+    }
+    return true;
+}
+
+/// Find or add the DFA state for `members` (which it takes ownership of).
+static int dfa_intern(uint64_t *members) {
+    for (int i = 0; i < dfa_count; i++) {
+        if (memcmp(dfa[i].members, members, set_words * sizeof(uint64_t)) == 0) {
+            free(members);
+            return i;
+        }
+    }
+    if (dfa_count == SCANGEN_MAX_DFA) {
+        fprintf(stderr, "%s: DFA state limit exceeded\n", parse_path);
+        exit(1);
+    }
+
+    DfaState *d = &dfa[dfa_count];
+    d->members = members;
+    d->accept = -1;
+    for (int s = 0; s < nfa_count; s++) {
+        if ((members[s / 64] & (1ull << (s % 64))) && nfa[s].accept >= 0 &&
+            (d->accept < 0 || nfa[s].accept < d->accept)) {
+            d->accept = nfa[s].accept;
+        }
+    }
+    return dfa_count++;
+}
+
+static void build_dfa(int nfa_start) {
+    set_words = ((size_t)nfa_count + 63) / 64;
+
+    uint64_t *start = (uint64_t *)calloc(set_words, sizeof(uint64_t));
+    if (!start) exit(1);
+    closure(start, nfa_start);
+    dfa_intern(start);
+
+    for (int d = 0; d < dfa_count; d++) {
+        for (unsigned c = 0; c < 256; c++) {
+            uint64_t *next = (uint64_t *)calloc(set_words, sizeof(uint64_t));
+            if (!next) exit(1);
+
+            for (int s = 0; s < nfa_count; s++) {
+                if ((dfa[d].members[s / 64] & (1ull << (s % 64))) &&
+                    nfa[s].consumes && set_has(nfa[s].set, c)) {
+                    closure(next, nfa[s].out[0]);
+                }
+            }
+
+            if (set_empty(next)) {
+                free(next);
+                dfa[d].next[c] = SCANGEN_NO_STATE;
+            } else {
+                dfa[d].next[c] = dfa_intern(next);
+            }
+        }
+    }
+
+    if (dfa[0].accept >= 0) {
+        fprintf(stderr, "%s: pattern %d matches the empty string\n", parse_path, dfa[0].accept + 1);
+        exit(1);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Code generation
+ * ------------------------------------------------------------------------- */
+
+static void emit_c_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (const char *p = s; *p; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', out);
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+/// Is DFA state `d` the target of any transition (and so needs a label)?
+static bool state_referenced(int d) {
+    for (int s = 0; s < dfa_count; s++) {
+        for (unsigned c = 0; c < 256; c++) {
+            if (dfa[s].next[c] == d) return true;
+        }
+    }
+    return false;
+}
+
+static void emit_state(FILE *out, int d) {
+    // State 0 is entered by falling through; other states only by goto
+    if (state_referenced(d)) fprintf(out, "s%d:\n", d);
+    if (dfa[d].accept >= 0) {
+        fprintf(out, "    best = %d;\n    best_length = i;\n", dfa[d].accept);
+    }
+
+    bool any = false;
+    for (unsigned c = 0; c < 256 && !any; c++) any = dfa[d].next[c] != SCANGEN_NO_STATE;
+    if (!any) {
+        fprintf(out, "    goto done;\n");
+        return;
+    }
+
+    fprintf(out, "    if (i == len) goto done;\n");
+    fprintf(out, "    c = (unsigned char)text[i++];\n");
+
+    // Runs of 4+ bytes with one target become range checks, the rest cases
+    unsigned c = 0;
+    bool has_cases = false;
+    while (c < 256) {
+        unsigned run = c;
+        while (run + 1 < 256 && dfa[d].next[run + 1] == dfa[d].next[c]) run++;
+        if (dfa[d].next[c] != SCANGEN_NO_STATE) {
+            if (run - c >= 3) {
+                // c is an unsigned char: bounds at 0x00 and 0xff are always
+                // true and would trip -Wtype-limits, so they are left out
+                if (c == 0 && run == 255) {
+                    fprintf(out, "    goto s%d;\n", dfa[d].next[c]);
+                } else if (c == 0) {
+                    fprintf(out, "    if (c <= 0x%02x) goto s%d;\n", run, dfa[d].next[c]);
+                } else if (run == 255) {
+                    fprintf(out, "    if (c >= 0x%02x) goto s%d;\n", c, dfa[d].next[c]);
+                } else {
+                    fprintf(out, "    if (c >= 0x%02x && c <= 0x%02x) goto s%d;\n", c, run, dfa[d].next[c]);
+                }
+            } else {
+                has_cases = true;
+            }
+        }
+        c = run + 1;
+    }
+
+    if (has_cases) {
+        fprintf(out, "    switch (c) {\n");
+        c = 0;
+        while (c < 256) {
+            unsigned run = c;
+            while (run + 1 < 256 && dfa[d].next[run + 1] == dfa[d].next[c]) run++;
+            if (dfa[d].next[c] != SCANGEN_NO_STATE && run - c < 3) {
+                for (unsigned b = c; b <= run; b++) {
+                    fprintf(out, "    case 0x%02x: goto s%d;\n", b, dfa[d].next[b]);
+                }
+            }
+            c = run + 1;
+        }
+        fprintf(out, "    default: goto done;\n    }\n");
+    } else {
+        fprintf(out, "    goto done;\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <patterns.spec> <output.c>\n", argv[0]);
+        return 1;
+    }
+
+    parse_path = argv[1];
+    FILE *in = fopen(argv[1], "r");
+    if (!in) {
+        fprintf(stderr, "Failed to open pattern spec: %s\n", argv[1]);
+        return 1;
+    }
+
+    static PatternSpec specs[SCANGEN_MAX_PATTERNS];
+    size_t count = parse_spec(in, argv[1], specs);
+    fclose(in);
+
+    if (count == 0) {
+        fprintf(stderr, "%s: no patterns defined\n", argv[1]);
+        return 1;
+    }
+
+    build_dfa(build_nfa(specs, count));
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out) {
+        fprintf(stderr, "Failed to write scanner: %s\n", argv[2]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by axl_scangen from %s. Do not edit.\n", argv[1]);
+    fprintf(out, "// %zu patterns, %d DFA states.\n", count, dfa_count);
+    fprintf(out, "#include <axl/core/trie/scanner.h>\n\n");
+
+    fprintf(out, "const TrieScanPattern trie_scan_patterns[] = {\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(out, "    { ");
+        emit_c_string(out, specs[i].pattern);
+        fprintf(out, ", %s, %#.9gf },\n", specs[i].category, strtod(specs[i].weight, NULL));
+    }
+    fprintf(out, "};\n\n");
+    fprintf(out, "const size_t trie_scan_pattern_count = %zu;\n\n", count);
+
+    fprintf(out, "bool trie_scan_generated(const char *text, size_t len, TrieScanMatch *out) {\n");
+    fprintf(out, "    size_t i = 0;\n");
+    fprintf(out, "    size_t best_length = 0;\n");
+    fprintf(out, "    int best = -1;\n");
+    fprintf(out, "    unsigned char c;\n\n");
+    fprintf(out, "    if (!text || !out) return false;\n\n");
+    for (int d = 0; d < dfa_count; d++) {
+        emit_state(out, d);
+    }
+    fprintf(out, "done:\n");
+    fprintf(out, "    if (best < 0) return false;\n");
+    fprintf(out, "    out->length = best_length;\n");
+    fprintf(out, "    out->pattern = (uint32_t)best;\n");
+    fprintf(out, "    out->category = trie_scan_patterns[best].category;\n");
+    fprintf(out, "    out->weight = trie_scan_patterns[best].weight;\n");
+    fprintf(out, "    return true;\n");
+    fprintf(out, "}\n");
+
+    if (fclose(out) != 0) {
+        fprintf(stderr, "Failed to write scanner: %s\n", argv[2]);
+        return 1;
+    }
+
+    return 0;
+}